@@ -0,0 +1,74 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/bench/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython/Support.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython3.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "bench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "tests/CMakeFiles/metaprogram_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/metaprogram_test_portable.dir/DependInfo.cmake"
+  "tests/CMakeFiles/metaprogram_test_cxx17.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_compile_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_build_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_bulk_memory_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_small_vector_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_kernels_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_serialize_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_byte_order_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_arena_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_object_pool_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_soa_vector_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_hash_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_flat_hash_map_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_static_map_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/metaprogram_bench.dir/DependInfo.cmake"
+  )
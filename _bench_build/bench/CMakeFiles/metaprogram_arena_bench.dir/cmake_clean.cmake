@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_arena_bench.dir/runtime/arena_bench.cpp.o"
+  "CMakeFiles/metaprogram_arena_bench.dir/runtime/arena_bench.cpp.o.d"
+  "metaprogram_arena_bench"
+  "metaprogram_arena_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_arena_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_bench.dir/runtime/metaprogram_bench.cpp.o"
+  "CMakeFiles/metaprogram_bench.dir/runtime/metaprogram_bench.cpp.o.d"
+  "metaprogram_bench"
+  "metaprogram_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
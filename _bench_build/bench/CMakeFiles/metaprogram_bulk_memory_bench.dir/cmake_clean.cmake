@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_bulk_memory_bench.dir/runtime/bulk_memory_bench.cpp.o"
+  "CMakeFiles/metaprogram_bulk_memory_bench.dir/runtime/bulk_memory_bench.cpp.o.d"
+  "metaprogram_bulk_memory_bench"
+  "metaprogram_bulk_memory_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_bulk_memory_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
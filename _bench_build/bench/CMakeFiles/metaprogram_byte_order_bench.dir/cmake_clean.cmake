@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_byte_order_bench.dir/runtime/byte_order_bench.cpp.o"
+  "CMakeFiles/metaprogram_byte_order_bench.dir/runtime/byte_order_bench.cpp.o.d"
+  "metaprogram_byte_order_bench"
+  "metaprogram_byte_order_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_byte_order_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
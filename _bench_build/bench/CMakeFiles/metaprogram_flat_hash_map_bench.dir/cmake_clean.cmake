@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_flat_hash_map_bench.dir/runtime/flat_hash_map_bench.cpp.o"
+  "CMakeFiles/metaprogram_flat_hash_map_bench.dir/runtime/flat_hash_map_bench.cpp.o.d"
+  "metaprogram_flat_hash_map_bench"
+  "metaprogram_flat_hash_map_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_flat_hash_map_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_hash_bench.dir/runtime/hash_bench.cpp.o"
+  "CMakeFiles/metaprogram_hash_bench.dir/runtime/hash_bench.cpp.o.d"
+  "metaprogram_hash_bench"
+  "metaprogram_hash_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_hash_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
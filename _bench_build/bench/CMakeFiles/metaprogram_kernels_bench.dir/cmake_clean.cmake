@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_kernels_bench.dir/runtime/kernels_bench.cpp.o"
+  "CMakeFiles/metaprogram_kernels_bench.dir/runtime/kernels_bench.cpp.o.d"
+  "metaprogram_kernels_bench"
+  "metaprogram_kernels_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_kernels_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
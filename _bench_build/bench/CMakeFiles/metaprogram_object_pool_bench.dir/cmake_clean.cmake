@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_object_pool_bench.dir/runtime/object_pool_bench.cpp.o"
+  "CMakeFiles/metaprogram_object_pool_bench.dir/runtime/object_pool_bench.cpp.o.d"
+  "metaprogram_object_pool_bench"
+  "metaprogram_object_pool_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_object_pool_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_serialize_bench.dir/runtime/serialize_bench.cpp.o"
+  "CMakeFiles/metaprogram_serialize_bench.dir/runtime/serialize_bench.cpp.o.d"
+  "metaprogram_serialize_bench"
+  "metaprogram_serialize_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_serialize_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_small_vector_bench.dir/runtime/small_vector_bench.cpp.o"
+  "CMakeFiles/metaprogram_small_vector_bench.dir/runtime/small_vector_bench.cpp.o.d"
+  "metaprogram_small_vector_bench"
+  "metaprogram_small_vector_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_small_vector_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
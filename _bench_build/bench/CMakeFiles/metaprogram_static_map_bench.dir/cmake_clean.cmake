@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_static_map_bench.dir/runtime/static_map_bench.cpp.o"
+  "CMakeFiles/metaprogram_static_map_bench.dir/runtime/static_map_bench.cpp.o.d"
+  "metaprogram_static_map_bench"
+  "metaprogram_static_map_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_static_map_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
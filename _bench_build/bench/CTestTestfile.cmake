@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/bench
+# Build directory: /root/repo/_bench_build/bench
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(metaprogram_compile_budget "/root/.pyenv/shims/python3" "/root/repo/bench/compile/compile_bench.py" "--cxx" "/usr/bin/c++" "--std" "c++14" "--check" "--repeat" "1" "--metric" "rss_ratio" "--metric" "instantiations" "--filter" "^[^/]*\$|/(100|1000)\$")
+set_tests_properties(metaprogram_compile_budget PROPERTIES  LABELS "benchmark;compile" SKIP_RETURN_CODE "77" TIMEOUT "600" _BACKTRACE_TRIPLES "/root/repo/bench/CMakeLists.txt;39;add_test;/root/repo/bench/CMakeLists.txt;0;")
+add_test(metaprogram_runtime_check "/root/repo/_bench_build/bench/metaprogram_bench" "--quick" "--check")
+set_tests_properties(metaprogram_runtime_check PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/bench/CMakeLists.txt;91;add_test;/root/repo/bench/CMakeLists.txt;0;")
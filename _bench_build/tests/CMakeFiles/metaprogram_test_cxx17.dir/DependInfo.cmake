@@ -0,0 +1,38 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/test_algorithm.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_algorithm.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_algorithm.cpp.o.d"
+  "/root/repo/tests/test_arena.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_arena.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_arena.cpp.o.d"
+  "/root/repo/tests/test_byte_order.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_byte_order.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_byte_order.cpp.o.d"
+  "/root/repo/tests/test_cvrp.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_cvrp.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_cvrp.cpp.o.d"
+  "/root/repo/tests/test_flat_hash_map.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_flat_hash_map.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_flat_hash_map.cpp.o.d"
+  "/root/repo/tests/test_function_traits.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_function_traits.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_function_traits.cpp.o.d"
+  "/root/repo/tests/test_hash.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_hash.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_hash.cpp.o.d"
+  "/root/repo/tests/test_helper.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_helper.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_helper.cpp.o.d"
+  "/root/repo/tests/test_integer_sequence.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_integer_sequence.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_integer_sequence.cpp.o.d"
+  "/root/repo/tests/test_kernels.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_kernels.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_kernels.cpp.o.d"
+  "/root/repo/tests/test_object_pool.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_object_pool.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_object_pool.cpp.o.d"
+  "/root/repo/tests/test_reflect.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_reflect.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_reflect.cpp.o.d"
+  "/root/repo/tests/test_serialize.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_serialize.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_serialize.cpp.o.d"
+  "/root/repo/tests/test_small_vector.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_small_vector.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_small_vector.cpp.o.d"
+  "/root/repo/tests/test_soa_vector.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_soa_vector.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_soa_vector.cpp.o.d"
+  "/root/repo/tests/test_static_map.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_static_map.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_static_map.cpp.o.d"
+  "/root/repo/tests/test_type.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_type.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_type.cpp.o.d"
+  "/root/repo/tests/test_type_id.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_type_id.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_type_id.cpp.o.d"
+  "/root/repo/tests/test_type_list.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_type_list.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/test_type_list.cpp.o.d"
+  "/root/repo/tests/tests.cpp" "tests/CMakeFiles/metaprogram_test_cxx17.dir/tests.cpp.o" "gcc" "tests/CMakeFiles/metaprogram_test_cxx17.dir/tests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
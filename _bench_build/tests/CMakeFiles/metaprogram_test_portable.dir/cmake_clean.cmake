@@ -0,0 +1,49 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/metaprogram_test_portable.dir/test_algorithm.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_algorithm.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_arena.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_arena.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_byte_order.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_byte_order.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_cvrp.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_cvrp.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_flat_hash_map.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_flat_hash_map.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_function_traits.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_function_traits.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_hash.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_hash.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_helper.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_helper.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_integer_sequence.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_integer_sequence.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_kernels.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_kernels.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_object_pool.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_object_pool.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_reflect.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_reflect.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_serialize.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_serialize.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_small_vector.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_small_vector.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_soa_vector.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_soa_vector.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_static_map.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_static_map.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_type.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_type.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_type_id.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_type_id.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/test_type_list.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/test_type_list.cpp.o.d"
+  "CMakeFiles/metaprogram_test_portable.dir/tests.cpp.o"
+  "CMakeFiles/metaprogram_test_portable.dir/tests.cpp.o.d"
+  "metaprogram_test_portable"
+  "metaprogram_test_portable.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metaprogram_test_portable.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_bench_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(metaprogram_test "/root/repo/_bench_build/tests/metaprogram_test")
+set_tests_properties(metaprogram_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;27;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(metaprogram_test_portable "/root/repo/_bench_build/tests/metaprogram_test_portable")
+set_tests_properties(metaprogram_test_portable PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;28;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(metaprogram_test_cxx17 "/root/repo/_bench_build/tests/metaprogram_test_cxx17")
+set_tests_properties(metaprogram_test_cxx17 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;0;")
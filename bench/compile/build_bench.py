@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#
+#  build_bench.py
+#  metaprogram
+#
+#  Build-time benchmark of the ways a consumer can get the library.
+#
+#  N synthetic consumer translation units, each using a few parts of the
+#  library, are compiled one after the other:
+#      1. headers: #include "metaprogram.h", every TU parses the library
+#      2. pch:     the umbrella header is precompiled once and every TU
+#                  starts from it (-include with a .gch, -include-pch)
+#      3. module:  metaprogram.cppm is built once and every TU does
+#                  import metaprogram; (-fmodules-ts, --precompile)
+#  and we record the time to build the pch/module, the total for the N TUs,
+#  and the saving against the headers build. A mode the compiler can't do
+#  (modules before c++20, or an unsupported compiler) is reported as skipped.
+#
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC_DIR = os.path.normpath(os.path.join(HERE, "..", "..", "src"))
+
+MODES = ["headers", "pch", "module"]
+
+# what a consumer does with the library, %(i)d makes every TU distinct
+CONSUMER_BODY = """
+using namespace metaprogram;
+
+namespace consumer_%(i)d {
+    struct record { int id; float price; long quantity; };
+
+    using fields = type_list<int, float, long, record>;
+    static_assert(index_of<fields, record>::value == 3, "");
+    static_assert(is_scalar_v<int*> && !is_scalar_v<record>, "");
+
+    int run(int seed) {
+        small_vector<record, 8> records;
+        for (int k = 0; k < seed %% 16; ++k) {
+            records.push_back(record{k, 1.5f * k, %(i)d});
+        }
+        arena a;
+        int* counts = a.make_array<int>(16);
+        counts[seed %% 16] = static_cast<int>(records.size());
+        return counts[seed %% 16] + static_cast<int>(byteswap(static_cast<uint32_t>(seed)) & 1);
+    }
+}
+"""
+
+
+def compiler_family(cxx):
+    out = subprocess.run([cxx, "--version"], stdout=subprocess.PIPE,
+                         stderr=subprocess.STDOUT, universal_newlines=True).stdout
+    return "Clang" if "clang" in out.lower() else "GNU"
+
+
+def std_year(std):
+    # c++20, gnu++17, c++2a
+    version = std.split("++")[-1]
+    return {"2a": 20, "2b": 23, "2c": 26}.get(version, int(version) if version.isdigit() else 14)
+
+
+def run(cmd, cwd):
+    start = time.perf_counter()
+    proc = subprocess.run(cmd, cwd=cwd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                          universal_newlines=True)
+    return time.perf_counter() - start, proc
+
+
+def write_consumers(workdir, n, prologue):
+    paths = []
+    for i in range(n):
+        path = os.path.join(workdir, "consumer_%d.cpp" % i)
+        with open(path, "w") as f:
+            f.write(prologue)
+            f.write(CONSUMER_BODY % {"i": i})
+        paths.append(path)
+    return paths
+
+
+def setup(args, family, mode, workdir):
+    """Builds the pch or module, returns (seconds, extra consumer flags, prologue)
+    or raises RuntimeError when the mode is not supported."""
+    # the consumer flags too, gcc ignores a .gch built with other macros
+    base = ["-std=" + args.std, "-I", SRC_DIR] + ["-D" + d for d in args.define] + args.flag
+    if mode == "headers":
+        return 0.0, [], '#include "metaprogram.h"\n'
+
+    if mode == "pch":
+        if family == "Clang":
+            pch = os.path.join(workdir, "metaprogram.pch")
+            cmd = [args.cxx] + base + ["-x", "c++-header", os.path.join(SRC_DIR, "metaprogram.h"),
+                                       "-o", pch]
+            flags = ["-include-pch", pch]
+        else:
+            # gcc takes dir/metaprogram.h.gch for -include dir/metaprogram.h
+            pch_dir = os.path.join(workdir, "pch")
+            os.makedirs(pch_dir)
+            cmd = [args.cxx] + base + ["-x", "c++-header", os.path.join(SRC_DIR, "metaprogram.h"),
+                                       "-o", os.path.join(pch_dir, "metaprogram.h.gch")]
+            flags = ["-include", os.path.join(pch_dir, "metaprogram.h")]
+        seconds, proc = run(cmd, workdir)
+        if proc.returncode != 0:
+            raise RuntimeError(proc.stderr.strip().splitlines()[-1] if proc.stderr else "pch failed")
+        return seconds, flags, ""
+
+    if std_year(args.std) < 20:
+        raise RuntimeError("modules need -std=c++20")
+    # gcc keeps the placement new of the global module fragment out of
+    # the importers, so the consumers include <new> themselves
+    prologue = "#include <new>\nimport metaprogram;\n"
+    if family == "Clang":
+        pcm = os.path.join(workdir, "metaprogram.pcm")
+        cmd = [args.cxx] + base + ["--precompile", "-x", "c++-module",
+                                   os.path.join(SRC_DIR, "metaprogram.cppm"), "-o", pcm]
+        flags = ["-fmodule-file=metaprogram=" + pcm]
+    else:
+        cmd = [args.cxx] + base + ["-fmodules-ts", "-x", "c++", "-c",
+                                   os.path.join(SRC_DIR, "metaprogram.cppm"), "-o", "metaprogram.o"]
+        flags = ["-fmodules-ts"]
+    seconds, proc = run(cmd, workdir)
+    if proc.returncode != 0:
+        lines = [l for l in proc.stderr.splitlines() if "error" in l]
+        raise RuntimeError(lines[0].strip() if lines else "the module failed to build")
+    return seconds, flags, prologue
+
+
+def measure(args, family, mode):
+    with tempfile.TemporaryDirectory() as workdir:
+        setup_time, flags, prologue = setup(args, family, mode, workdir)
+        consumers = write_consumers(workdir, args.n, prologue)
+        total = 0.0
+        for path in consumers:
+            cmd = [args.cxx, "-std=" + args.std, "-I", SRC_DIR] + ["-D" + d for d in args.define]
+            cmd += args.flag + flags + ["-c", path, "-o", path[:-4] + ".o"]
+            seconds, proc = run(cmd, workdir)
+            if proc.returncode != 0:
+                sys.stderr.write(proc.stderr)
+                raise RuntimeError("%s: a consumer failed to build" % mode)
+            total += seconds
+    return {"setup": setup_time, "consumers": total, "total": setup_time + total}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--std", default="c++20")
+    parser.add_argument("--n", type=int, default=20, help="number of consumer TUs")
+    parser.add_argument("--mode", action="append", choices=MODES,
+                        help="mode to run, may be repeated (default: all)")
+    parser.add_argument("-D", "--define", action="append", default=[],
+                        help="extra macro for every TU, e.g. -D META_USE_BUILTINS=0")
+    parser.add_argument("--flag", action="append", default=[],
+                        help="extra compiler flag for the consumers, e.g. --flag=-O2")
+    parser.add_argument("--output", help="write the results as json")
+    args = parser.parse_args()
+
+    family = compiler_family(args.cxx)
+    results = {}
+    print("%-8s %9s %12s %9s %9s %8s" % ("mode", "setup(s)", "consumers(s)", "per TU(ms)", "total(s)", "saving"))
+    for mode in args.mode or MODES:
+        try:
+            r = measure(args, family, mode)
+        except RuntimeError as e:
+            print("%-8s skipped: %s" % (mode, e))
+            continue
+        results[mode] = r
+        saving = "-"
+        if mode != "headers" and "headers" in results:
+            saving = "%.0f%%" % (100.0 * (1.0 - r["total"] / results["headers"]["total"]))
+        print("%-8s %9.2f %12.2f %9.1f %9.2f %8s" % (
+            mode, r["setup"], r["consumers"], 1000.0 * r["consumers"] / args.n, r["total"], saving))
+        sys.stdout.flush()
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"compiler": family, "n": args.n, "std": args.std, "results": results},
+                      f, indent=2, sort_keys=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
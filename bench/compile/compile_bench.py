@@ -0,0 +1,465 @@
+#!/usr/bin/env python3
+#
+#  compile_bench.py
+#  metaprogram
+#
+#  Compile-time benchmark for the trait headers in src/.
+#
+#  For every benchmark item a synthetic translation unit is generated that
+#  instantiates the item over N distinct types, once against metaprogram and
+#  once against the standard library. Each TU is compiled with -fsyntax-only
+#  and we record:
+#      1. wall time (best of --repeat runs)
+#      2. peak RSS of the compiler process
+#      3. template instantiation counts of the metaprogram TU. Clang: the
+#         instantiations of -ftime-trace. GCC: the class specializations of
+#         -fdump-lang-class in a separate compile, less those of a TU with
+#         only its includes, as instantiation_report.py counts them
+#      4. template instantiation time (GCC, from -ftime-report)
+#
+#  With --check the metaprogram/std ratios and the instantiation counts are
+#  compared against the checked-in baseline of the compiler and the script
+#  exits with 1 when a budget is exceeded or an item has no baseline, and
+#  with SKIP_CODE when the compiler has no baseline at all. --metric
+#  restricts the check to some of the budgets, the ctest gate only checks the
+#  peak RSS and the instantiation counts, which don't depend on the load of
+#  the machine.
+#
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+from instantiation_report import parse_gcc_classes
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC_DIR = os.path.normpath(os.path.join(HERE, "..", "..", "src"))
+BASELINE_DIR = os.path.join(HERE, "baselines")
+
+# budget tolerance, relative to the baseline value
+TOLERANCE = {
+    "time_ratio": 0.50,
+    "rss_ratio": 0.10,
+    "instantiations": 0.05,
+}
+
+# exit code of --check when the compiler has no baseline, ctest's
+# SKIP_RETURN_CODE of metaprogram_compile_budget
+SKIP_CODE = 77
+
+# wall time below this (seconds) is mostly process startup and scheduler
+# noise, the time budget is only enforced above it
+TIME_NOISE_FLOOR = 0.5
+
+# compiler -> regexes of the items which are measured but have no budget, the
+# documented limits of the library on that compiler: slice_sequence and take
+# of 10k elements and more on gcc, see INTEGER_SEQUENCE_ITEMS. The smaller
+# sizes keep their budget
+UNBUDGETED = {
+    "GNU": [r"^integer_sequence/(slice|take)/(10000|50000)$"],
+}
+
+# Type generators, every index gives a distinct type. Classes and enums are
+# made distinct by a template parameter, the rest are built on top of them.
+TYPE_PRELUDE = """
+template <int I> struct C { int m; void f(); };
+template <int I> union U { int a; float b; };
+template <int I> struct E { enum class type {}; };
+"""
+
+TYPE_KINDS = [
+    lambda i: "C<%d>" % i,
+    lambda i: "const C<%d>" % i,
+    lambda i: "typename E<%d>::type" % i,
+    lambda i: "U<%d>" % i,
+    lambda i: "C<%d>*" % i,
+    lambda i: "const volatile C<%d>&" % i,
+    lambda i: "C<%d>&&" % i,
+    lambda i: "C<%d>[%d]" % (i, i % 7 + 1),
+    lambda i: "C<%d>(int, C<%d>)" % (i, i),
+    lambda i: "int C<%d>::*" % i,
+    lambda i: "void (C<%d>::*)() const" % i,
+    lambda i: ["int", "const unsigned long", "volatile char", "double",
+               "bool", "const float", "void", "decltype(nullptr)"][i % 8],
+]
+
+# trait -> (metaprogram expression, std expression, kind)
+# kind is "value" for predicates and "type" for transformations, the _v/_t
+# forms are compared against the std ::value/_t spelling available in c++14.
+TRAITS = {
+    "is_void":              ("is_void<T>::value", "is_void<T>::value", "value"),
+    "is_null_pointer":      ("is_null_pointer<T>::value", "is_same<decltype(nullptr), typename remove_cv<T>::type>::value", "value"),
+    "is_integral":          ("is_integral<T>::value", "is_integral<T>::value", "value"),
+    "is_floating_point":    ("is_floating_point<T>::value", "is_floating_point<T>::value", "value"),
+    "is_array":             ("is_array<T>::value", "is_array<T>::value", "value"),
+    "is_enum":              ("is_enum<T>::value", "is_enum<T>::value", "value"),
+    "is_union":             ("is_union<T>::value", "is_union<T>::value", "value"),
+    "is_class":             ("is_class<T>::value", "is_class<T>::value", "value"),
+    "is_function":          ("is_function<T>::value", "is_function<T>::value", "value"),
+    "is_pointer":           ("is_pointer<T>::value", "is_pointer<T>::value", "value"),
+    "is_reference":         ("is_reference<T>::value", "is_reference<T>::value", "value"),
+    "is_member_pointer":    ("is_member_pointer<T>::value", "is_member_pointer<T>::value", "value"),
+    "is_arithmetic":        ("is_arithmetic<T>::value", "is_arithmetic<T>::value", "value"),
+    "is_fundamental":       ("is_fundamental<T>::value", "is_fundamental<T>::value", "value"),
+    "is_scalar":            ("is_scalar<T>::value", "is_scalar<T>::value", "value"),
+    "is_object":            ("is_object<T>::value", "is_object<T>::value", "value"),
+    "is_compound":          ("is_compound<T>::value", "is_compound<T>::value", "value"),
+    "remove_cv":            ("remove_cv<T>::type", "remove_cv<T>::type", "type"),
+    "remove_reference":     ("remove_reference<T>::type", "remove_reference<T>::type", "type"),
+    "remove_cvref":         ("remove_cvref<T>::type", "remove_cv<typename remove_reference<T>::type>::type", "type"),
+    "remove_pointer":       ("remove_pointer<T>::type", "remove_pointer<T>::type", "type"),
+    "add_pointer":          ("add_pointer<T>::type", "add_pointer<T>::type", "type"),
+    "add_lvalue_reference": ("add_lvalue_reference<T>::type", "add_lvalue_reference<T>::type", "type"),
+    "is_integral_v":        ("is_integral_v<T>", "is_integral<T>::value", "value"),
+    "is_scalar_v":          ("is_scalar_v<T>", "is_scalar<T>::value", "value"),
+    "remove_cv_t":          ("remove_cv_t<T>", "remove_cv_t<T>", "alias"),
+    "remove_cvref_t":       ("remove_cvref_t<T>", "remove_cv_t<remove_reference_t<T>>", "alias"),
+    "add_pointer_t":        ("add_pointer_t<T>", "add_pointer_t<T>", "alias"),
+    # the std reference joins with && and ||, which instantiates every operand
+    "conjunction":          ("conjunction<is_class<T>, std::is_nothrow_move_constructible<T>, std::is_nothrow_copy_constructible<T>>::value",
+                             "is_class<T>::value && is_nothrow_move_constructible<T>::value && is_nothrow_copy_constructible<T>::value", "value"),
+    "disjunction":          ("disjunction<is_scalar<T>, std::is_nothrow_move_constructible<T>, std::is_nothrow_copy_constructible<T>>::value",
+                             "is_scalar<T>::value || is_nothrow_move_constructible<T>::value || is_nothrow_copy_constructible<T>::value", "value"),
+    "conditional_t":        ("conditional_t<is_class<T>::value, T, int>", "conditional_t<is_class<T>::value, T, int>", "alias"),
+}
+
+LIBS = {
+    "meta": ('#include "type_traits_type.h"\n', "metaprogram"),
+    "std": ("#include <type_traits>\n", "std"),
+}
+
+
+def gen_traits(lib, n, item):
+    include, ns = LIBS[lib]
+    meta_expr, std_expr, kind = TRAITS[item]
+    expr = meta_expr if lib == "meta" else std_expr
+    out = [include, TYPE_PRELUDE, "using namespace %s;\n" % ns]
+    # every probe is a distinct class template instantiation so the
+    # trait is instantiated once per type and nothing is folded away
+    if kind == "value":
+        out.append("template <class T> struct probe { static constexpr bool value = %s; };\n" % expr)
+    elif kind == "type":
+        out.append("template <class T> struct probe { using type = typename %s; };\n" % expr)
+    else:
+        out.append("template <class T> struct probe { using type = %s; };\n" % expr)
+    out.append("template <int I> struct probe_at;\n")
+    for i in range(n):
+        t = TYPE_KINDS[i % len(TYPE_KINDS)](i // len(TYPE_KINDS))
+        if kind == "value":
+            out.append("template <> struct probe_at<%d> { static constexpr bool value = probe<%s>::value; };\n" % (i, t))
+        else:
+            out.append("template <> struct probe_at<%d> { using type = probe<%s>::type; };\n" % (i, t))
+    return "".join(out)
+
+
+TYPE_LIST_OPS = ["at", "index_of", "contains", "concat", "filter", "partition", "transform", "unique"]
+TYPE_LIST_SIZES = [100, 1000, 10000]
+
+# number of at/index_of/contains queries per TU
+TYPE_LIST_QUERIES = 1000
+
+
+def gen_type_list(lib, n, item):
+    # item is "<op>/<size>". The reference is the bare list, so the ratio is
+    # the cost of the op on top of naming the types. std::tuple_element
+    # recurses linearly, it takes minutes at 1k and hits the depth limit at 10k
+    op = item.split("/")[0]
+    types = [TYPE_KINDS[i % len(TYPE_KINDS)](i // len(TYPE_KINDS)) for i in range(n)]
+    step = max(1, n // TYPE_LIST_QUERIES)
+    if lib == "meta":
+        out = ['#include "type_list.h"\n', TYPE_PRELUDE, "using namespace metaprogram;\n"]
+    else:
+        out = ["#include <cstddef>\n", TYPE_PRELUDE, "template <class... Ts> struct type_list {};\n"]
+    out.append("using L = type_list<%s>;\n" % ", ".join(types))
+    if lib == "std":
+        return "".join(out)
+
+    if op == "at":
+        for i in range(0, n, step):
+            out.append("using a%d = at<L, %d>::type;\n" % (i, i))
+    elif op in ("index_of", "contains"):
+        for i in range(0, n, step):
+            out.append("constexpr auto q%d = %s<L, %s>::value;\n" % (i, op, types[i]))
+    elif op == "concat":
+        out.append("using R = concat<%s>::type;\n" % ", ".join("type_list<%s>" % t for t in types))
+    elif op == "filter":
+        out.append("using R = filter<L, is_class>::type;\n")
+    elif op == "partition":
+        out.append("using R1 = partition<L, is_class>::first;\nusing R2 = partition<L, is_class>::second;\n")
+    elif op == "transform":
+        out.append("using R = transform<L, add_pointer>::type;\n")
+    elif op == "unique":
+        out.append("using R = unique<L>::type;\n")
+    return "".join(out)
+
+
+# every op is measured up to 50k elements. slice reads the elements by index
+# and take concatenates one list per element, without __type_pack_element
+# (gcc before 14) that is O(N^2) and O(N log N) work with a large constant,
+# their 10k and 50k rows are unbudgeted on gcc, see UNBUDGETED. With gcc 12
+# slice/50000 takes about 8 minutes and take/50000 a minute and 2GB
+INTEGER_SEQUENCE_ITEMS = [
+    "%s/%d" % (op, n) for op in ("make", "range", "reverse", "slice", "take", "drop")
+    for n in (100, 1000, 10000, 50000)]
+
+# number of sequences of distinct lengths per TU
+INTEGER_SEQUENCE_COUNT = 10
+
+
+def gen_integer_sequence(lib, n, item):
+    # item is "<op>/<size>". The reference makes the same sequences with
+    # std::make_index_sequence (and the same list for take/drop), so the
+    # ratio of make is the library against the standard one and the others
+    # add the cost of the op. With -D META_USE_BUILTINS=0 make is the
+    # doubling fallback
+    op = item.split("/")[0]
+    lengths = [n - i for i in range(INTEGER_SEQUENCE_COUNT)]
+    if lib == "meta":
+        out = ['#include "type_list.h"\n', "using namespace metaprogram;\n"]
+    else:
+        out = ["#include <utility>\n", "using namespace std;\n",
+               "template <class... Ts> struct type_list {};\n"]
+    if op in ("take", "drop"):
+        # one op per TU, the list is the expensive part
+        out.append("template <size_t I> struct tag {};\n"
+                   "template <class Is> struct tags;\n"
+                   "template <size_t... Is> struct tags<index_sequence<Is...>> { using type = type_list<tag<Is>...>; };\n"
+                   "using L = tags<make_index_sequence<%d>>::type;\n" % n)
+        if lib == "meta":
+            out.append("static_assert(%s_t<L, %d>::size == %d, \"\");\n" % (op, n // 2, n - n // 2))
+        return "".join(out)
+
+    for i, m in enumerate(lengths):
+        if lib == "std" or op == "make":
+            seq = "make_index_sequence<%d>" % m
+        elif op == "range":
+            seq = "make_index_range<%d, %d>" % (i, i + m)
+        elif op == "reverse":
+            seq = "make_reverse_index_sequence<%d>" % m
+        else:
+            seq = "slice_sequence_t<make_index_sequence<%d>, 0, %d>" % (n, m)
+        out.append("using s%d = %s;\nstatic_assert(s%d::size() == %d, \"\");\n" % (i, seq, i, m))
+    return "".join(out)
+
+
+# suite -> (generator, items, default N), a default N of 0 means the item
+# name ends with its own size
+SUITES = {
+    "traits": (gen_traits, list(TRAITS), 2000),
+    "type_list": (gen_type_list, ["%s/%d" % (op, n) for op in TYPE_LIST_OPS for n in TYPE_LIST_SIZES], 0),
+    "integer_sequence": (gen_integer_sequence, INTEGER_SEQUENCE_ITEMS, 0),
+}
+
+
+def compiler_family(cxx):
+    out = subprocess.run([cxx, "--version"], stdout=subprocess.PIPE,
+                         stderr=subprocess.STDOUT, universal_newlines=True).stdout
+    return "Clang" if "clang" in out.lower() else "GNU"
+
+
+def run_compile(cxx, family, source, workdir, std, defines):
+    path = os.path.join(workdir, "tu.cpp")
+    with open(path, "w") as f:
+        f.write(source)
+    cmd = [cxx, "-std=" + std, "-I", SRC_DIR, "-c", path, "-o", os.path.join(workdir, "tu.o")]
+    cmd += ["-D" + d for d in defines]
+    if family == "Clang":
+        cmd += ["-ftime-trace", "-ftime-trace-granularity=0"]
+    else:
+        cmd += ["-fsyntax-only", "-ftime-report"]
+
+    start = time.perf_counter()
+    with open(os.path.join(workdir, "stderr.txt"), "w+") as err:
+        proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=err)
+        # reap the driver with wait4, its rusage also covers the reaped
+        # children (cc1plus / clang -cc1) so ru_maxrss is the compiler peak
+        _, status, usage = os.wait4(proc.pid, 0)
+        wall = time.perf_counter() - start
+        err.seek(0)
+        stderr = err.read()
+    proc.returncode = os.waitstatus_to_exitcode(status)
+    if proc.returncode != 0:
+        sys.stderr.write(stderr)
+        raise RuntimeError("compilation failed: " + " ".join(cmd))
+
+    result = {"time": wall, "rss_kb": usage.ru_maxrss, "instantiations": None,
+              "instantiation_time": None}
+    if family == "Clang":
+        trace = os.path.join(workdir, "tu.json")
+        with open(trace) as f:
+            events = json.load(f)["traceEvents"]
+        result["instantiations"] = sum(
+            1 for e in events if e.get("name") in ("InstantiateClass", "InstantiateFunction"))
+    else:
+        # usr, sys, wall and GGC columns, we keep the wall time
+        m = re.search(r"^\s*template instantiation\s*:(.*)$", stderr, re.M)
+        if m:
+            columns = re.findall(r"(\d+\.\d+)\s*\(", m.group(1))
+            if len(columns) >= 3:
+                result["instantiation_time"] = float(columns[2])
+    return result
+
+
+# the class specializations of a TU, gcc -fdump-lang-class
+def gcc_class_count(cxx, source, workdir, std, defines):
+    path = os.path.join(workdir, "classes.cpp")
+    dump = os.path.join(workdir, "classes.txt")
+    with open(path, "w") as f:
+        f.write(source)
+    cmd = [cxx, "-std=" + std, "-I", SRC_DIR, "-fsyntax-only", "-fdump-lang-class=" + dump, path]
+    cmd += ["-D" + d for d in defines]
+    proc = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                          universal_newlines=True)
+    if proc.returncode != 0:
+        sys.stderr.write(proc.stderr)
+        raise RuntimeError("compilation failed: " + " ".join(cmd))
+    return sum(parse_gcc_classes(dump).values())
+
+
+# the includes of a TU alone -> their class count, the explicit
+# specializations of the library are in the dump but are not instantiations
+include_classes = {}
+
+
+def gcc_instantiations(args, source, workdir):
+    includes = "".join(line for line in source.splitlines(True) if line.startswith("#include"))
+    if includes not in include_classes:
+        include_classes[includes] = gcc_class_count(args.cxx, includes, workdir, args.std, args.define)
+    return gcc_class_count(args.cxx, source, workdir, args.std, args.define) - include_classes[includes]
+
+
+def measure(args, family, suite, item, lib, n):
+    gen = SUITES[suite][0]
+    source = gen(lib, n, item)
+    best = None
+    with tempfile.TemporaryDirectory() as workdir:
+        for _ in range(args.repeat):
+            r = run_compile(args.cxx, family, source, workdir, args.std, args.define)
+            if best is None or r["time"] < best["time"]:
+                best = r
+        # counted apart, the dump would add to the time and RSS measured above
+        if family == "GNU" and lib == "meta":
+            best["instantiations"] = gcc_instantiations(args, source, workdir)
+    return best
+
+
+def fmt(v, spec):
+    return "-" if v is None else format(v, spec)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--std", default="c++14")
+    parser.add_argument("--suite", action="append", choices=sorted(SUITES),
+                        help="suite to run, may be repeated (default: all)")
+    parser.add_argument("--filter", default="", help="regex on item names")
+    parser.add_argument("--n", type=int, default=0, help="override the number of types")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("-D", "--define", action="append", default=[],
+                        help="extra macro for every TU, e.g. -D META_USE_BUILTINS=0")
+    parser.add_argument("--output", help="write the results as json")
+    parser.add_argument("--check", action="store_true",
+                        help="fail if a budget in the baseline is exceeded")
+    parser.add_argument("--metric", action="append", choices=sorted(TOLERANCE),
+                        help="budget checked by --check, may be repeated (default: all)")
+    parser.add_argument("--update-baseline", action="store_true",
+                        help="overwrite the baseline of the compiler with this run")
+    args = parser.parse_args()
+
+    family = compiler_family(args.cxx)
+    baseline_path = os.path.join(BASELINE_DIR, family + ".json")
+    baseline = {}
+    if os.path.exists(baseline_path):
+        with open(baseline_path) as f:
+            baseline = json.load(f)
+    elif args.check:
+        print("no compile budget for %s, write one with --update-baseline" % family)
+        return SKIP_CODE
+
+    results = {}
+    failures = []
+    print("%-32s %9s %9s %7s %7s %8s %8s %8s %7s" % (
+        "benchmark", "meta(s)", "std(s)", "t-ratio", "m-ratio", "meta(MB)", "inst", "inst(s)", "budget"))
+    for suite in args.suite or sorted(SUITES):
+        _, items, default_n = SUITES[suite]
+        for item in items:
+            if args.filter and not re.search(args.filter, item):
+                continue
+            n = default_n or int(item.rsplit("/", 1)[1])
+            if args.n and default_n:
+                n = args.n
+            key = "%s/%s" % (suite, item)
+            meta = measure(args, family, suite, item, "meta", n)
+            std = measure(args, family, suite, item, "std", n)
+            entry = {
+                "n": n,
+                "meta": meta,
+                "std": std,
+                "time_ratio": round(meta["time"] / std["time"], 3),
+                "rss_ratio": round(meta["rss_kb"] / float(std["rss_kb"]), 3),
+                "instantiations": meta["instantiations"],
+            }
+            results[key] = entry
+
+            verdict = "new"
+            if any(re.search(p, key) for p in UNBUDGETED.get(family, [])):
+                verdict = "-"
+            elif key not in baseline or baseline[key].get("n") != n:
+                failures.append("%s: no baseline for n=%d, update it with --update-baseline" % (key, n))
+            else:
+                verdict = "ok"
+                for metric in args.metric or sorted(TOLERANCE):
+                    tol = TOLERANCE[metric]
+                    limit = baseline[key].get(metric)
+                    if limit is None or entry[metric] is None:
+                        continue
+                    if metric == "time_ratio" and meta["time"] < TIME_NOISE_FLOOR:
+                        continue
+                    if entry[metric] > limit * (1.0 + tol):
+                        verdict = "FAIL"
+                        failures.append("%s: %s %.3f exceeds baseline %.3f (+%d%%)" % (
+                            key, metric, entry[metric], limit, tol * 100))
+            print("%-32s %9.3f %9.3f %7.2f %7.2f %8.1f %8s %8s %7s" % (
+                key, meta["time"], std["time"], entry["time_ratio"], entry["rss_ratio"],
+                meta["rss_kb"] / 1024.0, fmt(meta["instantiations"], "d"),
+                fmt(meta["instantiation_time"], ".2f"), verdict))
+            sys.stdout.flush()
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"compiler": family, "results": results}, f, indent=2, sort_keys=True)
+
+    if args.update_baseline:
+        for key, entry in results.items():
+            if any(re.search(p, key) for p in UNBUDGETED.get(family, [])):
+                baseline.pop(key, None)
+                continue
+            baseline[key] = {
+                "n": entry["n"],
+                "time_ratio": entry["time_ratio"],
+                "rss_ratio": entry["rss_ratio"],
+                "instantiations": entry["instantiations"],
+            }
+        if not os.path.isdir(BASELINE_DIR):
+            os.makedirs(BASELINE_DIR)
+        with open(baseline_path, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("baseline written to " + baseline_path)
+
+    if args.check and failures:
+        print("\ncompile budget check failed:")
+        for line in failures:
+            print("    " + line)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
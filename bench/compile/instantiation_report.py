@@ -0,0 +1,462 @@
+#!/usr/bin/env python3
+#
+#  instantiation_report.py
+#  metaprogram
+#
+#  Attributes the template instantiations of a build to the metaprogram::
+#  traits and to the traits (or user code) which asked for them.
+#
+#  The translation units are the positional sources, or the entries of a
+#  compile_commands.json (cmake -DCMAKE_EXPORT_COMPILE_COMMANDS=ON) whose
+#  file or object matches --match (e.g. "consumer.dir/"), so the report
+#  covers the TUs of a consumer target.
+#  Every TU is compiled again:
+#      1. Clang: -ftime-trace, every InstantiateClass/InstantiateFunction
+#         event with its self time, the enclosing events are its callers
+#      2. GCC, two -fsyntax-only compiles:
+#         a. -fdump-lang-class for the count of every class specialization,
+#            less those of a TU which only includes the library (its
+#            explicit specializations), -ftime-report and -fmem-report for
+#            the time and memory of the template instantiation phase, which
+#            is shared out by count (the estimated columns, gcc has nothing
+#            per template)
+#         b. META_INSTRUMENT=1, the probes of config.h warn once per
+#            instantiation of is_same, type_category, conjunction, ...
+#            with the "required from" chain, which gives their callers
+#  Existing outputs can be read instead: --trace for -ftime-trace files and
+#  --gcc-log for the warnings of a build made with -DMETA_INSTRUMENT=1.
+#
+#  The output is a table ranked by --sort, the callers of the top traits
+#  ("is_enum caused 1300 is_same from user.cpp:12") and, with --folded, a
+#  folded stack file for flamegraph.pl or speedscope, weighted by self time
+#  in microseconds (Clang) or by instantiation count (GCC probes).
+#
+
+import argparse
+import collections
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC_DIR = os.path.normpath(os.path.join(HERE, "..", "..", "src"))
+
+NAMESPACE = "metaprogram::"
+PROBE_MESSAGE = "metaprogram instantiation"
+
+# untranslated diagnostics and reports
+ENV = dict(os.environ, LC_ALL="C")
+
+
+def compiler_family(cxx):
+    out = subprocess.run([cxx, "--version"], stdout=subprocess.PIPE,
+                         stderr=subprocess.STDOUT, universal_newlines=True).stdout
+    return "Clang" if "clang" in out.lower() else "GNU"
+
+
+def strip_nested(text):
+    """Removes what is inside <...> and (...), so the names left are at depth 0."""
+    out = []
+    depth = 0
+    for c in text:
+        if c in "<(":
+            if depth == 0:
+                out.append(c)
+            depth += 1
+        elif c in ">)" and depth > 0:
+            depth -= 1
+            if depth == 0:
+                out.append(c)
+        elif depth == 0:
+            out.append(c)
+    return "".join(out)
+
+
+def template_name(text):
+    """The template of an instantiation as printed by the compiler:
+    'constexpr const bool metaprogram::is_enum<Foo>::value' -> 'metaprogram::is_enum'."""
+    text = re.sub(r"\s*\[with .*\]$", "", text.strip())
+    # template<class T> struct metaprogram::x, drop the parameter lists
+    text = re.sub(r"^(?:template<>\s*)+", "", strip_nested(text))
+    names = re.findall(r"((?:::)?[A-Za-z_][\w:]*)(?=<>|\(\))", text)
+    if not names:
+        return text.split()[-1] if text.split() else text
+    for name in names:
+        if name.lstrip(":").startswith(NAMESPACE):
+            return name.lstrip(":")
+    return names[0].lstrip(":")
+
+
+def display_name(name):
+    return name[len(NAMESPACE):] if name.startswith(NAMESPACE) else name
+
+
+def is_library(name):
+    return name.startswith(NAMESPACE)
+
+
+class Report:
+    def __init__(self):
+        self.count = collections.Counter()
+        self.time = collections.Counter()          # seconds
+        self.memory = collections.Counter()        # bytes
+        self.callers = collections.defaultdict(collections.Counter)   # trait -> caller -> count
+        self.origins = collections.defaultdict(collections.Counter)   # (trait, caller) -> site -> count
+        self.stacks = collections.Counter()
+        self.estimated = False
+        self.has_time = False
+        self.has_memory = False
+        self.units = []
+
+    def add_caller(self, name, stack, origin):
+        """stack holds the names from the outermost caller to the direct one."""
+        caller = next((s for s in reversed(stack) if is_library(s) and s != name), None)
+        if caller is None:
+            caller = next((s for s in reversed(stack) if s != name), None) or "<top level>"
+        self.callers[name][caller] += 1
+        self.origins[(name, caller)][origin] += 1
+
+    def sites(self, name, caller):
+        """The site which asked the most, and how many others did."""
+        origins = self.origins[(name, caller)]
+        site = origins.most_common(1)[0][0]
+        return site if len(origins) == 1 else "%s +%d more" % (site, len(origins) - 1)
+
+
+# GCC ---------------------------------------------------------------------
+
+# gcc quotes with ‘’ in a utf-8 locale, the compilers are run with LC_ALL=C but
+# a --gcc-log may come from anywhere
+GCC_CONTEXT = re.compile(r"^(?P<loc>[^ ]+?):(?:(?P<line>\d+):(?:\d+:)?)?\s+"
+                         r"(?:(?:recursively )?required (?:from|by substitution of) "
+                         r"(?:['‘](?P<frame>.*)['’]|(?P<here>here))|in (?:constexpr )?expansion of)")
+GCC_HEADER = re.compile(r"^(?P<loc>[^ ]+?): In (?:instantiation|substitution) of "
+                        r"['‘](?P<frame>.*)['’]:$")
+ALIAS = re.compile(r"^(?:template<.*?>\s*)+using ")
+GCC_PROBE = re.compile(r"\[with Trait = (?P<trait>.*)\]['’] is deprecated: " + PROBE_MESSAGE)
+
+
+def parse_gcc_probes(stderr, report, unit):
+    """Callers from the probe warnings, one warning per instantiation."""
+    stack = []          # the frames of the current diagnostic, innermost first
+    origin = unit
+    for line in stderr.splitlines():
+        m = GCC_HEADER.match(line)
+        if m:
+            stack = [template_name(m.group("frame"))]
+            origin = unit
+            continue
+        m = GCC_CONTEXT.match(line)
+        if m:
+            # an alias is substituted, not instantiated, what asked for it is the next frame
+            if m.group("frame") and not ALIAS.match(m.group("frame")):
+                stack.append(template_name(m.group("frame")))
+            elif m.group("here"):
+                origin = "%s:%s" % (os.path.relpath(m.group("loc")), m.group("line"))
+            continue
+        if "[-Wdeprecated-declarations]" not in line:
+            # a diagnostic out of the instantiation context starts afresh
+            if ": In " in line and line.rstrip().endswith(":"):
+                stack = []
+                origin = unit
+            continue
+        m = GCC_PROBE.search(line)
+        if not m:
+            continue
+        name = template_name(m.group("trait"))
+        # the header frame is the probed trait itself
+        callers = list(reversed(stack[1:] if stack and stack[0] == name else stack))
+        report.add_caller(name, callers, origin)
+        frames = [os.path.basename(origin.split(":")[0])] + [display_name(s) for s in callers]
+        frames.append(display_name(name))
+        report.stacks[";".join(f.replace(";", ",") for f in frames)] += 1
+
+
+def parse_gcc_classes(dump):
+    classes = collections.Counter()
+    with open(dump) as f:
+        for line in f:
+            if line.startswith("Class ") and "<" in line:
+                classes[template_name(line[len("Class "):])] += 1
+    return classes
+
+
+def parse_gcc_reports(stderr):
+    """(template instantiation wall seconds, its GGC bytes, the TU allocated bytes)."""
+    def bytes_of(value, unit):
+        return float(value) * {"": 1, "k": 1 << 10, "M": 1 << 20, "G": 1 << 30}[unit]
+
+    seconds = memory = total = None
+    m = re.search(r"^\s*template instantiation\s*:(.*)$", stderr, re.M)
+    if m:
+        # usr, sys, wall and GGC columns
+        columns = re.findall(r"(\d+(?:\.\d+)?)([kMG]?)\s*\(\s*\d+%\)", m.group(1))
+        if len(columns) >= 3:
+            seconds = float(columns[2][0])
+        if len(columns) >= 4:
+            memory = bytes_of(*columns[3])
+    m = re.search(r"^Total\s+(\d+)([kMG]?)\s+\d+[kMG]?\s+\d+[kMG]?\s*$", stderr, re.M)
+    if m:
+        total = bytes_of(m.group(1), m.group(2))
+    return seconds, memory, total
+
+
+def dump_gcc_classes(cmd, cwd, extra):
+    """Compiles with -fdump-lang-class, returns (classes, stderr) or raises RuntimeError."""
+    with tempfile.TemporaryDirectory() as workdir:
+        dump = os.path.join(workdir, "classes")
+        proc = subprocess.run(cmd + extra + ["-fsyntax-only", "-fdump-lang-class=" + dump],
+                              cwd=cwd, env=ENV, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                              universal_newlines=True)
+        if proc.returncode != 0:
+            sys.stderr.write(proc.stderr)
+            raise RuntimeError("%s failed to compile" % cmd[-1])
+        return parse_gcc_classes(dump), proc.stderr
+
+
+# the classes of the library alone for a set of flags, the explicit
+# specializations are in the dump but are not instantiations
+library_classes = {}
+
+
+def baseline_gcc_classes(cmd, cwd, source):
+    source = os.path.realpath(os.path.join(cwd, source))
+    flags = [arg for arg in cmd if os.path.realpath(os.path.join(cwd, arg)) != source]
+    key = (cwd, tuple(flags))
+    if key not in library_classes:
+        with tempfile.TemporaryDirectory() as workdir:
+            stub = os.path.join(workdir, "library.cpp")
+            with open(stub, "w") as f:
+                f.write('#include "metaprogram.h"\n')
+            library_classes[key] = dump_gcc_classes(flags + ["-I", SRC_DIR, stub], cwd, [])[0]
+    return library_classes[key]
+
+
+def run_gcc(cmd, cwd, report, unit):
+    classes, stderr = dump_gcc_classes(cmd, cwd, ["-ftime-report", "-fmem-report"])
+    classes.subtract(baseline_gcc_classes(cmd, cwd, unit))
+    classes = +classes
+    seconds, memory, total = parse_gcc_reports(stderr)
+
+    everything = sum(classes.values())
+    for name, n in classes.items():
+        report.count[name] += n
+        if everything and seconds is not None:
+            report.time[name] += seconds * n / everything
+        if everything and memory is not None:
+            report.memory[name] += memory * n / everything
+    report.estimated = True
+    report.has_time |= seconds is not None
+    report.has_memory |= memory is not None
+    report.units.append({"unit": unit, "instantiation_time": seconds,
+                         "instantiation_memory": memory, "allocated": total})
+
+    proc = subprocess.run(cmd + ["-fsyntax-only", "-DMETA_INSTRUMENT=1", "-Wno-error",
+                                 "-Wdeprecated-declarations", "-ftemplate-backtrace-limit=0",
+                                 "-fno-diagnostics-show-caret", "-fdiagnostics-color=never"],
+                          cwd=cwd, env=ENV, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                          universal_newlines=True)
+    if proc.returncode != 0:
+        sys.stderr.write(proc.stderr)
+        raise RuntimeError("%s failed to compile with META_INSTRUMENT=1" % unit)
+    parse_gcc_probes(proc.stderr, report, unit)
+
+
+# Clang -------------------------------------------------------------------
+
+def parse_clang_trace(path, report, unit):
+    with open(path) as f:
+        events = json.load(f)["traceEvents"]
+    events = [e for e in events if e.get("ph") == "X"
+              and e.get("name") in ("InstantiateClass", "InstantiateFunction")]
+    events.sort(key=lambda e: (e.get("tid", 0), e["ts"], -e["dur"]))
+
+    stack = []          # (event, name, child time)
+    def finish(entry):
+        event, name, children = entry
+        self_us = max(event["dur"] - children, 0)
+        report.time[name] += self_us / 1e6
+        callers = [n for _, n, _ in stack]
+        frames = [os.path.basename(unit)] + [display_name(n) for n in callers] + [display_name(name)]
+        report.stacks[";".join(f.replace(";", ",") for f in frames)] += self_us
+        if stack:
+            stack[-1][2] += event["dur"]
+
+    for event in events:
+        while stack and (stack[-1][0].get("tid", 0) != event.get("tid", 0)
+                         or stack[-1][0]["ts"] + stack[-1][0]["dur"] <= event["ts"]):
+            finish(stack.pop())
+        name = template_name(event.get("args", {}).get("detail", "?"))
+        report.count[name] += 1
+        report.add_caller(name, [n for _, n, _ in stack], unit)
+        stack.append([event, name, 0])
+    while stack:
+        finish(stack.pop())
+    report.has_time = True
+    report.units.append({"unit": unit})
+
+
+def run_clang(cmd, cwd, report, unit):
+    with tempfile.TemporaryDirectory() as workdir:
+        # the trace is written next to the object file
+        obj = os.path.join(workdir, "tu.o")
+        proc = subprocess.run(cmd + ["-c", "-o", obj, "-ftime-trace", "-ftime-trace-granularity=0"],
+                              cwd=cwd, env=ENV, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                              universal_newlines=True)
+        if proc.returncode != 0:
+            sys.stderr.write(proc.stderr)
+            raise RuntimeError("%s failed to compile" % unit)
+        parse_clang_trace(os.path.join(workdir, "tu.json"), report, unit)
+
+
+# Translation units -------------------------------------------------------
+
+def strip_outputs(arguments):
+    """The compile command without its output and dependency file flags."""
+    out = []
+    skip = False
+    for arg in arguments:
+        if skip:
+            skip = False
+            continue
+        if arg in ("-o", "-MF", "-MT", "-MQ"):
+            skip = True
+            continue
+        if arg in ("-c", "-MD", "-MMD") or arg.startswith("-o") and len(arg) > 2 and arg[2] != "-":
+            continue
+        out.append(arg)
+    return out
+
+
+def compile_commands_units(path, match):
+    with open(path) as f:
+        entries = json.load(f)
+    units = []
+    for entry in entries:
+        arguments = entry.get("arguments") or shlex.split(entry["command"])
+        # the object of a cmake build is in <target>.dir/, so a target can be matched too
+        output = entry.get("output") or next(
+            (b for a, b in zip(arguments, arguments[1:]) if a == "-o"), "")
+        if match and not re.search(match, entry["file"] + " " + output):
+            continue
+        units.append((strip_outputs(arguments), entry["directory"], entry["file"]))
+    if not units:
+        raise RuntimeError("no entry of %s matches %s" % (path, match))
+    return units
+
+
+def source_units(args):
+    base = [args.cxx, "-std=" + args.std, "-I", SRC_DIR] + ["-D" + d for d in args.define] + args.flag
+    return [(base + [os.path.abspath(s)], os.getcwd(), s) for s in args.sources]
+
+
+# Output ------------------------------------------------------------------
+
+def ranked(report, args):
+    names = [n for n in report.count if args.all or is_library(n)]
+    key = {"count": report.count, "time": report.time, "memory": report.memory}[args.sort]
+    return sorted(names, key=lambda n: (-key[n], -report.count[n], n))
+
+
+def format_callers(report, name, limit):
+    parts = []
+    for caller, n in report.callers[name].most_common(limit):
+        parts.append("%s x%d" % (display_name(caller), n))
+    return ", ".join(parts)
+
+
+def print_report(report, args):
+    names = ranked(report, args)[:args.top]
+    suffix = " est." if report.estimated else ""
+    print("%4s  %-40s %10s %12s %12s  %s" % ("rank", "trait", "count", "time(ms)" + suffix,
+                                             "mem(kB)" + suffix, "top callers"))
+    for rank, name in enumerate(names, 1):
+        time_ms = "%.2f" % (1e3 * report.time[name]) if report.has_time else "-"
+        mem_kb = "%.1f" % (report.memory[name] / 1024.0) if report.has_memory else "-"
+        print("%4d  %-40s %10d %12s %12s  %s" % (rank, display_name(name)[:40], report.count[name],
+                                                 time_ms, mem_kb, format_callers(report, name, 3)))
+
+    print("")
+    # only the probed traits have callers with gcc
+    for name in [n for n in names if report.callers[n]][:args.callers]:
+        for caller, n in report.callers[name].most_common(args.callers):
+            print("%s caused %d %s from %s" % (display_name(caller), n, display_name(name),
+                                               report.sites(name, caller)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Attributes template instantiations to metaprogram traits")
+    parser.add_argument("sources", nargs="*", help="translation units to compile")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--std", default="c++14")
+    parser.add_argument("-D", "--define", action="append", default=[],
+                        help="extra macro for the sources, e.g. -D META_USE_BUILTINS=0")
+    parser.add_argument("--flag", action="append", default=[],
+                        help="extra compiler flag for the sources, e.g. --flag=-I/path")
+    parser.add_argument("--compile-commands", help="compile_commands.json of the consumer build")
+    parser.add_argument("--match", help="regex on the files (or objects, <target>.dir/) of "
+                                         "--compile-commands to report on")
+    parser.add_argument("--trace", action="append", default=[], help="existing clang -ftime-trace file")
+    parser.add_argument("--gcc-log", action="append", default=[],
+                        help="existing gcc log of a build with -DMETA_INSTRUMENT=1")
+    parser.add_argument("--sort", choices=["count", "time", "memory"], default="count")
+    parser.add_argument("--top", type=int, default=25, help="rows of the table")
+    parser.add_argument("--callers", type=int, default=5, help="traits and callers in the caller list")
+    parser.add_argument("--all", action="store_true", help="also rank std:: and user templates")
+    parser.add_argument("--folded", help="write the folded stacks for flamegraph.pl/speedscope")
+    parser.add_argument("--output", help="write the results as json")
+    args = parser.parse_args()
+
+    report = Report()
+    for path in args.trace:
+        parse_clang_trace(path, report, path)
+    for path in args.gcc_log:
+        with open(path) as f:
+            parse_gcc_probes(f.read(), report, path)
+        for name, callers in report.callers.items():
+            report.count[name] = max(report.count[name], sum(callers.values()))
+
+    units = source_units(args)
+    if args.compile_commands:
+        try:
+            units += compile_commands_units(args.compile_commands, args.match)
+        except RuntimeError as e:
+            sys.stderr.write("%s\n" % e)
+            return 1
+    if not units and not args.trace and not args.gcc_log:
+        parser.error("nothing to report on, give sources, --compile-commands, --trace or --gcc-log")
+
+    for cmd, cwd, unit in units:
+        family = compiler_family(cmd[0])
+        sys.stderr.write("compiling %s\n" % unit)
+        try:
+            (run_clang if family == "Clang" else run_gcc)(cmd, cwd, report, unit)
+        except RuntimeError as e:
+            sys.stderr.write("%s\n" % e)
+            return 1
+
+    print_report(report, args)
+
+    if args.folded:
+        with open(args.folded, "w") as f:
+            for stack, weight in sorted(report.stacks.items()):
+                f.write("%s %d\n" % (stack, weight))
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"estimated": report.estimated, "units": report.units,
+                       "traits": {n: {"count": report.count[n], "time": report.time[n],
+                                      "memory": report.memory[n],
+                                      "callers": [{"caller": c, "count": k,
+                                                   "origins": dict(report.origins[(n, c)])}
+                                                  for c, k in report.callers[n].most_common()]}
+                                  for n in ranked(report, args)}},
+                      f, indent=2, sort_keys=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,178 @@
+//
+//  flat_hash_map_bench.cpp
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+//  Runtime benchmark of flat_hash_map against std::unordered_map, both with
+//  metaprogram::hash so the tables are compared and not the hash functions.
+//  For 1K to max keys uint64 keys and values, ns per operation of:
+//      1. insert: every key into an empty map, growth included
+//      2. hit: find of every key, in random order
+//      3. miss: find of as many keys which are not in the map
+//      4. erase: every key, in random order
+//  and the bytes per entry the map holds after the inserts, counted by the
+//  allocator both maps are given. Every figure is the median of a few runs, the setup
+//  of a run (building the map to look up or erase) is not timed. 100M keys
+//  need about 8 GB for the two maps and the key arrays.
+//
+//  usage: metaprogram_flat_hash_map_bench [max keys, default 10000000]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flat_hash_map.h"
+#include "runtime_bench.h"
+
+using bench::do_not_optimize;
+
+namespace {
+    size_t allocated_bytes = 0;
+
+    // std::allocator which counts the bytes it holds
+    template <class T>
+    struct counting_allocator {
+        using value_type = T;
+
+        counting_allocator() noexcept {}
+
+        template <class U>
+        counting_allocator(const counting_allocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            allocated_bytes += n * sizeof(T);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n) noexcept {
+            allocated_bytes -= n * sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <class U>
+        bool operator==(const counting_allocator<U>&) const noexcept { return true; }
+
+        template <class U>
+        bool operator!=(const counting_allocator<U>&) const noexcept { return false; }
+    };
+
+    using entry = std::pair<const uint64_t, uint64_t>;
+    using flat_map = metaprogram::flat_hash_map<uint64_t, uint64_t, metaprogram::hash<uint64_t>,
+                                                std::equal_to<uint64_t>, counting_allocator<entry>>;
+    using std_map = std::unordered_map<uint64_t, uint64_t, metaprogram::hash<uint64_t>,
+                                       std::equal_to<uint64_t>, counting_allocator<entry>>;
+
+    struct figures {
+        double insert;
+        double hit;
+        double miss;
+        double erase;
+        double bytes;
+    };
+
+    template <class F>
+    double seconds(F&& f) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double median(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    template <class Map>
+    void fill(Map& map, const std::vector<uint64_t>& keys) {
+        for (uint64_t k : keys) {
+            map.emplace(k, k);
+        }
+    }
+
+    // keys are in the map, misses are not, order is the keys shuffled
+    template <class Map>
+    figures measure(const std::vector<uint64_t>& keys, const std::vector<uint64_t>& misses,
+                    const std::vector<uint64_t>& order, int runs) {
+        const double n = static_cast<double>(keys.size());
+        std::vector<double> insert, hit, miss, erase;
+        figures f = {0, 0, 0, 0, 0};
+        for (int run = 0; run < runs; ++run) {
+            {
+                const size_t before = allocated_bytes;
+                Map map;
+                insert.push_back(seconds([&] { fill(map, keys); }) * 1e9 / n);
+                f.bytes = (allocated_bytes - before) / n;
+                hit.push_back(seconds([&] {
+                    uint64_t sum = 0;
+                    for (uint64_t k : order) {
+                        sum += map.find(k)->second;
+                    }
+                    do_not_optimize(sum);
+                }) * 1e9 / n);
+                miss.push_back(seconds([&] {
+                    size_t found = 0;
+                    for (uint64_t k : misses) {
+                        found += map.find(k) != map.end();
+                    }
+                    do_not_optimize(found);
+                }) * 1e9 / n);
+                erase.push_back(seconds([&] {
+                    for (uint64_t k : order) {
+                        map.erase(k);
+                    }
+                    do_not_optimize(map.size());
+                }) * 1e9 / n);
+            }
+        }
+        f.insert = median(insert);
+        f.hit = median(hit);
+        f.miss = median(miss);
+        f.erase = median(erase);
+        return f;
+    }
+
+    void print(const char* name, size_t count, const figures& f) {
+        std::printf("%-20s %10zu %10.2f %10.2f %10.2f %10.2f %10.1f\n", name, count, f.insert, f.hit, f.miss,
+                    f.erase, f.bytes);
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t max_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::mt19937_64 rng(42);
+
+    std::printf("%-20s %10s %10s %10s %10s %10s %10s\n", "map", "keys", "insert ns", "hit ns", "miss ns",
+                "erase ns", "bytes/key");
+    for (size_t count = 1000; count <= max_keys; count *= 10) {
+        // odd keys are in the map, even keys miss
+        std::vector<uint64_t> keys(count);
+        std::vector<uint64_t> misses(count);
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t k = rng();
+            keys[i] = k | 1;
+            misses[i] = k & ~uint64_t(1);
+        }
+        std::vector<uint64_t> order(keys);
+        std::shuffle(order.begin(), order.end(), rng);
+
+        const int runs = count >= 10000000 ? 3 : count >= 100000 ? 5 : 21;
+        const figures flat = measure<flat_map>(keys, misses, order, runs);
+        const figures std_figures = measure<std_map>(keys, misses, order, runs);
+        print("flat_hash_map", count, flat);
+        print("std::unordered_map", count, std_figures);
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,215 @@
+//
+//  hash_bench.cpp
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+//  Throughput and quality of metaprogram::hash against std::hash:
+//      1. ns per hash of integers, a 16-byte struct (bytes against a
+//          hand-written combiner of std::hash), a struct of strings (fields
+//          against the same combiner) and strings of 8 bytes to 64 KB
+//      2. avalanche: every input bit is flipped for random inputs, and each
+//          output bit should flip half of the time. The bias of an output bit
+//          is |2 * p - 1|, we print the worst and the mean over all input and
+//          output bit pairs, 0 is ideal and 1 is a bit that never changes
+//      3. buckets: keys with a stride of 4096, like aligned pointers or ids
+//          with a type tag in the low bits, in a table of 65536 buckets indexed
+//          by the low bits of the hash: the buckets used, and the longest chain
+//
+//  usage: metaprogram_hash_bench [--quick] [--filter=string] [--json=out.json]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hash.h"
+#include "runtime_bench.h"
+
+using bench::do_not_optimize;
+
+namespace {
+    struct Key {
+        uint32_t id;
+        uint16_t shard;
+        uint16_t kind;
+        uint64_t stamp;
+    };
+
+    struct Name {
+        std::string first;
+        std::string last;
+    };
+
+    // the combiner a struct key needs with std::hash, boost::hash_combine
+    inline size_t combine(size_t seed, size_t h) {
+        return seed ^ (h + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+
+    struct std_key_hash {
+        size_t operator()(const Key& k) const {
+            size_t h = std::hash<uint32_t>()(k.id);
+            h = combine(h, std::hash<uint16_t>()(k.shard));
+            h = combine(h, std::hash<uint16_t>()(k.kind));
+            return combine(h, std::hash<uint64_t>()(k.stamp));
+        }
+    };
+
+    struct std_name_hash {
+        size_t operator()(const Name& n) const {
+            return combine(std::hash<std::string>()(n.first), std::hash<std::string>()(n.last));
+        }
+    };
+
+    std::mt19937_64 rng(42);
+
+    std::string random_string(size_t length) {
+        std::string s(length, '\0');
+        for (char& c : s) {
+            c = static_cast<char>('a' + rng() % 26);
+        }
+        return s;
+    }
+
+    template <class T, class Hash>
+    void hash_all(bench::runner& r, const std::string& name, const std::vector<T>& keys, Hash hasher) {
+        r.run(name, keys.size(), [&] {
+            size_t sum = 0;
+            for (const T& k : keys) {
+                sum += hasher(k);
+            }
+            do_not_optimize(sum);
+        });
+    }
+
+    template <class T, class Meta, class Std>
+    void throughput(bench::runner& r, const std::string& type, const std::vector<T>& keys, Meta meta, Std std_hash) {
+        hash_all(r, "hash/" + type + "/std", keys, std_hash);
+        hash_all(r, "hash/" + type + "/meta", keys, meta);
+        r.compare("hash/" + type + "/meta", "hash/" + type + "/std");
+    }
+
+    // flip(input, bit) flips one bit of the input, bits is the input width
+    struct quality {
+        double worst;
+        double mean;
+    };
+
+    template <class T, class Hash, class Flip>
+    quality avalanche(const std::vector<T>& inputs, size_t bits, Hash hasher, Flip flip) {
+        const size_t out_bits = 8 * sizeof(size_t);
+        std::vector<uint32_t> flips(bits * out_bits, 0);
+        for (const T& input : inputs) {
+            const size_t h = hasher(input);
+            for (size_t i = 0; i < bits; ++i) {
+                T flipped = input;
+                flip(flipped, i);
+                const size_t d = h ^ hasher(flipped);
+                for (size_t j = 0; j < out_bits; ++j) {
+                    flips[i * out_bits + j] += (d >> j) & 1;
+                }
+            }
+        }
+        quality q = {0.0, 0.0};
+        for (uint32_t f : flips) {
+            const double bias = std::fabs(2.0 * f / inputs.size() - 1.0);
+            q.worst = std::max(q.worst, bias);
+            q.mean += bias / flips.size();
+        }
+        return q;
+    }
+
+    template <class Hash>
+    void buckets(const char* name, Hash hasher) {
+        const size_t table = 65536;
+        std::vector<uint32_t> load(table, 0);
+        for (uint64_t i = 0; i < table; ++i) {
+            ++load[hasher(i * 4096) & (table - 1)];
+        }
+        size_t used = 0;
+        uint32_t longest = 0;
+        for (uint32_t l : load) {
+            used += l != 0;
+            longest = std::max(longest, l);
+        }
+        std::printf("%-40s %9.1f%% %10u\n", name, 100.0 * used / table, longest);
+    }
+
+    void flip_string(std::string& s, size_t bit) {
+        s[bit / 8] = static_cast<char>(s[bit / 8] ^ (1 << (bit % 8)));
+    }
+
+    template <class T>
+    void flip_bytes(T& value, size_t bit) {
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(&value);
+        bytes[bit / 8] = static_cast<unsigned char>(bytes[bit / 8] ^ (1 << (bit % 8)));
+    }
+
+    void print(const char* name, quality q) {
+        std::printf("%-40s %10.4f %10.4f\n", name, q.worst, q.mean);
+    }
+}
+
+int main(int argc, char** argv) {
+    const bench::options options = bench::parse_options(argc, argv);
+    const bool quick = options.repetitions < 31;
+    bench::runner r(options);
+
+    std::vector<uint64_t> integers(4096);
+    for (uint64_t& i : integers) {
+        i = rng();
+    }
+    throughput(r, "uint64", integers, metaprogram::hash<uint64_t>(), std::hash<uint64_t>());
+
+    std::vector<Key> keys(4096);
+    for (Key& k : keys) {
+        k = Key{static_cast<uint32_t>(rng()), static_cast<uint16_t>(rng()), static_cast<uint16_t>(rng()), rng()};
+    }
+    throughput(r, "key", keys, metaprogram::hash<Key>(), std_key_hash());
+
+    std::vector<Name> names(1024);
+    for (Name& n : names) {
+        n = Name{random_string(6 + rng() % 8), random_string(6 + rng() % 8)};
+    }
+    throughput(r, "name", names, metaprogram::hash<Name>(), std_name_hash());
+
+    for (size_t length : {8, 32, 256, 4096, 65536}) {
+        std::vector<std::string> strings(length >= 4096 ? 16 : 1024);
+        for (std::string& s : strings) {
+            s = random_string(length);
+        }
+        throughput(r, "string/" + std::to_string(length), strings, metaprogram::hash<std::string>(),
+                   std::hash<std::string>());
+    }
+
+    const size_t samples = quick ? 200 : 2000;
+    std::printf("\n%-40s %10s %10s\n", "avalanche", "worst bias", "mean bias");
+    print("uint64/std", avalanche(integers, 64, std::hash<uint64_t>(), flip_bytes<uint64_t>));
+    print("uint64/meta", avalanche(integers, 64, metaprogram::hash<uint64_t>(), flip_bytes<uint64_t>));
+    const std::vector<Key> key_samples(keys.begin(), keys.begin() + samples);
+    print("key/std", avalanche(key_samples, 8 * sizeof(Key), std_key_hash(), flip_bytes<Key>));
+    print("key/meta", avalanche(key_samples, 8 * sizeof(Key), metaprogram::hash<Key>(), flip_bytes<Key>));
+    for (size_t length : {32, 1024}) {
+        std::vector<std::string> strings(length > 256 ? samples / 10 : samples);
+        for (std::string& s : strings) {
+            s = random_string(length);
+        }
+        const std::string prefix = "string/" + std::to_string(length);
+        print((prefix + "/std").c_str(), avalanche(strings, 8 * length, std::hash<std::string>(), flip_string));
+        print((prefix + "/meta").c_str(),
+              avalanche(strings, 8 * length, metaprogram::hash<std::string>(), flip_string));
+    }
+
+    std::printf("\n%-40s %10s %10s\n", "buckets, stride 4096", "used", "longest");
+    buckets("uint64/std", std::hash<uint64_t>());
+    buckets("uint64/meta", metaprogram::hash<uint64_t>());
+    std::printf("\n");
+    return r.finish();
+}
@@ -0,0 +1,125 @@
+//
+//  metaprogram_bench.cpp
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+//  Runtime benchmark of the trait-selected paths of algorithm.h against the
+//  generic path of the same algorithm, which is what the call would do if
+//  the trait were false: the detail overload is called with false_type. The
+//  trait-selected path has to be at least as fast, --check fails when it is
+//  more than --tolerance times slower, see runtime_bench.h for the options.
+//
+//  usage: metaprogram_bench [--quick] [--check] [--filter=copy_n] [--json=out.json]
+//
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "algorithm.h"
+#include "small_vector.h"
+#include "runtime_bench.h"
+
+using bench::clobber;
+
+namespace {
+    struct Pod {
+        int i;
+        float f;
+        double d;
+    };
+
+    const size_t sizes[] = {64, 16384};
+
+    std::string name(const char* op, const char* type, size_t count, const char* path) {
+        return std::string(op) + "/" + type + "/" + std::to_string(count) + "/" + path;
+    }
+
+    template <class T>
+    void copy(bench::runner& r, const char* type, size_t count) {
+        std::vector<T> src(count, T());
+        std::vector<T> dst(count, T());
+        const std::string generic = name("copy_n", type, count, "generic");
+        const std::string meta = name("copy_n", type, count, "meta");
+        r.run(generic, count, [&] {
+            metaprogram::detail::copy_n(src.data(), count, dst.data(), metaprogram::false_type());
+            clobber(dst.data());
+        });
+        r.run(meta, count, [&] { metaprogram::copy_n(src.data(), count, dst.data()); clobber(dst.data()); });
+        r.compare(meta, generic);
+    }
+
+    template <class T>
+    void fill_zero(bench::runner& r, const char* type, size_t count) {
+        std::vector<T> dst(count, T());
+        const T zero = T();
+        const std::string generic = name("fill_n", type, count, "generic");
+        const std::string meta = name("fill_n", type, count, "meta");
+        r.run(generic, count, [&] {
+            metaprogram::detail::fill_n(dst.data(), count, zero, metaprogram::false_type());
+            clobber(dst.data());
+        });
+        r.run(meta, count, [&] { metaprogram::fill_n(dst.data(), count, zero); clobber(dst.data()); });
+        r.compare(meta, generic);
+    }
+
+    template <class T>
+    void value_construct(bench::runner& r, const char* type, size_t count) {
+        std::vector<T> dst(count, T());
+        T* first = dst.data();
+        const std::string generic = name("value_construct", type, count, "generic");
+        const std::string meta = name("value_construct", type, count, "meta");
+        r.run(generic, count, [&] {
+            metaprogram::detail::uninitialized_value_construct(first, first + count, metaprogram::false_type());
+            clobber(first);
+        });
+        r.run(meta, count, [&] { metaprogram::uninitialized_value_construct(first, first + count); clobber(first); });
+        r.compare(meta, generic);
+    }
+
+    // unique_ptr opts in to is_trivially_relocatable (small_vector.h), the
+    // elements go back and forth between two buffers, two relocations a call
+    void relocate(bench::runner& r, size_t count) {
+        using T = std::unique_ptr<int>;
+        std::allocator<T> allocator;
+        T* a = allocator.allocate(count);
+        T* b = allocator.allocate(count);
+        metaprogram::uninitialized_value_construct(a, a + count);
+        for (size_t i = 0; i < count; ++i) {
+            a[i].reset(new int(static_cast<int>(i)));
+        }
+        const std::string generic = name("relocate", "unique_ptr", count, "generic");
+        const std::string meta = name("relocate", "unique_ptr", count, "meta");
+        r.run(generic, 2 * count, [&] {
+            metaprogram::detail::uninitialized_relocate(a, a + count, b, metaprogram::false_type());
+            metaprogram::detail::uninitialized_relocate(b, b + count, a, metaprogram::false_type());
+            clobber(a);
+        });
+        r.run(meta, 2 * count, [&] {
+            metaprogram::uninitialized_relocate(a, a + count, b);
+            metaprogram::uninitialized_relocate(b, b + count, a);
+            clobber(a);
+        });
+        r.compare(meta, generic);
+        metaprogram::destroy(a, a + count);
+        allocator.deallocate(a, count);
+        allocator.deallocate(b, count);
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::runner r(bench::parse_options(argc, argv));
+    for (size_t count : sizes) {
+        copy<int>(r, "int", count);
+        copy<Pod>(r, "pod", count);
+        fill_zero<double>(r, "double", count);
+        fill_zero<Pod>(r, "pod", count);
+        value_construct<int>(r, "int", count);
+        value_construct<double*>(r, "pointer", count);
+        relocate(r, count);
+    }
+    return r.finish();
+}
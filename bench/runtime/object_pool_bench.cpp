@@ -0,0 +1,156 @@
+//
+//  object_pool_bench.cpp
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+//  Runtime benchmark of object_pool against new and delete: every thread
+//  keeps a working set of orders and replaces a pseudo-random one per step,
+//  the destruction of the old order and the creation of the new one are
+//  timed together. Percentiles of that latency in ns over all threads, for
+//  1, 8 and 32 threads; the cost of reading the clock is printed first and
+//  included in every sample. Mops/s is the replacements per second of all
+//  threads in a second run which reads no clock.
+//
+//  usage: metaprogram_object_pool_bench [steps per thread, default 200000]
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "object_pool.h"
+#include "runtime_bench.h"
+
+using bench::clobber;
+
+namespace {
+    struct Order {
+        uint64_t id;
+        uint64_t account;
+        double price;
+        double quantity;
+        uint32_t side;
+        uint32_t flags;
+        char symbol[16];
+    };
+
+    constexpr size_t working_set = 1024;
+
+    struct HeapAllocator {
+        static Order* create(uint64_t id) { return new Order{id, 0, 0.0, 0.0, 0, 0, {}}; }
+        static void destroy(Order* order) { delete order; }
+    };
+
+    struct PoolAllocator {
+        static Order* create(uint64_t id) {
+            return metaprogram::object_pool<Order>::create(Order{id, 0, 0.0, 0.0, 0, 0, {}});
+        }
+        static void destroy(Order* order) { metaprogram::object_pool<Order>::destroy(order); }
+    };
+
+    // samples is null for the throughput run, which reads no clock
+    template <class Allocator>
+    BENCH_NOINLINE void churn(size_t steps, uint64_t seed, uint32_t* samples) {
+        std::vector<Order*> orders(working_set, nullptr);
+        uint64_t state = seed;
+        for (size_t step = 0; step < steps; ++step) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            Order*& slot = orders[(state >> 33) % working_set];
+            if (samples) {
+                auto start = std::chrono::steady_clock::now();
+                Allocator::destroy(slot);
+                slot = Allocator::create(step);
+                auto stop = std::chrono::steady_clock::now();
+                samples[step] = static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+            } else {
+                Allocator::destroy(slot);
+                slot = Allocator::create(step);
+            }
+            clobber(slot);
+        }
+        for (Order* order : orders) {
+            Allocator::destroy(order);
+        }
+    }
+
+    // runs churn on threads started together, returns the wall time in ns
+    template <class Allocator>
+    double run_threads(size_t threads, size_t steps, std::vector<std::vector<uint32_t>>* samples) {
+        std::atomic<size_t> ready(0);
+        std::vector<std::thread> workers;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                ++ready;
+                while (ready.load() != threads) {
+                    std::this_thread::yield();
+                }
+                churn<Allocator>(steps, t + 1, samples ? (*samples)[t].data() : nullptr);
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Result {
+        std::vector<uint32_t> sorted;
+        double mops;
+    };
+
+    template <class Allocator>
+    Result run(size_t threads, size_t steps) {
+        std::vector<std::vector<uint32_t>> samples(threads, std::vector<uint32_t>(steps));
+        run_threads<Allocator>(threads, steps, &samples);
+        Result result;
+        result.sorted.reserve(threads * steps);
+        for (const std::vector<uint32_t>& s : samples) {
+            result.sorted.insert(result.sorted.end(), s.begin(), s.end());
+        }
+        std::sort(result.sorted.begin(), result.sorted.end());
+        result.mops = threads * steps / run_threads<Allocator>(threads, steps, nullptr) * 1e3;
+        return result;
+    }
+
+    uint32_t percentile(const std::vector<uint32_t>& sorted, double p) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p / 100 * sorted.size()))];
+    }
+
+    void report(const char* allocator, size_t threads, const Result& r) {
+        std::printf("%-12s %7zu %8u %8u %8u %8u %10u %8.1f\n", allocator, threads, percentile(r.sorted, 50),
+            percentile(r.sorted, 90), percentile(r.sorted, 99), percentile(r.sorted, 99.9), r.sorted.back(), r.mops);
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t steps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    std::vector<uint32_t> clock(steps);
+    for (size_t i = 0; i < steps; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        auto stop = std::chrono::steady_clock::now();
+        clock[i] = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    }
+    std::sort(clock.begin(), clock.end());
+    std::printf("clock read: p50 %u ns, %u hardware threads\n", percentile(clock, 50),
+        std::thread::hardware_concurrency());
+
+    std::printf("%-12s %7s %8s %8s %8s %8s %10s %8s\n", "allocator", "threads", "p50", "p90", "p99", "p99.9", "max",
+        "Mops/s");
+    for (size_t threads : {1, 8, 32}) {
+        report("new/delete", threads, run<HeapAllocator>(threads, steps));
+        report("object_pool", threads, run<PoolAllocator>(threads, steps));
+    }
+    return 0;
+}
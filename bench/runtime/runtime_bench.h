@@ -0,0 +1,381 @@
+//
+//  runtime_bench.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+//  Timing helpers shared by the runtime benchmarks, and the harness of
+//  metaprogram_bench: warmup, repetitions, median/p99, cycle counts and json.
+//
+
+#ifndef runtime_bench_h
+#define runtime_bench_h
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace bench {
+    // keeps the stores of the measured call alive
+    inline void clobber(const void* p) {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(p) : "memory");
+#else
+        static const void* volatile sink;
+        sink = p;
+#endif
+    }
+
+    // the compiler must assume value is read, so the computation of it stays
+    template <class T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        clobber(&value);
+#endif
+    }
+
+    // the compiler must assume all memory is read and written here
+    inline void clobber_memory() {
+#if defined(__GNUC__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+    // the best of a few runs of f, which handles count elements, in nanoseconds
+    // per element
+    template <class F>
+    double measure(size_t count, F&& f) {
+        const int runs = count >= 10000000 ? 3 : 10;
+        const size_t repeat = std::max<size_t>(1, 10000000 / count);
+        double best = 0;
+        for (int run = 0; run < runs; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < repeat; ++i) {
+                f();
+            }
+            auto stop = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (repeat * count);
+            best = run == 0 ? ns : std::min(best, ns);
+        }
+        return best;
+    }
+
+    // Counts cycles with the cpu cycles counter of perf_event_open, or the
+    // time stamp counter on x86 where perf events are not allowed (its rate
+    // is the nominal frequency, not the current one), or not at all.
+    class cycle_counter {
+    public:
+        cycle_counter() : fd_(-1), source_(nullptr) {
+#if defined(__linux__)
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd_ >= 0) {
+                ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+                source_ = "perf";
+                return;
+            }
+#endif
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            source_ = "tsc";
+#endif
+        }
+
+        cycle_counter(const cycle_counter&) = delete;
+        cycle_counter& operator=(const cycle_counter&) = delete;
+
+        ~cycle_counter() {
+#if defined(__linux__)
+            if (fd_ >= 0) {
+                close(fd_);
+            }
+#endif
+        }
+
+        // "perf", "tsc" or null when there is no counter
+        const char* source() const { return source_; }
+
+        uint64_t now() const {
+#if defined(__linux__)
+            uint64_t count = 0;
+            if (fd_ >= 0 && read(fd_, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) {
+                return count;
+            }
+#endif
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return 0;
+#endif
+        }
+
+    private:
+        int fd_;
+        const char* source_;
+    };
+
+    struct options {
+        int warmup = 3;                 // repetitions run before the measured ones
+        int repetitions = 31;           // measured repetitions of every benchmark
+        double min_time = 0.005;        // seconds, a repetition runs the call this long
+        const char* filter = nullptr;   // only the benchmarks whose name contains it
+        const char* json = nullptr;     // path of the json report, - for stdout
+        bool check = false;             // exit with 1 when a comparison fails
+        double tolerance = 1.5;         // how much slower than the generic path a fast path may be
+    };
+
+    // --warmup=N --repetitions=N --min-time=S --filter=S --json=PATH --check
+    // --tolerance=X, and --quick for a smoke run of few short repetitions
+    inline options parse_options(int argc, char** argv) {
+        options o;
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = std::strchr(arg, '=');
+            value = value ? value + 1 : "";
+            if (std::strncmp(arg, "--warmup=", 9) == 0) {
+                o.warmup = std::atoi(value);
+            } else if (std::strncmp(arg, "--repetitions=", 14) == 0) {
+                o.repetitions = std::max(1, std::atoi(value));
+            } else if (std::strncmp(arg, "--min-time=", 11) == 0) {
+                o.min_time = std::atof(value);
+            } else if (std::strncmp(arg, "--filter=", 9) == 0) {
+                o.filter = value;
+            } else if (std::strncmp(arg, "--json=", 7) == 0) {
+                o.json = value;
+            } else if (std::strncmp(arg, "--tolerance=", 12) == 0) {
+                o.tolerance = std::atof(value);
+            } else if (std::strcmp(arg, "--check") == 0) {
+                o.check = true;
+            } else if (std::strcmp(arg, "--quick") == 0) {
+                o.warmup = 1;
+                o.repetitions = 7;
+                o.min_time = 0.001;
+            } else {
+                std::fprintf(stderr, "unknown option %s\n", arg);
+                std::exit(2);
+            }
+        }
+        return o;
+    }
+
+    // Per item figures of a benchmark, over its repetitions.
+    struct result {
+        std::string name;
+        size_t items;           // items handled by a call
+        size_t iterations;      // calls in a repetition
+        double median_ns;
+        double p99_ns;
+        double min_ns;
+        double median_cycles;   // negative without a cycle counter
+    };
+
+    // Runs benchmarks and the comparisons of a trait-selected path with the
+    // generic one it replaces.
+    // Example:
+    //      bench::runner r(bench::parse_options(argc, argv));
+    //      r.run("copy/generic", n, [&] { generic_copy(src, n, dst); bench::clobber(dst); });
+    //      r.run("copy/meta", n, [&] { metaprogram::copy_n(src, n, dst); bench::clobber(dst); });
+    //      r.compare("copy/meta", "copy/generic");
+    //      return r.finish();
+    // Implementation Note:
+    // 1. The number of calls in a repetition is set once, before the warmup,
+    //      so a repetition lasts min_time. Every repetition is one sample: the
+    //      p99 is of repetitions, a single call is too short for the clock
+    class runner {
+    public:
+        explicit runner(const options& o) : options_(o) {
+            std::printf("%-40s %10s %10s %10s %10s %12s\n", "benchmark", "items", "median ns", "p99 ns",
+                        "min ns", "cycles");
+        }
+
+        // f handles items items per call, skipped when it doesn't match the filter
+        template <class F>
+        void run(const std::string& name, size_t items, F&& f) {
+            if (options_.filter && name.find(options_.filter) == std::string::npos) {
+                return;
+            }
+            size_t iterations = 1;
+            for (;;) {
+                const double seconds = time_calls(f, iterations, nullptr);
+                if (seconds >= options_.min_time || iterations >= (size_t(1) << 40)) {
+                    break;
+                }
+                const double scale = seconds > 0 ? options_.min_time / seconds : 100.0;
+                iterations = static_cast<size_t>(std::ceil(iterations * std::min(std::max(scale, 1.5), 100.0)));
+            }
+            for (int i = 0; i < options_.warmup; ++i) {
+                time_calls(f, iterations, nullptr);
+            }
+
+            std::vector<double> ns;
+            std::vector<double> cycles;
+            for (int i = 0; i < options_.repetitions; ++i) {
+                uint64_t c = 0;
+                const double seconds = time_calls(f, iterations, &c);
+                ns.push_back(seconds * 1e9 / (static_cast<double>(iterations) * items));
+                cycles.push_back(static_cast<double>(c) / (static_cast<double>(iterations) * items));
+            }
+            std::sort(ns.begin(), ns.end());
+            std::sort(cycles.begin(), cycles.end());
+
+            result r;
+            r.name = name;
+            r.items = items;
+            r.iterations = iterations;
+            r.median_ns = percentile(ns, 0.5);
+            r.p99_ns = percentile(ns, 0.99);
+            r.min_ns = ns.front();
+            r.median_cycles = counter_.source() ? percentile(cycles, 0.5) : -1.0;
+            results_.push_back(r);
+            std::printf("%-40s %10zu %10.3f %10.3f %10.3f %12s\n", name.c_str(), items, r.median_ns, r.p99_ns,
+                        r.min_ns, format_cycles(r.median_cycles).c_str());
+            std::fflush(stdout);
+        }
+
+        // the fast path must not be slower than tolerance times the generic one,
+        // in medians, with --check
+        void compare(const std::string& fast, const std::string& generic) {
+            const result* f = find(fast);
+            const result* g = find(generic);
+            if (f && g) {
+                comparisons_.push_back(comparison{fast, generic, g->median_ns / f->median_ns,
+                                                  f->median_ns <= options_.tolerance * g->median_ns});
+            }
+        }
+
+        // prints the comparisons, writes the json report, returns the exit code
+        int finish() const {
+            bool ok = true;
+            if (!comparisons_.empty()) {
+                std::printf("\n%-40s %-40s %8s\n", "trait-selected", "generic", "speedup");
+                for (const comparison& c : comparisons_) {
+                    std::printf("%-40s %-40s %7.2fx%s\n", c.fast.c_str(), c.generic.c_str(), c.speedup,
+                                c.ok ? "" : "  SLOWER");
+                    ok = ok && c.ok;
+                }
+            }
+            if (options_.json) {
+                write_json();
+            }
+            return options_.check && !ok ? 1 : 0;
+        }
+
+    private:
+        struct comparison {
+            std::string fast;
+            std::string generic;
+            double speedup;
+            bool ok;
+        };
+
+        template <class F>
+        double time_calls(F& f, size_t iterations, uint64_t* cycles) const {
+            const uint64_t first_cycle = cycles ? counter_.now() : 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i) {
+                f();
+            }
+            const auto stop = std::chrono::steady_clock::now();
+            if (cycles) {
+                *cycles = counter_.now() - first_cycle;
+            }
+            return std::chrono::duration<double>(stop - start).count();
+        }
+
+        // nearest rank of sorted samples
+        static double percentile(const std::vector<double>& sorted, double p) {
+            const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+            return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+        }
+
+        static std::string format_cycles(double cycles) {
+            char text[32] = "-";
+            if (cycles >= 0) {
+                std::snprintf(text, sizeof(text), "%.2f", cycles);
+            }
+            return text;
+        }
+
+        const result* find(const std::string& name) const {
+            for (const result& r : results_) {
+                if (r.name == name) {
+                    return &r;
+                }
+            }
+            return nullptr;
+        }
+
+        // the names are the benchmark's own, they need no escaping
+        void write_json() const {
+            FILE* out = std::strcmp(options_.json, "-") == 0 ? stdout : std::fopen(options_.json, "w");
+            if (out == nullptr) {
+                std::fprintf(stderr, "can't write %s\n", options_.json);
+                return;
+            }
+            std::fprintf(out, "{\n  \"context\": {\"cycle_counter\": \"%s\", \"warmup\": %d, \"repetitions\": %d, "
+                              "\"min_time\": %g, \"tolerance\": %g},\n  \"benchmarks\": [",
+                         counter_.source() ? counter_.source() : "none", options_.warmup, options_.repetitions,
+                         options_.min_time, options_.tolerance);
+            for (size_t i = 0; i < results_.size(); ++i) {
+                const result& r = results_[i];
+                std::fprintf(out, "%s\n    {\"name\": \"%s\", \"items\": %zu, \"iterations\": %zu, "
+                                  "\"median_ns\": %.4f, \"p99_ns\": %.4f, \"min_ns\": %.4f, \"median_cycles\": %s}",
+                             i ? "," : "", r.name.c_str(), r.items, r.iterations, r.median_ns, r.p99_ns, r.min_ns,
+                             r.median_cycles >= 0 ? format_cycles(r.median_cycles).c_str() : "null");
+            }
+            std::fprintf(out, "\n  ],\n  \"comparisons\": [");
+            for (size_t i = 0; i < comparisons_.size(); ++i) {
+                const comparison& c = comparisons_[i];
+                std::fprintf(out, "%s\n    {\"fast\": \"%s\", \"generic\": \"%s\", \"speedup\": %.4f, \"ok\": %s}",
+                             i ? "," : "", c.fast.c_str(), c.generic.c_str(), c.speedup, c.ok ? "true" : "false");
+            }
+            std::fprintf(out, "\n  ]\n}\n");
+            if (out != stdout) {
+                std::fclose(out);
+            }
+        }
+
+        options options_;
+        cycle_counter counter_;
+        std::vector<result> results_;
+        std::vector<comparison> comparisons_;
+    };
+}
+
+#endif /* runtime_bench_h */
@@ -0,0 +1,97 @@
+//
+//  small_vector_bench.cpp
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+//  Runtime benchmark of small_vector against std::vector: push_back growth
+//  without reserve, and erase from the middle, for int, unique_ptr and a
+//  record which opts in to is_trivially_relocatable.
+//
+//  usage: metaprogram_small_vector_bench [max elements, default 10000000]
+//
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "small_vector.h"
+#include "runtime_bench.h"
+
+using bench::clobber;
+using bench::measure;
+
+namespace {
+    struct Record {
+        std::unique_ptr<int> payload;
+        std::string* name;
+        int id;
+
+        Record() : name(nullptr), id(0) {}
+    };
+}
+
+NS_META_BEG
+template <>
+struct is_trivially_relocatable<Record> : public true_type {};
+NS_META_END
+
+namespace {
+    void report(const char* op, const char* type, size_t count, double std_ns, double meta_ns) {
+        std::printf("%-10s %-11s %10zu %10.3f %10.3f %8.2fx\n", op, type, count, std_ns, meta_ns, std_ns / meta_ns);
+    }
+
+    template <class V>
+    BENCH_NOINLINE void grow(size_t count) {
+        V v;
+        for (size_t i = 0; i < count; ++i) {
+            v.emplace_back();
+        }
+        clobber(v.data());
+    }
+
+    // erases from the middle and appends, so the size stays count
+    template <class V>
+    BENCH_NOINLINE void erase_middle(V& v, size_t ops) {
+        for (size_t i = 0; i < ops; ++i) {
+            v.erase(v.begin() + static_cast<ptrdiff_t>(v.size() / 2));
+            v.emplace_back();
+        }
+        clobber(v.data());
+    }
+
+    template <class T>
+    void run(const char* type, size_t count) {
+        using std_vector = std::vector<T>;
+        using meta_vector = metaprogram::small_vector<T, 16>;
+
+        // the elements are default constructed, the unique_ptrs are null, so
+        // only the growth is measured and not the allocation of the pointees
+        double std_ns = measure(count, [&] { grow<std_vector>(count); });
+        double meta_ns = measure(count, [&] { grow<meta_vector>(count); });
+        report("push_back", type, count, std_ns, meta_ns);
+
+        // ns per erase, each erase moves count / 2 elements
+        const size_t ops = 100;
+        std_vector s(count);
+        meta_vector m(count);
+        std_ns = measure(count * ops, [&] { erase_middle(s, ops); }) * count;
+        meta_ns = measure(count * ops, [&] { erase_middle(m, ops); }) * count;
+        report("erase mid", type, count, std_ns, meta_ns);
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t max_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::printf("%-10s %-11s %10s %10s %10s %9s\n", "op", "type", "elements", "std ns", "meta ns", "speedup");
+    for (size_t count = 1000; count <= max_count; count *= 10) {
+        run<int>("int", count);
+        run<std::unique_ptr<int>>("unique_ptr", count);
+        run<Record>("record", count);
+    }
+    return 0;
+}
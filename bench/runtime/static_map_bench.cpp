@@ -0,0 +1,192 @@
+//
+//  static_map_bench.cpp
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+//  Lookup latency of static_map against std::unordered_map and a binary
+//  search of a sorted array, for 256 header-like string keys and 256 sparse
+//  integer ids: ns per lookup of a stream of 4096 keys which are all in the
+//  map (hit) or none of them (miss). The string keys are looked up with
+//  std::string_view into buffers filled at runtime, so no lookup is folded.
+//
+//  usage: metaprogram_static_map_bench [--quick] [--filter=string] [--json=out.json]
+//
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "static_map.h"
+#include "runtime_bench.h"
+
+using bench::do_not_optimize;
+
+namespace {
+    constexpr std::pair<std::string_view, int> field_entries[] = {
+        {"content-host", 0}, {"cache-trace-id", 1}, {"if-request-id", 2}, {"access-control-type", 3}, {"te", 4},
+        {"websocket-key", 5}, {"if-status", 6}, {"x-cookie", 7}, {"content-range", 8},
+        {"access-control-none-match", 9}, {"status", 10}, {"access-control-via", 11}, {"proxy-origin", 12},
+        {"accept-max-age", 13}, {"accept-te", 14}, {"sec-allow-methods", 15}, {"retry-type", 16},
+        {"retry-vary", 17}, {"if-origin", 18}, {"retry-trace-id", 19}, {"accept-md5", 20},
+        {"accept-unmodified-since", 21}, {"cache-upgrade", 22}, {"proxy-fetch-site", 23}, {"accept-match", 24},
+        {"proxy-charset", 25}, {"max-age", 26}, {"sec-authorization", 27}, {"sec-forwarded-for", 28},
+        {"x-trailer", 29}, {"accept-via", 30}, {"access-control-security-policy", 31}, {"accept-authorization", 32},
+        {"if-date", 33}, {"accept-language", 34}, {"if-priority", 35}, {"retry-match", 36}, {"x-match", 37},
+        {"proxy-expect", 38}, {"accept-security-policy", 39}, {"content-trailer", 40}, {"if-max-age", 41},
+        {"content-allow-headers", 42}, {"cache-match", 43}, {"accept-set-cookie", 44}, {"content-origin", 45},
+        {"x-length", 46}, {"accept-host", 47}, {"accept-status", 48}, {"if-disposition", 49},
+        {"accept-user-agent", 50}, {"forwarded-for", 51}, {"retry-allow-headers", 52}, {"content-max-age", 53},
+        {"access-control-cookie", 54}, {"if-type", 55}, {"x-expect", 56}, {"if-upgrade", 57}, {"cache-expect", 58},
+        {"retry-fetch-site", 59}, {"link", 60}, {"origin", 61}, {"access-control-fetch-mode", 62},
+        {"x-priority", 63}, {"cache-via", 64}, {"sec-encoding", 65}, {"cache-cookie", 66}, {"proxy-user-agent", 67},
+        {"retry-websocket-version", 68}, {"cache-security-policy", 69}, {"retry-upgrade", 70},
+        {"if-none-match", 71}, {"vary", 72}, {"retry-request-id", 73}, {"content-fetch-mode", 74},
+        {"authenticate", 75}, {"if-forwarded-for", 76}, {"if-websocket-key", 77}, {"if-range", 78},
+        {"x-modified-since", 79}, {"access-control-disposition", 80}, {"x-control", 81}, {"x-trace-id", 82},
+        {"access-control-length", 83}, {"x-after", 84}, {"accept-type", 85}, {"content-websocket-key", 86},
+        {"retry-location", 87}, {"content-md5", 88}, {"accept-none-match", 89},
+        {"access-control-authorization", 90}, {"sec-charset", 91}, {"access-control-max-age", 92},
+        {"cache-length", 93}, {"sec-after", 94}, {"x-warning", 95}, {"accept-modified-since", 96},
+        {"if-fetch-site", 97}, {"accept-allow-methods", 98}, {"retry-priority", 99}, {"retry-authorization", 100},
+        {"sec-via", 101}, {"sec-fetch-site", 102}, {"if-unmodified-since", 103}, {"x-max-age", 104},
+        {"cache-link", 105}, {"content-disposition", 106}, {"cache-set-cookie", 107}, {"retry-set-cookie", 108},
+        {"x-status", 109}, {"retry-md5", 110}, {"retry-forwarded-for", 111}, {"retry-expose-headers", 112},
+        {"content-expect", 113}, {"x-date", 114}, {"if-user-agent", 115}, {"content-encoding", 116}, {"after", 117},
+        {"sec-length", 118}, {"content-link", 119}, {"request-id", 120}, {"accept-warning", 121},
+        {"content-trace-id", 122}, {"control", 123}, {"access-control-link", 124}, {"proxy-location", 125},
+        {"sec-language", 126}, {"if-vary", 127}, {"type", 128}, {"proxy-websocket-version", 129},
+        {"retry-max-age", 130}, {"cache-authorization", 131}, {"access-control-request-id", 132},
+        {"accept-websocket-key", 133}, {"proxy-cookie", 134}, {"access-control-unmodified-since", 135},
+        {"retry-websocket-key", 136}, {"access-control-websocket-version", 137}, {"x-pragma", 138},
+        {"access-control-trace-id", 139}, {"x-authenticate", 140}, {"if-fetch-dest", 141}, {"sec-referer", 142},
+        {"access-control-pragma", 143}, {"cache-language", 144}, {"x-fetch-dest", 145}, {"disposition", 146},
+        {"retry-unmodified-since", 147}, {"proxy-type", 148}, {"x-location", 149}, {"host", 150},
+        {"proxy-allow-headers", 151}, {"sec-request-id", 152}, {"if-host", 153}, {"x-user-agent", 154},
+        {"sec-md5", 155}, {"accept-after", 156}, {"access-control-range", 157}, {"range", 158},
+        {"proxy-priority", 159}, {"x-encoding", 160}, {"cache-none-match", 161}, {"content-te", 162},
+        {"proxy-control", 163}, {"proxy-request-id", 164}, {"sec-cookie", 165}, {"sec-warning", 166}, {"etag", 167},
+        {"allow-methods", 168}, {"cache-type", 169}, {"proxy-trailer", 170}, {"cache-host", 171},
+        {"if-length", 172}, {"security-policy", 173}, {"retry-expect", 174}, {"retry-cookie", 175},
+        {"content-user-agent", 176}, {"content-vary", 177}, {"sec-disposition", 178}, {"proxy-match", 179},
+        {"sec-link", 180}, {"if-expect", 181}, {"sec-pragma", 182}, {"x-allow-methods", 183}, {"x-none-match", 184},
+        {"if-security-policy", 185}, {"access-control-fetch-dest", 186}, {"sec-control", 187},
+        {"if-allow-headers", 188}, {"accept-origin", 189}, {"content-after", 190}, {"proxy-date", 191},
+        {"if-match", 192}, {"proxy-authenticate", 193}, {"retry-from", 194}, {"referer", 195}, {"if-control", 196},
+        {"x-set-cookie", 197}, {"access-control-md5", 198}, {"x-websocket-key", 199}, {"if-trailer", 200},
+        {"fetch-site", 201}, {"language", 202}, {"cache-from", 203}, {"retry-none-match", 204},
+        {"accept-expect", 205}, {"cache-unmodified-since", 206}, {"cache-charset", 207},
+        {"access-control-after", 208}, {"cache-md5", 209}, {"content-length", 210},
+        {"content-websocket-version", 211}, {"if-etag", 212}, {"proxy-md5", 213}, {"access-control-expect", 214},
+        {"cookie", 215}, {"proxy-set-cookie", 216}, {"proxy-websocket-key", 217}, {"retry-via", 218},
+        {"proxy-via", 219}, {"access-control-date", 220}, {"access-control-status", 221}, {"cache-request-id", 222},
+        {"access-control-location", 223}, {"retry-control", 224}, {"content-security-policy", 225},
+        {"retry-security-policy", 226}, {"proxy-status", 227}, {"fetch-dest", 228}, {"cache-etag", 229},
+        {"content-request-id", 230}, {"accept-date", 231}, {"access-control-control", 232},
+        {"content-modified-since", 233}, {"trace-id", 234}, {"length", 235}, {"cache-max-age", 236},
+        {"content-authenticate", 237}, {"if-charset", 238}, {"expose-headers", 239}, {"proxy-allow-methods", 240},
+        {"accept-allow-headers", 241}, {"access-control-allow-headers", 242}, {"retry-modified-since", 243},
+        {"cache-after", 244}, {"x-md5", 245}, {"accept-disposition", 246}, {"authorization", 247},
+        {"sec-date", 248}, {"cache-allow-methods", 249}, {"access-control-match", 250},
+        {"cache-allow-headers", 251}, {"content-control", 252}, {"access-control-te", 253}, {"sec-origin", 254},
+        {"if-websocket-version", 255},
+    };
+
+    constexpr auto fields = metaprogram::static_map<std::string_view, int, 256>(field_entries);
+
+    template <size_t... Is>
+    constexpr metaprogram::static_map<uint32_t, int, sizeof...(Is)> make_ids(metaprogram::index_sequence<Is...>) {
+        return metaprogram::make_static_map<uint32_t, int>({{static_cast<uint32_t>(Is * 2654435761u),
+                                                             static_cast<int>(Is)}...});
+    }
+
+    constexpr auto ids = make_ids(metaprogram::make_index_sequence<256>());
+
+    // a binary search of the entries sorted by key, the end on a miss
+    template <class Key>
+    struct sorted_array {
+        template <class Map>
+        explicit sorted_array(const Map& map) : entries(map.begin(), map.end()) {
+            std::sort(entries.begin(), entries.end());
+        }
+
+        const std::pair<Key, int>* find(const Key& key) const {
+            auto it = std::lower_bound(entries.begin(), entries.end(), key,
+                                       [](const std::pair<Key, int>& e, const Key& k) { return e.first < k; });
+            return it != entries.end() && it->first == key ? &*it : nullptr;
+        }
+
+        std::vector<std::pair<Key, int>> entries;
+    };
+
+    template <class Key, class StaticMap>
+    void lookups(bench::runner& r, const std::string& name, const StaticMap& map, const std::vector<Key>& queries) {
+        const std::unordered_map<Key, int> unordered(map.begin(), map.end());
+        const sorted_array<Key> sorted(map);
+
+        const std::string prefix = "lookup/" + name + "/";
+        r.run(prefix + "unordered_map", queries.size(), [&] {
+            int sum = 0;
+            for (const Key& k : queries) {
+                auto it = unordered.find(k);
+                sum += it != unordered.end() ? it->second : -1;
+            }
+            do_not_optimize(sum);
+        });
+        r.run(prefix + "sorted_array", queries.size(), [&] {
+            int sum = 0;
+            for (const Key& k : queries) {
+                auto e = sorted.find(k);
+                sum += e ? e->second : -1;
+            }
+            do_not_optimize(sum);
+        });
+        r.run(prefix + "static_map", queries.size(), [&] {
+            int sum = 0;
+            for (const Key& k : queries) {
+                auto it = map.find(k);
+                sum += it != map.end() ? it->second : -1;
+            }
+            do_not_optimize(sum);
+        });
+        r.compare(prefix + "static_map", prefix + "unordered_map");
+        r.compare(prefix + "static_map", prefix + "sorted_array");
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::runner r(bench::parse_options(argc, argv));
+    std::mt19937 rng(42);
+    const size_t count = 4096;
+
+    // the misses differ from a key in their last character
+    std::vector<std::string> hits(count);
+    std::vector<std::string> misses(count);
+    for (size_t i = 0; i < count; ++i) {
+        hits[i] = std::string(field_entries[rng() % 256].first);
+        misses[i] = hits[i];
+        misses[i].back() = '#';
+    }
+    const std::vector<std::string_view> hit_views(hits.begin(), hits.end());
+    const std::vector<std::string_view> miss_views(misses.begin(), misses.end());
+    lookups(r, "string/hit", fields, hit_views);
+    lookups(r, "string/miss", fields, miss_views);
+
+    std::vector<uint32_t> id_hits(count);
+    std::vector<uint32_t> id_misses(count);
+    for (size_t i = 0; i < count; ++i) {
+        id_hits[i] = static_cast<uint32_t>(rng() % 256) * 2654435761u;
+        id_misses[i] = id_hits[i] + 1;
+    }
+    lookups(r, "integer/hit", ids, id_hits);
+    lookups(r, "integer/miss", ids, id_misses);
+    return r.finish();
+}
@@ -0,0 +1,288 @@
+//
+//  algorithm.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef algorithm_h
+#define algorithm_h
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+
+NS_META_BEG
+
+/***************************** Bulk memory algorithms *********************
+copy_n, move_n, fill_n, uninitialized_copy, uninitialized_value_construct and
+destroy with the semantics of their std counterparts, plus uninitialized_relocate.
+The type traits select the implementation at compile time:
+1. pointers to trivially copyable types are copied with a single memmove/memcpy
+2. fill_n of a trivially copyable type is a memset when the value is a single
+    byte or all zero bytes
+3. value construction of arithmetic, enum and pointer types is a memset to zero
+4. destroy of trivially destructible types does nothing
+5. relocation of trivially relocatable types is a memcpy
+Anything else goes element by element.
+**************************************************************************/
+
+// unique_ptr with the default deleter is a single pointer on every ABI
+template <class T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : public true_type {};
+
+namespace detail {
+    // Implementation detail
+    // 1. In and Out are pointers to the same non-volatile trivially copyable
+    //      type, the source can be const
+    template <class In, class Out>
+    struct is_bitwise_copy : public false_type {};
+
+    template <class T, class U>
+    struct is_bitwise_copy<T*, U*> : public conjunction<
+        is_same<remove_const_t<T>, U>, is_same<remove_cv_t<U>, U>, is_trivially_copyable<U>> {};
+
+    template <class Out>
+    struct is_bitwise_fill : public false_type {};
+
+    template <class T>
+    struct is_bitwise_fill<T*> : public conjunction<is_same<remove_cv_t<T>, T>, is_trivially_copyable<T>> {};
+
+    // Implementation detail
+    // 1. The types whose value-initialized object is all zero bytes. Pointers to
+    //      member are not, the null member object pointer is -1 in the Itanium ABI
+    template <class Out>
+    struct is_zero_construct : public false_type {};
+
+    template <class T>
+    struct is_zero_construct<T*> : public bool_constant<is_same<remove_cv_t<T>, T>::value
+        && (type_category<T>::value & (category_arithmetic | category_enum | category_pointer
+            | category_null_pointer)) != 0> {};
+
+    template <class In, class Out>
+    struct is_bitwise_relocate : public false_type {};
+
+    template <class T>
+    struct is_bitwise_relocate<T*, T*> : public conjunction<is_same<remove_cv_t<T>, T>, is_trivially_relocatable<T>> {};
+
+    template <class It>
+    using iter_value_t = typename std::iterator_traits<It>::value_type;
+
+    template <class InputIt, class Size, class OutputIt>
+    OutputIt copy_n(InputIt first, Size count, OutputIt result, true_type) {
+        if (count > 0) {
+            std::memmove(result, first, static_cast<size_t>(count) * sizeof(*result));
+            result += count;
+        }
+        return result;
+    }
+
+    template <class InputIt, class Size, class OutputIt>
+    OutputIt copy_n(InputIt first, Size count, OutputIt result, false_type) {
+        for (; count > 0; --count, ++first, ++result) {
+            *result = *first;
+        }
+        return result;
+    }
+
+    // moving a trivially copyable type is copying it
+    template <class InputIt, class Size, class OutputIt>
+    OutputIt move_n(InputIt first, Size count, OutputIt result, true_type) {
+        return copy_n(first, count, result, true_type());
+    }
+
+    template <class InputIt, class Size, class OutputIt>
+    OutputIt move_n(InputIt first, Size count, OutputIt result, false_type) {
+        for (; count > 0; --count, ++first, ++result) {
+            *result = std::move(*first);
+        }
+        return result;
+    }
+
+    // true if every byte of value is the same, which is then stored in byte
+    template <class T>
+    bool single_byte(const T& value, unsigned char& byte) noexcept {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (size_t i = 1; i < sizeof(T); ++i) {
+            if (bytes[i] != bytes[0]) {
+                return false;
+            }
+        }
+        byte = bytes[0];
+        return true;
+    }
+
+    template <class OutputIt, class Size, class T>
+    OutputIt fill_n(OutputIt first, Size count, const T& value, false_type) {
+        for (; count > 0; --count, ++first) {
+            *first = value;
+        }
+        return first;
+    }
+
+    template <class OutputIt, class Size, class T>
+    OutputIt fill_n(OutputIt first, Size count, const T& value, true_type) {
+        using U = iter_value_t<OutputIt>;
+        if (count <= 0) {
+            return first;
+        }
+        const U v = value;
+        const OutputIt last = first + count;
+        unsigned char byte = 0;
+        if (single_byte(v, byte)) {
+            std::memset(first, byte, static_cast<size_t>(count) * sizeof(U));
+            return last;
+        }
+        // a loop to the end pointer is vectorized, a countdown is not
+        for (; first != last; ++first) {
+            *first = v;
+        }
+        return last;
+    }
+
+    template <class ForwardIt>
+    void destroy(ForwardIt, ForwardIt, true_type) noexcept {}
+
+    template <class ForwardIt>
+    void destroy(ForwardIt first, ForwardIt last, false_type) {
+        using T = iter_value_t<ForwardIt>;
+        for (; first != last; ++first) {
+            std::addressof(*first)->~T();
+        }
+    }
+
+    template <class InputIt, class ForwardIt>
+    ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first, true_type) {
+        const auto count = last - first;
+        if (count > 0) {
+            std::memcpy(d_first, first, static_cast<size_t>(count) * sizeof(*d_first));
+        }
+        return d_first + count;
+    }
+
+    // the constructed elements are destroyed if a constructor throws
+    template <class InputIt, class ForwardIt>
+    ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first, false_type) {
+        using T = iter_value_t<ForwardIt>;
+        ForwardIt current = d_first;
+        try {
+            for (; first != last; ++first, ++current) {
+                ::new (static_cast<void*>(std::addressof(*current))) T(*first);
+            }
+            return current;
+        } catch (...) {
+            destroy(d_first, current, bool_constant<is_trivially_destructible<T>::value>());
+            throw;
+        }
+    }
+
+    template <class ForwardIt>
+    void uninitialized_value_construct(ForwardIt first, ForwardIt last, true_type) {
+        if (first != last) {
+            std::memset(first, 0, static_cast<size_t>(last - first) * sizeof(*first));
+        }
+    }
+
+    template <class ForwardIt>
+    void uninitialized_value_construct(ForwardIt first, ForwardIt last, false_type) {
+        using T = iter_value_t<ForwardIt>;
+        ForwardIt current = first;
+        try {
+            for (; current != last; ++current) {
+                ::new (static_cast<void*>(std::addressof(*current))) T();
+            }
+        } catch (...) {
+            destroy(first, current, bool_constant<is_trivially_destructible<T>::value>());
+            throw;
+        }
+    }
+
+    template <class InputIt, class ForwardIt>
+    ForwardIt uninitialized_relocate(InputIt first, InputIt last, ForwardIt d_first, true_type) {
+        const auto count = last - first;
+        if (count > 0) {
+            std::memcpy(static_cast<void*>(d_first), static_cast<const void*>(first),
+                static_cast<size_t>(count) * sizeof(*d_first));
+        }
+        return d_first + count;
+    }
+
+    // Implementation detail
+    // 1. The elements are moved, or copied when the move may throw, and the
+    //      originals are destroyed only when all of them are constructed, so
+    //      the input is intact if a constructor throws
+    template <class InputIt, class ForwardIt>
+    ForwardIt uninitialized_relocate(InputIt first, InputIt last, ForwardIt d_first, false_type) {
+        using T = iter_value_t<ForwardIt>;
+        ForwardIt current = d_first;
+        try {
+            for (InputIt it = first; it != last; ++it, ++current) {
+                ::new (static_cast<void*>(std::addressof(*current))) T(std::move_if_noexcept(*it));
+            }
+        } catch (...) {
+            destroy(d_first, current, bool_constant<is_trivially_destructible<T>::value>());
+            throw;
+        }
+        destroy(first, last, bool_constant<is_trivially_destructible<iter_value_t<InputIt>>::value>());
+        return current;
+    }
+}
+
+// Copies count elements from first to result, returns the end of the output.
+template <class InputIt, class Size, class OutputIt>
+OutputIt copy_n(InputIt first, Size count, OutputIt result) {
+    return detail::copy_n(first, count, result, detail::is_bitwise_copy<InputIt, OutputIt>());
+}
+
+// Moves count elements from first to result, returns the end of the output.
+template <class InputIt, class Size, class OutputIt>
+OutputIt move_n(InputIt first, Size count, OutputIt result) {
+    return detail::move_n(first, count, result, detail::is_bitwise_copy<InputIt, OutputIt>());
+}
+
+// Assigns value to count elements from first, returns the end of the output.
+template <class OutputIt, class Size, class T>
+OutputIt fill_n(OutputIt first, Size count, const T& value) {
+    return detail::fill_n(first, count, value, detail::is_bitwise_fill<OutputIt>());
+}
+
+// Copy-constructs the elements of [first, last) into the uninitialized storage
+// at d_first, returns the end of the output.
+template <class InputIt, class ForwardIt>
+ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first) {
+    return detail::uninitialized_copy(first, last, d_first, detail::is_bitwise_copy<InputIt, ForwardIt>());
+}
+
+// Value-initializes the objects in the uninitialized storage [first, last).
+template <class ForwardIt>
+void uninitialized_value_construct(ForwardIt first, ForwardIt last) {
+    detail::uninitialized_value_construct(first, last, detail::is_zero_construct<ForwardIt>());
+}
+
+// Moves the objects of [first, last) into the uninitialized storage at d_first
+// and destroys the originals, so [first, last) is uninitialized storage afterwards.
+// Returns the end of the output. The ranges must not overlap.
+template <class InputIt, class ForwardIt>
+ForwardIt uninitialized_relocate(InputIt first, InputIt last, ForwardIt d_first) {
+    return detail::uninitialized_relocate(first, last, d_first, detail::is_bitwise_relocate<InputIt, ForwardIt>());
+}
+
+// Destroys the objects in [first, last).
+template <class ForwardIt>
+void destroy(ForwardIt first, ForwardIt last) {
+    detail::destroy(first, last, bool_constant<is_trivially_destructible<detail::iter_value_t<ForwardIt>>::value>());
+}
+
+NS_META_END
+
+#endif /* algorithm_h */
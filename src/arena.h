@@ -0,0 +1,316 @@
+//
+//  arena.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef arena_h
+#define arena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_type.h"
+#include "algorithm.h"
+
+NS_META_BEG
+
+/***************************** Arena **************************************
+A monotonic arena: allocation bumps a pointer through blocks taken from the
+heap, and nothing is freed until the arena is reset or destroyed.
+make<T> and make_array<T> construct objects in it. A T whose destructor
+does something is linked into an intrusive destructor list, which reset
+walks in reverse order of construction; a trivially destructible T is only
+bumped, so releasing a region of such objects costs the same whatever
+their number.
+Example:
+    arena a;
+    Header* header = a.make<Header>(42);          // bumped
+    std::string* name = a.make<std::string>("x"); // bumped and registered
+    std::vector<int, arena_allocator<int>> v(arena_allocator<int>(a));
+    a.reset();                                    // runs ~string, keeps a block
+Implementation Note:
+1. A mark() and rewind(marker) pair releases what was made after the mark,
+    arena_scope does it for the thread's arena, see thread_arena
+2. An arena is not thread safe, thread_arena gives every thread its own
+**************************************************************************/
+
+class arena {
+public:
+    // The state of the arena at a point, rewind releases what was made after it.
+    struct marker {
+        void* block;
+        char* current;
+        void* destructors;
+    };
+
+    static constexpr size_t default_block_size = 4096;
+
+    explicit arena(size_t block_size = default_block_size) noexcept
+        : blocks_(nullptr), current_(nullptr), end_(nullptr), destructors_(nullptr), spare_(nullptr),
+          block_size_(block_size), next_block_size_(block_size), initial_(nullptr), initial_size_(0) {}
+
+    // starts in buffer, which the caller owns and must outlive the arena
+    arena(void* buffer, size_t size, size_t block_size = default_block_size) noexcept
+        : blocks_(nullptr), current_(static_cast<char*>(buffer)), end_(static_cast<char*>(buffer) + size),
+          destructors_(nullptr), spare_(nullptr), block_size_(block_size), next_block_size_(block_size),
+          initial_(static_cast<char*>(buffer)),
+          initial_size_(size) {}
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() {
+        release();
+        ::operator delete(spare_);
+    }
+
+    // size bytes aligned to alignment, a power of two
+    META_ALWAYS_INLINE void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        const uintptr_t address = (reinterpret_cast<uintptr_t>(current_) + alignment - 1) & ~(alignment - 1);
+        const uintptr_t end = reinterpret_cast<uintptr_t>(end_);
+        if (address > end || size > end - address || current_ == nullptr) {
+            return allocate_slow(size, alignment);
+        }
+        current_ = reinterpret_cast<char*>(address + size);
+        return reinterpret_cast<void*>(address);
+    }
+
+    template <class T, class... Args>
+    T* make(Args&&... args) {
+        void* p = allocate(sizeof(T), alignof(T));
+        T* object = ::new (p) T(std::forward<Args>(args)...);
+        register_destructor(object, 1, is_trivially_destructible<T>());
+        return object;
+    }
+
+    // count value-initialized T, throws std::bad_array_new_length if their
+    // size doesn't fit in size_t
+    template <class T>
+    T* make_array(size_t count) {
+        if (count > size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        T* first = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        metaprogram::uninitialized_value_construct(first, first + count);
+        register_destructor(first, count, is_trivially_destructible<T>());
+        return first;
+    }
+
+    marker mark() const noexcept {
+        return marker{blocks_, current_, destructors_};
+    }
+
+    // destroys what was made after m, in reverse order, and frees the blocks
+    // taken after it but the largest, which is kept for the next block
+    void rewind(const marker& m) noexcept {
+        run_destructors(static_cast<destructor_node*>(m.destructors));
+        while (blocks_ != m.block) {
+            block_header* block = blocks_;
+            blocks_ = block->next;
+            if (spare_ == nullptr || spare_->size < block->size) {
+                std::swap(spare_, block);
+            }
+            ::operator delete(block);
+        }
+        current_ = m.current;
+        end_ = blocks_ ? blocks_->end() : initial_ ? initial_ + initial_size_ : nullptr;
+        next_block_size_ = blocks_ ? blocks_->size * 2 : block_size_;
+    }
+
+    // destroys everything and keeps the last block for the next allocations,
+    // so a reset arena in a loop doesn't go back to the heap
+    void reset() noexcept {
+        run_destructors(nullptr);
+        if (blocks_ == nullptr) {
+            current_ = initial_;
+            return;
+        }
+        while (blocks_->next) {
+            block_header* block = blocks_->next;
+            blocks_->next = block->next;
+            ::operator delete(block);
+        }
+        current_ = blocks_->begin();
+        end_ = blocks_->end();
+    }
+
+    // destroys everything and frees every block
+    void release() noexcept {
+        rewind(marker{nullptr, initial_, nullptr});
+        ::operator delete(spare_);
+        spare_ = nullptr;
+    }
+
+    // the bytes left in the current block
+    size_t available() const noexcept {
+        return static_cast<size_t>(end_ - current_);
+    }
+
+private:
+    // Implementation detail
+    // 1. The header is padded to max_align_t, so the first allocation of a
+    //      block needs no adjustment
+    struct alignas(std::max_align_t) block_header {
+        block_header* next;
+        size_t size;
+
+        char* begin() noexcept { return reinterpret_cast<char*>(this + 1); }
+        char* end() noexcept { return begin() + size; }
+    };
+
+    struct destructor_node {
+        void (*destroy)(void*, size_t);
+        void* object;
+        size_t count;
+        destructor_node* next;
+    };
+
+    template <class T>
+    static void destroy_objects(void* object, size_t count) {
+        T* first = static_cast<T*>(object);
+        metaprogram::destroy(first, first + count);
+    }
+
+    template <class T>
+    void register_destructor(T*, size_t, true_type) noexcept {}
+
+    // the node is bumped after the object, if that throws the object is destroyed
+    template <class T>
+    void register_destructor(T* object, size_t count, false_type) {
+        void* p = nullptr;
+        try {
+            p = allocate(sizeof(destructor_node), alignof(destructor_node));
+        } catch (...) {
+            metaprogram::destroy(object, object + count);
+            throw;
+        }
+        destructors_ = ::new (p) destructor_node{&destroy_objects<T>, object, count, destructors_};
+    }
+
+    void run_destructors(destructor_node* until) noexcept {
+        while (destructors_ != until) {
+            destructor_node* node = destructors_;
+            destructors_ = node->next;
+            node->destroy(node->object, node->count);
+        }
+    }
+
+    // a new block, the spare one if size fits in it, else twice the size of the
+    // last one or large enough for size. Throws std::bad_alloc if the block
+    // size doesn't fit in size_t
+    void* allocate_slow(size_t size, size_t alignment) {
+        const size_t max_block_size = size_t(-1) - sizeof(block_header);
+        if (size > max_block_size - alignment) {
+            throw std::bad_alloc();
+        }
+        block_header* block = spare_;
+        if (block != nullptr && size + alignment <= block->size) {
+            spare_ = nullptr;
+        } else {
+            size_t block_size = next_block_size_;
+            while (block_size < size + alignment) {
+                if (block_size > max_block_size / 2) {
+                    throw std::bad_alloc();
+                }
+                block_size *= 2;
+            }
+            block = static_cast<block_header*>(::operator new(sizeof(block_header) + block_size));
+            block->size = block_size;
+        }
+        block->next = blocks_;
+        blocks_ = block;
+        next_block_size_ = block->size * 2;
+        current_ = block->begin();
+        end_ = block->end();
+        return allocate(size, alignment);
+    }
+
+    block_header* blocks_;
+    char* current_;
+    char* end_;
+    destructor_node* destructors_;
+    block_header* spare_;
+    size_t block_size_;
+    size_t next_block_size_;
+    char* initial_;
+    size_t initial_size_;
+};
+
+// The arena of the calling thread, created on first use and destroyed with the thread.
+inline arena& thread_arena() {
+    static thread_local arena a;
+    return a;
+}
+
+// Releases what the scope made in an arena, the thread's arena by default, when
+// the scope ends.
+// Example:
+//      void handle(const request& r) {
+//          arena_scope scope;
+//          auto* parsed = thread_arena().make<parsed_request>(r);
+//      }
+class arena_scope {
+public:
+    explicit arena_scope(arena& a = thread_arena()) noexcept : arena_(a), marker_(a.mark()) {}
+
+    arena_scope(const arena_scope&) = delete;
+    arena_scope& operator=(const arena_scope&) = delete;
+
+    ~arena_scope() {
+        arena_.rewind(marker_);
+    }
+
+private:
+    arena& arena_;
+    arena::marker marker_;
+};
+
+// An allocator which takes its memory from an arena, deallocate does nothing, so
+// standard containers can be used in an arena.
+template <class T>
+class arena_allocator {
+public:
+    using value_type = T;
+
+    explicit arena_allocator(arena& a) noexcept : arena_(&a) {}
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other) noexcept : arena_(other.get_arena()) {}
+
+    T* allocate(size_t count) {
+        if (count > size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    arena* get_arena() const noexcept {
+        return arena_;
+    }
+
+    template <class U>
+    friend bool operator==(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept {
+        return lhs.get_arena() == rhs.get_arena();
+    }
+
+    template <class U>
+    friend bool operator!=(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept {
+        return lhs.get_arena() != rhs.get_arena();
+    }
+
+private:
+    arena* arena_;
+};
+
+NS_META_END
+
+#endif /* arena_h */
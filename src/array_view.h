@@ -0,0 +1,47 @@
+//
+//  array_view.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef array_view_h
+#define array_view_h
+
+#include <cstddef>
+
+#include "config.h"
+#include "type_traits_cvrp.h"
+
+NS_META_BEG
+
+// A pointer and size viewing an array, what buffer_reader::read_view and the
+// columns of soa_vector are.
+template <class T>
+class array_view {
+public:
+    using value_type = remove_cv_t<T>;
+    using size_type = size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr array_view() noexcept : data_(nullptr), size_(0) {}
+    constexpr array_view(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+    constexpr T& operator[](size_t pos) const noexcept { return data_[pos]; }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+NS_META_END
+
+#endif /* array_view_h */
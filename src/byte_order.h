@@ -0,0 +1,222 @@
+//
+//  byte_order.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef byte_order_h
+#define byte_order_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_type.h"
+#include "kernels.h"
+
+NS_META_BEG
+
+/***************************** Byte order *********************************
+byteswap reverses the bytes of an integral or floating point value, to_big,
+to_little, from_big and from_little convert between the host byte order and
+a fixed one, they return the value unchanged when the orders match. The _n
+versions convert arrays:
+1. they run as a kernel of kernels.h, so the swap is a byte shuffle of a
+    whole vector register (pshufb with SSSE3, vpshufb with AVX2 and AVX-512)
+    selected with cpuid
+2. when the orders match they are a copy, or nothing at all in place
+Any other type is rejected at compile time.
+Example:
+    uint32_t length = from_big(header.length);
+    from_big_n(samples, count, samples);
+**************************************************************************/
+
+// The byte order of scalar types, native is the one of the host.
+enum class endian {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && defined(__ORDER_BIG_ENDIAN__)
+    little = __ORDER_LITTLE_ENDIAN__,
+    big = __ORDER_BIG_ENDIAN__,
+    native = __BYTE_ORDER__,
+#else
+    // msvc only targets little endian machines
+    little,
+    big,
+    native = little,
+#endif
+};
+
+namespace detail {
+    template <size_t Size>
+    struct unsigned_of_size;
+
+    template <> struct unsigned_of_size<1> : public type_identity<uint8_t> {};
+    template <> struct unsigned_of_size<2> : public type_identity<uint16_t> {};
+    template <> struct unsigned_of_size<4> : public type_identity<uint32_t> {};
+    template <> struct unsigned_of_size<8> : public type_identity<uint64_t> {};
+
+    // Implementation detail
+    // 1. The builtins are constexpr, the shifts are the fallback and compilers
+    //      recognize them as a bswap instruction too
+    constexpr uint8_t bswap(uint8_t value) noexcept {
+        return value;
+    }
+
+#if META_HAS_BUILTIN(__builtin_bswap16) && META_HAS_BUILTIN(__builtin_bswap32) && META_HAS_BUILTIN(__builtin_bswap64)
+    constexpr uint16_t bswap(uint16_t value) noexcept {
+        return __builtin_bswap16(value);
+    }
+
+    constexpr uint32_t bswap(uint32_t value) noexcept {
+        return __builtin_bswap32(value);
+    }
+
+    constexpr uint64_t bswap(uint64_t value) noexcept {
+        return __builtin_bswap64(value);
+    }
+#else
+    constexpr uint16_t bswap(uint16_t value) noexcept {
+        return static_cast<uint16_t>((value << 8) | (value >> 8));
+    }
+
+    constexpr uint32_t bswap(uint32_t value) noexcept {
+        return (value << 24) | ((value << 8) & 0x00ff0000u) | ((value >> 8) & 0x0000ff00u) | (value >> 24);
+    }
+
+    constexpr uint64_t bswap(uint64_t value) noexcept {
+        return (static_cast<uint64_t>(bswap(static_cast<uint32_t>(value))) << 32) |
+            bswap(static_cast<uint32_t>(value >> 32));
+    }
+#endif
+
+    template <class T>
+    struct is_byte_swappable : public bool_constant<(is_integral<T>::value || is_floating_point<T>::value) &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+    template <class T>
+    constexpr T byteswap_value(T value, true_type) noexcept {
+        return static_cast<T>(bswap(static_cast<typename unsigned_of_size<sizeof(T)>::type>(value)));
+    }
+
+    template <class T>
+    T byteswap_value(T value, false_type) noexcept {
+        typename unsigned_of_size<sizeof(T)>::type bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        bits = bswap(bits);
+        std::memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+
+    // Implementation detail
+    // 1. The elements are copied to a block of unsigned integers of the same
+    //      size, the only type the swap is defined on, so floating point
+    //      arrays are not read through an integer pointer
+    // 2. A step is one register of L lanes, there is nothing to accumulate and
+    //      a block of several registers is spilled to the stack
+    struct byteswap_kernel {
+        template <size_t L, size_t K, class T>
+        static META_ALWAYS_INLINE void run(const T* in, size_t n, T* out) {
+            using U = typename unsigned_of_size<sizeof(T)>::type;
+            size_t i = 0;
+            for (; i + L <= n; i += L) {
+                U block[L];
+                std::memcpy(block, in + i, sizeof(block));
+                for (size_t j = 0; j < L; ++j) {
+                    block[j] = bswap(block[j]);
+                }
+                std::memcpy(out + i, block, sizeof(block));
+            }
+            for (; i < n; ++i) {
+                U bits;
+                std::memcpy(&bits, in + i, sizeof(U));
+                bits = bswap(bits);
+                std::memcpy(out + i, &bits, sizeof(U));
+            }
+        }
+    };
+
+    template <class T>
+    void byteswap_n(const T* in, size_t n, T* out, true_type) {
+        dispatch_kernel<byteswap_kernel, T>(is_vector_kernel<T>(), in, n, out);
+    }
+
+    // the orders match, or the bytes are single
+    template <class T>
+    void byteswap_n(const T* in, size_t n, T* out, false_type) {
+        if (in != out && n != 0) {
+            std::memcpy(out, in, n * sizeof(T));
+        }
+    }
+}
+
+// Returns value with its bytes reversed, it is constexpr for the integral types.
+template <class T>
+constexpr T byteswap(T value) noexcept {
+    static_assert(detail::is_byte_swappable<T>::value, "byteswap requires an integral or floating point type");
+    return detail::byteswap_value(value, is_integral<T>());
+}
+
+// Converts value from the host byte order to big endian, and back.
+template <class T>
+constexpr T to_big(T value) noexcept {
+    static_assert(detail::is_byte_swappable<T>::value, "to_big requires an integral or floating point type");
+    return endian::native == endian::big ? value : detail::byteswap_value(value, is_integral<T>());
+}
+
+template <class T>
+constexpr T from_big(T value) noexcept {
+    return to_big(value);
+}
+
+// Converts value from the host byte order to little endian, and back.
+template <class T>
+constexpr T to_little(T value) noexcept {
+    static_assert(detail::is_byte_swappable<T>::value, "to_little requires an integral or floating point type");
+    return endian::native == endian::little ? value : detail::byteswap_value(value, is_integral<T>());
+}
+
+template <class T>
+constexpr T from_little(T value) noexcept {
+    return to_little(value);
+}
+
+// out[i] is byteswap(in[i]) for the n elements, in and out are the same array or
+// don't overlap.
+template <class T>
+void byteswap_n(const T* in, size_t n, T* out) {
+    static_assert(detail::is_byte_swappable<T>::value, "byteswap_n requires an integral or floating point type");
+    detail::byteswap_n(in, n, out, bool_constant<(sizeof(T) > 1)>());
+}
+
+// out[i] is to_big(in[i]) for the n elements, in and out are the same array or
+// don't overlap.
+template <class T>
+void to_big_n(const T* in, size_t n, T* out) {
+    static_assert(detail::is_byte_swappable<T>::value, "to_big_n requires an integral or floating point type");
+    detail::byteswap_n(in, n, out, bool_constant<endian::native != endian::big && (sizeof(T) > 1)>());
+}
+
+template <class T>
+void from_big_n(const T* in, size_t n, T* out) {
+    to_big_n(in, n, out);
+}
+
+// out[i] is to_little(in[i]) for the n elements, in and out are the same array or
+// don't overlap.
+template <class T>
+void to_little_n(const T* in, size_t n, T* out) {
+    static_assert(detail::is_byte_swappable<T>::value, "to_little_n requires an integral or floating point type");
+    detail::byteswap_n(in, n, out, bool_constant<endian::native != endian::little && (sizeof(T) > 1)>());
+}
+
+template <class T>
+void from_little_n(const T* in, size_t n, T* out) {
+    to_little_n(in, n, out);
+}
+
+NS_META_END
+
+#endif /* byte_order_h */
@@ -1,3 +1,166 @@
+//
+//  config.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2020/03/27.
+//  Copyright © 2020 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef config_h
+#define config_h
+
 #define NS_META_BEG namespace metaprogram {
 #define NS_META_END }
-#define USE_META using namespace metaprogram;
\ No newline at end of file
+#define USE_META using namespace metaprogram;
+
+// The _v variable templates are inline variables since c++17, before that
+// they are constexpr variables with internal linkage
+#if defined(__cpp_inline_variables)
+#define META_INLINE_VAR inline
+#else
+#define META_INLINE_VAR
+#endif
+
+// The signature of the enclosing function, with the template arguments spelled out
+#if defined(_MSC_VER) && !defined(__clang__)
+#define META_PRETTY_FUNCTION __FUNCSIG__
+#else
+#define META_PRETTY_FUNCTION __PRETTY_FUNCTION__
+#endif
+
+// Code generation
+// META_ALWAYS_INLINE forces inlining, so an inlined body is compiled for the
+// instruction set of its caller. META_TARGET(isa) compiles a function for an
+// instruction set above the one of the build, it is only defined by gcc and clang
+// on x86, where kernels.h selects those functions with cpuid at runtime.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define META_ALWAYS_INLINE __forceinline
+#else
+#define META_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define META_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Instrumentation
+// Define META_INSTRUMENT to 1 to put a probe in the traits the others are built
+// from (is_same, type_category, conjunction, ...). Every instantiation of one of
+// them then emits a deprecation warning with the chain of instantiations which
+// required it, bench/compile/instantiation_report.py turns those into counts per
+// trait and per caller. It is for measuring only, the warnings slow the build down.
+#ifndef META_INSTRUMENT
+#define META_INSTRUMENT 0
+#endif
+
+#if META_INSTRUMENT
+#define META_PROBE(self) using meta_probe_ = decltype(::metaprogram::detail::instantiation_probe<self>())
+#else
+#define META_PROBE(self) static_assert(true, "")
+#endif
+
+// Compiler intrinsics
+// The trait headers route through the compiler builtins (__is_same, __is_enum, ...)
+// when they are available and fall back to the portable templates when they are not.
+// Define META_USE_BUILTINS to 0 before including any header to force the portable
+// templates everywhere.
+// Every detected builtin gets a META_BUILTIN_XXX(...) macro which expands to it, so
+// the trait headers only check for the macro and don't care about the spelling.
+#ifndef META_USE_BUILTINS
+#define META_USE_BUILTINS 1
+#endif
+
+#if defined(__has_builtin)
+#define META_HAS_BUILTIN(x) __has_builtin(x)
+#else
+#define META_HAS_BUILTIN(x) 0
+#endif
+
+#if META_USE_BUILTINS
+
+// msvc doesn't have __has_builtin, but the class category builtins exist since vs2005
+#if defined(_MSC_VER) && !defined(__clang__)
+#define META_BUILTIN_IS_ENUM(T) __is_enum(T)
+#define META_BUILTIN_IS_CLASS(T) __is_class(T)
+#define META_BUILTIN_IS_UNION(T) __is_union(T)
+#define META_BUILTIN_IS_BASE_OF(B, D) __is_base_of(B, D)
+#define META_BUILTIN_IS_TRIVIALLY_COPYABLE(T) __is_trivially_copyable(T)
+#define META_BUILTIN_IS_ABSTRACT(T) __is_abstract(T)
+#define META_BUILTIN_HAS_UNIQUE_OBJECT_REPRESENTATIONS(T) __has_unique_object_representations(T)
+#define META_BUILTIN_MAKE_INTEGER_SEQ(S, T, N) __make_integer_seq<S, T, N>
+#endif
+
+#if META_HAS_BUILTIN(__is_same)
+#define META_BUILTIN_IS_SAME(T, U) __is_same(T, U)
+#endif
+
+#if META_HAS_BUILTIN(__is_enum)
+#define META_BUILTIN_IS_ENUM(T) __is_enum(T)
+#endif
+
+#if META_HAS_BUILTIN(__is_class)
+#define META_BUILTIN_IS_CLASS(T) __is_class(T)
+#endif
+
+#if META_HAS_BUILTIN(__is_union)
+#define META_BUILTIN_IS_UNION(T) __is_union(T)
+#endif
+
+#if META_HAS_BUILTIN(__is_function)
+#define META_BUILTIN_IS_FUNCTION(T) __is_function(T)
+#endif
+
+// clang spells it __remove_reference_t, gcc __remove_reference
+#if META_HAS_BUILTIN(__remove_reference_t)
+#define META_BUILTIN_REMOVE_REFERENCE(T) __remove_reference_t(T)
+#elif META_HAS_BUILTIN(__remove_reference)
+#define META_BUILTIN_REMOVE_REFERENCE(T) __remove_reference(T)
+#endif
+
+#if META_HAS_BUILTIN(__remove_cvref)
+#define META_BUILTIN_REMOVE_CVREF(T) __remove_cvref(T)
+#endif
+
+#if META_HAS_BUILTIN(__is_base_of)
+#define META_BUILTIN_IS_BASE_OF(B, D) __is_base_of(B, D)
+#endif
+
+#if META_HAS_BUILTIN(__is_trivially_copyable)
+#define META_BUILTIN_IS_TRIVIALLY_COPYABLE(T) __is_trivially_copyable(T)
+#endif
+
+#if META_HAS_BUILTIN(__is_trivially_destructible)
+#define META_BUILTIN_IS_TRIVIALLY_DESTRUCTIBLE(T) __is_trivially_destructible(T)
+#endif
+
+#if META_HAS_BUILTIN(__is_abstract)
+#define META_BUILTIN_IS_ABSTRACT(T) __is_abstract(T)
+#endif
+
+#if META_HAS_BUILTIN(__is_aggregate)
+#define META_BUILTIN_IS_AGGREGATE(T) __is_aggregate(T)
+#endif
+
+#if META_HAS_BUILTIN(__has_unique_object_representations)
+#define META_BUILTIN_HAS_UNIQUE_OBJECT_REPRESENTATIONS(T) __has_unique_object_representations(T)
+#endif
+
+#if META_HAS_BUILTIN(__add_pointer)
+#define META_BUILTIN_ADD_POINTER(T) __add_pointer(T)
+#endif
+
+// the pack builtins take template arguments, so the macros are variadic
+#if META_HAS_BUILTIN(__type_pack_element)
+#define META_BUILTIN_TYPE_PACK_ELEMENT(I, ...) __type_pack_element<I, __VA_ARGS__>
+#endif
+
+// clang and msvc make the whole sequence type, gcc expands a pack of 0, ..., N - 1
+#if META_HAS_BUILTIN(__make_integer_seq)
+#define META_BUILTIN_MAKE_INTEGER_SEQ(S, T, N) __make_integer_seq<S, T, N>
+#elif META_HAS_BUILTIN(__integer_pack)
+#define META_BUILTIN_INTEGER_PACK(N) __integer_pack(N)
+#endif
+
+#endif // META_USE_BUILTINS
+
+#endif /* config_h */
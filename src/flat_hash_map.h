@@ -0,0 +1,819 @@
+//
+//  flat_hash_map.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef flat_hash_map_h
+#define flat_hash_map_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+#include "algorithm.h"
+#include "hash.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define META_FLAT_HASH_MAP_SSE2
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+NS_META_BEG
+
+/***************************** Flat hash map ******************************
+flat_hash_map<Key, T, Hash, KeyEqual, Allocator> is an open-addressing hash map
+in the layout of the abseil Swiss table:
+1. every slot has a control byte: empty, deleted, or the low 7 bits of the
+    hash (H2) of the key it holds. A lookup starts at the slot given by the
+    other bits (H1) and reads 16 control bytes at a time, one SSE2 compare
+    finds the slots whose H2 matches, only their keys are compared. An empty
+    byte in the group ends the probe
+2. the storage is picked from the entry type, see flat_hash_map_uses_nodes:
+    entries up to 64 bytes which relocate without throwing are in the slot
+    array, larger ones in a node each and the slots hold the pointers
+3. growth relocates the entries to their new slots, that is a memcpy when
+    is_trivially_relocatable<value_type> holds (trivially copyable entries,
+    the node pointers) and a move and a destruction otherwise. erase destroys
+    the entry in place, nothing for a trivially destructible one, and marks
+    the slot, the other entries don't move
+4. when Hash and KeyEqual both have an is_transparent member, find, count,
+    contains, at and erase take any key type they accept. metaprogram::hash
+    of a range is transparent, so a std::string key is found by a string_view
+Example:
+    flat_hash_map<std::string, int, hash<std::string>, std::equal_to<>> ids;
+    ids["alpha"] = 1;
+    auto it = ids.find(std::string_view("alpha"));      // no std::string built
+Implementation Note:
+1. The capacity is 2^k - 1 slots, at least 15, and at most 7/8 of them are
+    used. The control bytes are one per slot, a sentinel which stops the
+    iterators, and a copy of the first 15 so a group read at any slot doesn't
+    wrap. The slots and the control bytes are one allocation
+2. An insert which grows the table invalidates the iterators and, for entries
+    in the slot array, the references. Node entries stay where they are
+3. The hash function must not throw, it is called while the entries move
+4. A table full of deleted slots is rehashed at the same capacity
+5. The allocator, rebound to the slot type and to the node entries, only
+    provides the memory. It moves with the entries on move assignment and
+    swap, and copy assignment takes a copy of the other's
+**************************************************************************/
+
+// Checks whether flat_hash_map stores entries of type T in a node each instead of
+// in its slot array: T is larger than 64 bytes, or it is not trivially relocatable
+// and its move may throw. Specialize it to choose.
+template <class T>
+struct flat_hash_map_uses_nodes : public bool_constant<(sizeof(T) > 64) ||
+    !(is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)> {};
+
+namespace detail {
+    using ctrl_t = int8_t;
+
+    constexpr ctrl_t ctrl_empty = -128;
+    constexpr ctrl_t ctrl_deleted = -2;
+    constexpr ctrl_t ctrl_sentinel = -1;
+    constexpr size_t group_width = 16;
+
+    // the lowest set bit of a group mask, which isn't 0
+    inline unsigned countr_zero16(uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    // the zero bits above the highest set bit of a group mask, which isn't 0
+    inline unsigned countl_zero16(uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse(&index, mask);
+        return 15 - static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_clz(mask)) - 16;
+#endif
+    }
+
+    // Implementation detail
+    // 1. 16 control bytes, the matches are masks with bit i for byte i. Without
+    //      SSE2 the bytes are compared in a loop, which the compiler may vectorize
+    struct probe_group {
+#if defined(META_FLAT_HASH_MAP_SSE2)
+        explicit probe_group(const ctrl_t* p) noexcept
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        uint32_t match(ctrl_t h2) const noexcept {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+        }
+
+        uint32_t match_empty_or_deleted() const noexcept {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl)));
+        }
+
+        __m128i ctrl;
+#else
+        explicit probe_group(const ctrl_t* p) noexcept {
+            std::memcpy(ctrl, p, group_width);
+        }
+
+        uint32_t match(ctrl_t h2) const noexcept {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < group_width; ++i) {
+                mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+            }
+            return mask;
+        }
+
+        uint32_t match_empty_or_deleted() const noexcept {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < group_width; ++i) {
+                mask |= static_cast<uint32_t>(ctrl[i] < ctrl_sentinel) << i;
+            }
+            return mask;
+        }
+
+        ctrl_t ctrl[group_width];
+#endif
+
+        uint32_t match_empty() const noexcept {
+            return match(ctrl_empty);
+        }
+    };
+
+    // the control bytes of a table without slots, a lookup stops at the first
+    // group and begin() is end()
+    inline ctrl_t* empty_ctrl() noexcept {
+        alignas(16) static const ctrl_t group[group_width] = {
+            ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+            ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+        };
+        return const_cast<ctrl_t*>(group);
+    }
+
+    // how an entry is kept in a slot, in place or in a node
+    template <class V, bool = flat_hash_map_uses_nodes<V>::value>
+    struct flat_slot_policy {
+        using slot_type = V;
+
+        static V& value(slot_type& slot) noexcept { return slot; }
+        static const V& value(const slot_type& slot) noexcept { return slot; }
+
+        template <class Alloc, class... Args>
+        static void construct(Alloc&, slot_type* slot, Args&&... args) {
+            ::new (static_cast<void*>(slot)) V(std::forward<Args>(args)...);
+        }
+
+        template <class Alloc>
+        static void destroy(Alloc&, slot_type* slot) noexcept {
+            metaprogram::destroy(slot, slot + 1);
+        }
+    };
+
+    template <class V>
+    struct flat_slot_policy<V, true> {
+        using slot_type = V*;
+
+        static V& value(slot_type slot) noexcept { return *slot; }
+
+        template <class Alloc>
+        using node_traits = typename std::allocator_traits<Alloc>::template rebind_traits<V>;
+
+        template <class Alloc, class... Args>
+        static void construct(Alloc& alloc, slot_type* slot, Args&&... args) {
+            typename node_traits<Alloc>::allocator_type allocator(alloc);
+            V* node = node_traits<Alloc>::allocate(allocator, 1);
+            try {
+                ::new (static_cast<void*>(node)) V(std::forward<Args>(args)...);
+            } catch (...) {
+                node_traits<Alloc>::deallocate(allocator, node, 1);
+                throw;
+            }
+            *slot = node;
+        }
+
+        template <class Alloc>
+        static void destroy(Alloc& alloc, slot_type* slot) noexcept {
+            typename node_traits<Alloc>::allocator_type allocator(alloc);
+            metaprogram::destroy(*slot, *slot + 1);
+            node_traits<Alloc>::deallocate(allocator, *slot, 1);
+        }
+    };
+
+    template <class T, class = void>
+    struct is_transparent : public false_type {};
+
+    template <class T>
+    struct is_transparent<T, decltype((void)std::declval<typename T::is_transparent*>())> : public true_type {};
+
+    // the type a lookup takes, K is deduced only when the lookup is heterogeneous
+    template <bool Transparent>
+    struct key_arg {
+        template <class K, class Key>
+        using type = Key;
+    };
+
+    template <>
+    struct key_arg<true> {
+        template <class K, class Key>
+        using type = K;
+    };
+}
+
+template <class Key, class T, class Hash = hash<Key>, class KeyEqual = std::equal_to<Key>,
+    class Allocator = std::allocator<std::pair<const Key, T>>>
+class flat_hash_map {
+    using policy = detail::flat_slot_policy<std::pair<const Key, T>>;
+    using slot_type = typename policy::slot_type;
+    using slot_traits = typename std::allocator_traits<Allocator>::template rebind_traits<slot_type>;
+    using ctrl_t = detail::ctrl_t;
+
+    template <class K>
+    using key_arg = typename detail::key_arg<detail::is_transparent<Hash>::value &&
+        detail::is_transparent<KeyEqual>::value>::template type<K, Key>;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename flat_hash_map::value_type;
+        using difference_type = ptrdiff_t;
+        using reference = conditional_t<Const, const value_type&, value_type&>;
+        using pointer = conditional_t<Const, const value_type*, value_type*>;
+
+        basic_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+
+        // iterator converts to const_iterator
+        template <bool C, class = enable_if_t<Const && !C>>
+        basic_iterator(const basic_iterator<C>& other) noexcept : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+        reference operator*() const noexcept { return policy::value(*slot_); }
+        pointer operator->() const noexcept { return std::addressof(policy::value(*slot_)); }
+
+        basic_iterator& operator++() noexcept {
+            ++ctrl_;
+            ++slot_;
+            skip_empty_or_deleted();
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            basic_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.ctrl_ == rhs.ctrl_;
+        }
+
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.ctrl_ != rhs.ctrl_;
+        }
+
+    private:
+        friend class flat_hash_map;
+
+        basic_iterator(ctrl_t* ctrl, slot_type* slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+        // the sentinel after the last slot stops it
+        void skip_empty_or_deleted() noexcept {
+            while (*ctrl_ < detail::ctrl_sentinel) {
+                const uint32_t used = ~detail::probe_group(ctrl_).match_empty_or_deleted();
+                const unsigned shift = detail::countr_zero16(used);
+                ctrl_ += shift;
+                slot_ += shift;
+            }
+        }
+
+        ctrl_t* ctrl_;
+        slot_type* slot_;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    flat_hash_map() noexcept(std::is_nothrow_default_constructible<Hash>::value &&
+        std::is_nothrow_default_constructible<KeyEqual>::value &&
+        std::is_nothrow_default_constructible<Allocator>::value)
+        : ctrl_(detail::empty_ctrl()), slots_(nullptr), capacity_(0), size_(0), growth_left_(0) {}
+
+    explicit flat_hash_map(const Allocator& alloc)
+        : ctrl_(detail::empty_ctrl()), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          alloc_(alloc) {}
+
+    explicit flat_hash_map(size_type count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                           const Allocator& alloc = Allocator())
+        : ctrl_(detail::empty_ctrl()), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          hash_(hash), equal_(equal), alloc_(alloc) {
+        reserve(count);
+    }
+
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    flat_hash_map(InputIt first, InputIt last) : flat_hash_map() {
+        insert(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> init) : flat_hash_map(init.begin(), init.end()) {}
+
+    // the keys are distinct, the copies go to the first free slot without a lookup
+    flat_hash_map(const flat_hash_map& other)
+        : flat_hash_map(other.size_, other.hash_, other.equal_,
+                        std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc_)) {
+        for (const value_type& value : other) {
+            const size_t h = hash_(value.first);
+            construct_at(find_first_non_full(h), h, value);
+        }
+    }
+
+    flat_hash_map(flat_hash_map&& other) noexcept
+        : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_), size_(other.size_),
+          growth_left_(other.growth_left_), hash_(std::move(other.hash_)), equal_(std::move(other.equal_)),
+          alloc_(std::move(other.alloc_)) {
+        other.reset();
+    }
+
+    ~flat_hash_map() {
+        destroy_entries();
+        deallocate();
+    }
+
+    flat_hash_map& operator=(const flat_hash_map& other) {
+        if (this != &other) {
+            flat_hash_map copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    flat_hash_map& operator=(flat_hash_map&& other) noexcept {
+        if (this != &other) {
+            destroy_entries();
+            deallocate();
+            ctrl_ = other.ctrl_;
+            slots_ = other.slots_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            growth_left_ = other.growth_left_;
+            hash_ = std::move(other.hash_);
+            equal_ = std::move(other.equal_);
+            alloc_ = std::move(other.alloc_);
+            other.reset();
+        }
+        return *this;
+    }
+
+    flat_hash_map& operator=(std::initializer_list<value_type> init) {
+        clear();
+        insert(init);
+        return *this;
+    }
+
+    iterator begin() noexcept {
+        iterator it(ctrl_, slots_);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+
+    const_iterator begin() const noexcept { return const_cast<flat_hash_map*>(this)->begin(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator end() const noexcept { return const_cast<flat_hash_map*>(this)->end(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    // the number of slots
+    size_type capacity() const noexcept { return capacity_; }
+    size_type bucket_count() const noexcept { return capacity_; }
+    float load_factor() const noexcept { return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f; }
+    float max_load_factor() const noexcept { return 0.875f; }
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return equal_; }
+    allocator_type get_allocator() const { return alloc_; }
+
+    // keeps the slots
+    void clear() noexcept {
+        destroy_entries();
+        if (capacity_ != 0) {
+            reset_ctrl();
+        }
+        size_ = 0;
+        growth_left_ = max_growth(capacity_);
+    }
+
+    // makes room for count entries without growing
+    void reserve(size_type count) {
+        if (count > size_ + growth_left_) {
+            resize(capacity_for(count));
+        }
+    }
+
+    // sets the capacity to the smallest one for max(count, size()) entries, 0
+    // releases the slots of an empty map
+    void rehash(size_type count) {
+        const size_type capacity = capacity_for(std::max(count, size_));
+        if (capacity == 0) {
+            deallocate();
+            reset();
+        } else if (capacity != capacity_) {
+            resize(capacity);
+        }
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return emplace_key(value.first, value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return emplace_key(value.first, std::move(value));
+    }
+
+    template <class P, class = enable_if_t<std::is_constructible<value_type, P&&>::value>>
+    std::pair<iterator, bool> insert(P&& value) {
+        return emplace(std::forward<P>(value));
+    }
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> init) {
+        insert(init.begin(), init.end());
+    }
+
+    // the entry is built first to find its key
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        return emplace_key(value.first, std::move(value));
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& mapped) {
+        std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(mapped));
+        if (!result.second) {
+            result.first->second = std::forward<M>(mapped);
+        }
+        return result;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& mapped) {
+        std::pair<iterator, bool> result = try_emplace(std::move(key), std::forward<M>(mapped));
+        if (!result.second) {
+            result.first->second = std::forward<M>(mapped);
+        }
+        return result;
+    }
+
+    T& operator[](const key_type& key) { return try_emplace(key).first->second; }
+    T& operator[](key_type&& key) { return try_emplace(std::move(key)).first->second; }
+
+    template <class K = key_type>
+    T& at(const key_arg<K>& key) {
+        const size_t index = find_index(key, hash_(key));
+        if (index == capacity_) {
+            throw std::out_of_range("flat_hash_map::at");
+        }
+        return policy::value(slots_[index]).second;
+    }
+
+    template <class K = key_type>
+    const T& at(const key_arg<K>& key) const {
+        return const_cast<flat_hash_map*>(this)->at(key);
+    }
+
+    template <class K = key_type>
+    iterator find(const key_arg<K>& key) {
+        return iterator_at(find_index(key, hash_(key)));
+    }
+
+    template <class K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return const_cast<flat_hash_map*>(this)->find(key);
+    }
+
+    template <class K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return find_index(key, hash_(key)) != capacity_;
+    }
+
+    template <class K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    // returns the iterator after pos
+    iterator erase(const_iterator pos) {
+        erase_at(static_cast<size_t>(pos.ctrl_ - ctrl_));
+        iterator next(pos.ctrl_, pos.slot_);
+        next.skip_empty_or_deleted();
+        return next;
+    }
+
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+
+    template <class K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        const size_t index = find_index(key, hash_(key));
+        if (index == capacity_) {
+            return 0;
+        }
+        erase_at(index);
+        return 1;
+    }
+
+    void swap(flat_hash_map& other) noexcept {
+        using std::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(growth_left_, other.growth_left_);
+        swap(hash_, other.hash_);
+        swap(equal_, other.equal_);
+        swap(alloc_, other.alloc_);
+    }
+
+    friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const flat_hash_map& lhs, const flat_hash_map& rhs) {
+        if (lhs.size_ != rhs.size_) {
+            return false;
+        }
+        for (const value_type& value : lhs) {
+            const_iterator it = rhs.find(value.first);
+            if (it == rhs.end() || !(it->second == value.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const flat_hash_map& lhs, const flat_hash_map& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    static constexpr size_t min_capacity = detail::group_width - 1;
+
+    static size_t max_growth(size_t capacity) noexcept {
+        return capacity - capacity / 8;
+    }
+
+    static size_t capacity_for(size_t count) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        size_t capacity = min_capacity;
+        while (max_growth(capacity) < count) {
+            capacity = capacity * 2 + 1;
+        }
+        return capacity;
+    }
+
+    static ctrl_t h2(size_t h) noexcept {
+        return static_cast<ctrl_t>(h & 0x7f);
+    }
+
+    iterator iterator_at(size_t index) noexcept {
+        return iterator(ctrl_ + index, slots_ + index);
+    }
+
+    const key_type& key_at(size_t index) const noexcept {
+        return policy::value(slots_[index]).first;
+    }
+
+    // Implementation detail
+    // 1. The probe visits the groups at H1, H1 + 16, H1 + 48, ... (triangular
+    //      steps), which reaches every group of a table of 2^k - 1 slots. It
+    //      returns capacity_ when the key is not in the table
+    template <class K>
+    size_t find_index(const K& key, size_t h) const {
+        const ctrl_t tag = h2(h);
+        size_t pos = (h >> 7) & capacity_;
+        for (size_t step = detail::group_width;; step += detail::group_width) {
+            const detail::probe_group group(ctrl_ + pos);
+            for (uint32_t match = group.match(tag); match != 0; match &= match - 1) {
+                const size_t index = (pos + detail::countr_zero16(match)) & capacity_;
+                if (equal_(key_at(index), key)) {
+                    return index;
+                }
+            }
+            if (group.match_empty() != 0) {
+                return capacity_;
+            }
+            pos = (pos + step) & capacity_;
+        }
+    }
+
+    size_t find_first_non_full(size_t h) const noexcept {
+        size_t pos = (h >> 7) & capacity_;
+        for (size_t step = detail::group_width;; step += detail::group_width) {
+            const uint32_t free = detail::probe_group(ctrl_ + pos).match_empty_or_deleted();
+            if (free != 0) {
+                return (pos + detail::countr_zero16(free)) & capacity_;
+            }
+            pos = (pos + step) & capacity_;
+        }
+    }
+
+    // the control byte of a slot and its copy after the sentinel, which is the
+    // byte itself for the slots from 15
+    void set_ctrl(size_t index, ctrl_t value) noexcept {
+        ctrl_[index] = value;
+        ctrl_[((index - (detail::group_width - 1)) & capacity_) + (detail::group_width - 1)] = value;
+    }
+
+    template <class K, class... Args>
+    std::pair<iterator, bool> emplace_key(const K& key, Args&&... args) {
+        const size_t h = hash_(key);
+        size_t index = find_index(key, h);
+        if (index != capacity_) {
+            return std::pair<iterator, bool>(iterator_at(index), false);
+        }
+        index = find_first_non_full(h);
+        if (growth_left_ == 0 && ctrl_[index] != detail::ctrl_deleted) {
+            // the arguments may refer to entries, which the growth relocates
+            value_type value(std::forward<Args>(args)...);
+            grow();
+            return std::pair<iterator, bool>(construct_at(find_first_non_full(h), h, std::move(value)), true);
+        }
+        return std::pair<iterator, bool>(construct_at(index, h, std::forward<Args>(args)...), true);
+    }
+
+    // the slot is free, the table is unchanged if the construction throws
+    template <class... Args>
+    iterator construct_at(size_t index, size_t h, Args&&... args) {
+        policy::construct(alloc_, slots_ + index, std::forward<Args>(args)...);
+        growth_left_ -= ctrl_[index] == detail::ctrl_empty;
+        set_ctrl(index, h2(h));
+        ++size_;
+        return iterator_at(index);
+    }
+
+    // Implementation detail
+    // 1. A slot becomes empty again when no probe could have passed it full: the
+    //      empty slots around it leave no window of 16 full or deleted slots
+    //      across it. Otherwise it is marked deleted, so the probes go on
+    void erase_at(size_t index) noexcept {
+        policy::destroy(alloc_, slots_ + index);
+        --size_;
+        const uint32_t empty_after = detail::probe_group(ctrl_ + index).match_empty();
+        const uint32_t empty_before =
+            detail::probe_group(ctrl_ + ((index - detail::group_width) & capacity_)).match_empty();
+        const bool was_never_full = empty_before != 0 && empty_after != 0 &&
+            detail::countr_zero16(empty_after) + detail::countl_zero16(empty_before) < detail::group_width;
+        set_ctrl(index, was_never_full ? detail::ctrl_empty : detail::ctrl_deleted);
+        growth_left_ += was_never_full;
+    }
+
+    void grow() {
+        if (capacity_ == 0) {
+            resize(min_capacity);
+        } else if (size_ * 32 <= capacity_ * 25) {
+            // mostly deleted slots
+            resize(capacity_);
+        } else {
+            resize(capacity_ * 2 + 1);
+        }
+    }
+
+    // the slots, then the control bytes
+    static size_t allocation_size(size_t capacity) noexcept {
+        return capacity + (capacity + detail::group_width + sizeof(slot_type) - 1) / sizeof(slot_type);
+    }
+
+    void reset_ctrl() noexcept {
+        std::memset(ctrl_, detail::ctrl_empty, capacity_ + detail::group_width);
+        ctrl_[capacity_] = detail::ctrl_sentinel;
+    }
+
+    void resize(size_t capacity) {
+        ctrl_t* const old_ctrl = ctrl_;
+        slot_type* const old_slots = slots_;
+        const size_t old_capacity = capacity_;
+
+        typename slot_traits::allocator_type allocator(alloc_);
+        slots_ = slot_traits::allocate(allocator, allocation_size(capacity));
+        ctrl_ = reinterpret_cast<ctrl_t*>(slots_ + capacity);
+        capacity_ = capacity;
+        reset_ctrl();
+        growth_left_ = max_growth(capacity) - size_;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                const size_t h = hash_(policy::value(old_slots[i]).first);
+                const size_t index = find_first_non_full(h);
+                set_ctrl(index, h2(h));
+                metaprogram::uninitialized_relocate(old_slots + i, old_slots + i + 1, slots_ + index);
+            }
+        }
+        if (old_capacity != 0) {
+            slot_traits::deallocate(allocator, old_slots, allocation_size(old_capacity));
+        }
+    }
+
+    // a node slot is a pointer, but its entry still has to be destroyed and freed
+    void destroy_entries() noexcept {
+        destroy_entries(bool_constant<!flat_hash_map_uses_nodes<value_type>::value &&
+            is_trivially_destructible<value_type>::value>());
+    }
+
+    void destroy_entries(true_type) noexcept {}
+
+    void destroy_entries(false_type) noexcept {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                policy::destroy(alloc_, slots_ + i);
+            }
+        }
+    }
+
+    void deallocate() noexcept {
+        if (capacity_ != 0) {
+            typename slot_traits::allocator_type allocator(alloc_);
+            slot_traits::deallocate(allocator, slots_, allocation_size(capacity_));
+        }
+    }
+
+    // the state of a map without slots
+    void reset() noexcept {
+        ctrl_ = detail::empty_ctrl();
+        slots_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growth_left_ = 0;
+    }
+
+    ctrl_t* ctrl_;
+    slot_type* slots_;
+    size_t capacity_;
+    size_t size_;
+    size_t growth_left_;
+    Hash hash_;
+    KeyEqual equal_;
+    Allocator alloc_;
+};
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+constexpr size_t flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::min_capacity;
+
+NS_META_END
+
+#endif /* flat_hash_map_h */
@@ -0,0 +1,190 @@
+//
+//  function_traits.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef function_traits_h
+#define function_traits_h
+
+#include <cstddef>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_list.h"
+#include "type_traits_type.h"
+
+NS_META_BEG
+
+// The qualifiers of a function type, function_traits<F>::qualifiers is a bitmask of them.
+enum function_qualifier_flags : unsigned {
+    qualifier_none = 0,
+    qualifier_const = 1u << 0,
+    qualifier_volatile = 1u << 1,
+    qualifier_lvalue_ref = 1u << 2,
+    qualifier_rvalue_ref = 1u << 3,
+    qualifier_noexcept = 1u << 4,
+};
+
+namespace detail {
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    struct signature_traits_base {
+        using result_type = R;
+        using args = type_list<Args...>;
+        // R(Args...) or R(Args..., ...) without the qualifiers
+        using signature = Signature;
+        // the class of a member function pointer or functor, void otherwise
+        using class_type = C;
+
+        template <size_t I>
+        using arg = at_t<args, I>;
+
+        static constexpr size_t arity = sizeof...(Args);
+        static constexpr unsigned qualifiers = Q;
+        static constexpr bool is_variadic = Variadic;
+        static constexpr bool is_const = (Q & qualifier_const) != 0;
+        static constexpr bool is_volatile = (Q & qualifier_volatile) != 0;
+        static constexpr bool is_lvalue_ref = (Q & qualifier_lvalue_ref) != 0;
+        static constexpr bool is_rvalue_ref = (Q & qualifier_rvalue_ref) != 0;
+        static constexpr bool is_noexcept = (Q & qualifier_noexcept) != 0;
+    };
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr size_t signature_traits_base<Signature, R, Q, Variadic, C, Args...>::arity;
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr unsigned signature_traits_base<Signature, R, Q, Variadic, C, Args...>::qualifiers;
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr bool signature_traits_base<Signature, R, Q, Variadic, C, Args...>::is_variadic;
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr bool signature_traits_base<Signature, R, Q, Variadic, C, Args...>::is_const;
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr bool signature_traits_base<Signature, R, Q, Variadic, C, Args...>::is_volatile;
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr bool signature_traits_base<Signature, R, Q, Variadic, C, Args...>::is_lvalue_ref;
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr bool signature_traits_base<Signature, R, Q, Variadic, C, Args...>::is_rvalue_ref;
+
+    template <class Signature, class R, unsigned Q, bool Variadic, class C, class... Args>
+    constexpr bool signature_traits_base<Signature, R, Q, Variadic, C, Args...>::is_noexcept;
+
+    // Implementation detail
+    // 1. One specialization per qualified function type, so a signature is
+    //      decomposed by a single match. C is the class when F comes from a
+    //      member function pointer
+    // 2. noexcept is part of the type since c++17, before that the noexcept
+    //      specializations would be redefinitions
+    template <class F, class C = void>
+    struct signature_traits {};
+
+#define META_SIGNATURE_TRAITS(QUALS, FLAGS) \
+    template <class R, class C, class... Args> \
+    struct signature_traits<R(Args...) QUALS, C> \
+        : signature_traits_base<R(Args...), R, FLAGS, false, C, Args...> {}; \
+    template <class R, class C, class... Args> \
+    struct signature_traits<R(Args..., ...) QUALS, C> \
+        : signature_traits_base<R(Args..., ...), R, FLAGS, true, C, Args...> {};
+
+    META_SIGNATURE_TRAITS(, qualifier_none)
+    META_SIGNATURE_TRAITS(const, qualifier_const)
+    META_SIGNATURE_TRAITS(volatile, qualifier_volatile)
+    META_SIGNATURE_TRAITS(const volatile, qualifier_const | qualifier_volatile)
+    META_SIGNATURE_TRAITS(&, qualifier_lvalue_ref)
+    META_SIGNATURE_TRAITS(const &, qualifier_const | qualifier_lvalue_ref)
+    META_SIGNATURE_TRAITS(volatile &, qualifier_volatile | qualifier_lvalue_ref)
+    META_SIGNATURE_TRAITS(const volatile &, qualifier_const | qualifier_volatile | qualifier_lvalue_ref)
+    META_SIGNATURE_TRAITS(&&, qualifier_rvalue_ref)
+    META_SIGNATURE_TRAITS(const &&, qualifier_const | qualifier_rvalue_ref)
+    META_SIGNATURE_TRAITS(volatile &&, qualifier_volatile | qualifier_rvalue_ref)
+    META_SIGNATURE_TRAITS(const volatile &&, qualifier_const | qualifier_volatile | qualifier_rvalue_ref)
+
+#if defined(__cpp_noexcept_function_type)
+    META_SIGNATURE_TRAITS(noexcept, qualifier_noexcept)
+    META_SIGNATURE_TRAITS(const noexcept, qualifier_const | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(volatile noexcept, qualifier_volatile | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(const volatile noexcept, qualifier_const | qualifier_volatile | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(& noexcept, qualifier_lvalue_ref | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(const & noexcept, qualifier_const | qualifier_lvalue_ref | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(volatile & noexcept, qualifier_volatile | qualifier_lvalue_ref | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(const volatile & noexcept,
+        qualifier_const | qualifier_volatile | qualifier_lvalue_ref | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(&& noexcept, qualifier_rvalue_ref | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(const && noexcept, qualifier_const | qualifier_rvalue_ref | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(volatile && noexcept, qualifier_volatile | qualifier_rvalue_ref | qualifier_noexcept)
+    META_SIGNATURE_TRAITS(const volatile && noexcept,
+        qualifier_const | qualifier_volatile | qualifier_rvalue_ref | qualifier_noexcept)
+#endif
+
+#undef META_SIGNATURE_TRAITS
+
+    // Implementation detail
+    // 1. A functor is decomposed through its operator(), so it must have exactly
+    //      one non-template operator(). Generic lambdas and overloaded functors
+    //      get no members
+    template <class F, class = void>
+    struct functor_traits {};
+
+    // the class of &F::operator() is a base of F when operator() is inherited
+    template <class M, class Functor>
+    struct functor_traits_of {};
+
+    template <class F, class C, class Functor>
+    struct functor_traits_of<F C::*, Functor> : signature_traits<F, Functor> {};
+
+    template <class F>
+    struct functor_traits<F, decltype((void)&F::operator())> : functor_traits_of<decltype(&F::operator()), F> {};
+
+    template <class F, bool = is_function_type<F>::value>
+    struct callable_traits : signature_traits<F> {};
+
+    template <class F>
+    struct callable_traits<F, false> : functor_traits<F> {};
+}
+
+// Decomposes a callable type in one match. F can be a function type, a pointer or
+// reference to function, a member function pointer, or a class with a single
+// non-template operator() (lambdas, functors), cv-qualified or not.
+// Provides the members
+//      result_type, args (a type_list), arg<I>, arity, signature (R(Args...)),
+//      class_type (the class of a member function pointer or functor, or void),
+//      qualifiers (function_qualifier_flags), is_variadic, is_const, is_volatile,
+//      is_lvalue_ref, is_rvalue_ref and is_noexcept
+// For any other type there is no member, so it can be used in SFINAE.
+// Example:
+//      using traits = function_traits<int (Foo::*)(float, char) const>;
+//      static_assert(is_same<type_list<float, char>, traits::args>(), "");
+//      static_assert(is_same<Foo, traits::class_type>() && traits::is_const, "");
+template <class F>
+struct function_traits : detail::callable_traits<F> {};
+
+template <class F>
+struct function_traits<F*> : detail::signature_traits<F> {};
+
+template <class F>
+struct function_traits<F&> : function_traits<F> {};
+
+template <class F>
+struct function_traits<F&&> : function_traits<F> {};
+
+template <class F>
+struct function_traits<const F> : function_traits<F> {};
+
+template <class F>
+struct function_traits<volatile F> : function_traits<F> {};
+
+template <class F>
+struct function_traits<const volatile F> : function_traits<F> {};
+
+template <class F, class C>
+struct function_traits<F C::*> : detail::signature_traits<F, C> {};
+
+NS_META_END
+
+#endif /* function_traits_h */
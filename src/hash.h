@@ -0,0 +1,493 @@
+//
+//  hash.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef hash_h
+#define hash_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+#include "integer_sequence.h"
+#include "kernels.h"
+#include "reflect.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+NS_META_BEG
+
+/***************************** Hashing ***********************************
+hash<T> is the hash function object of a key type, for std::unordered_map and
+the hash tables of the library. Its strategy is picked at compile time from the
+type traits, see hash_category_of:
+1. integral types, enums and pointers are one multiply-xorshift mix of the
+    value, so the low bits a power-of-two table takes depend on every bit
+2. float and double are the mix of their bits, +0.0 and -0.0 hash equal
+3. contiguous ranges (data() and size(), like std::string, std::vector and
+    array_view) and arrays hash their elements, in one pass of hash_bytes
+    when the element bytes can be hashed. Ranges with equal elements hash
+    equal, whatever the container, and a view hashes what it refers to.
+    The range hash is transparent, it takes the other ranges of the same
+    elements too, for the heterogeneous lookups of flat_hash_map
+4. other types with unique object representations (trivially copyable
+    without padding, like a struct of integers) hash their bytes in one pass
+    of hash_bytes
+5. other aggregate classes combine the hashes of their fields, from c++17
+Any other type must specialize hash<T>.
+Example:
+    struct Key { uint32_t id; uint16_t shard; uint16_t kind; };     // bytes
+    struct Name { std::string first; std::string last; };           // fields
+    std::unordered_map<Key, int, metaprogram::hash<Key>> ids;
+    std::unordered_map<Name, int, metaprogram::hash<Name>> names;
+Implementation Note:
+1. hash_bytes is wyhash up to 256 bytes: 16 bytes at a time folded with a
+    64 x 64 -> 128 bit multiply, three lanes of them over 48 bytes. A longer
+    input is accumulated in 64-byte stripes as xxh3 does, 8 lanes of a 32 x 32
+    -> 64 bit multiply of the bytes with a key. The stripes are a kernel of
+    kernels.h, so they run in vector registers, up to AVX-512 selected with
+    cpuid, and give the same hash on every instruction set
+2. hash_mix is one multiply, as the integer hash of the abseil and ankerl
+    tables: every input bit reaches the low and the high bits of the hash,
+    but a flipped bit doesn't flip each output bit with probability 1/2 as
+    it does through hash_bytes (see hash_bench for the avalanche bias)
+3. The bytes are read in the host byte order, a hash is not the same across
+    byte orders or versions of the library: don't store it
+4. There is no per-process seed, the hashes don't resist inputs crafted to
+    collide
+5. hash_bitwise is right when equal values have equal bytes. Specialize
+    is_bitwise_hashable<T> to false_type for a class whose operator== is not
+    memberwise, then it is hashed field by field, or specialize hash<T>
+**************************************************************************/
+
+// The strategies, hash_category_of<T>::value is one of them.
+enum hash_category : unsigned {
+    hash_none,
+    hash_scalar,
+    hash_floating_point,
+    hash_bitwise,
+    hash_range,
+    hash_fields,
+};
+
+// Checks whether T is hashed by its bytes: equal values of T have equal bytes.
+template <class T>
+struct is_bitwise_hashable : public has_unique_object_representations<T> {};
+
+namespace detail {
+    template <class T, class = void>
+    struct is_contiguous_range : public false_type {};
+
+    template <class T>
+    struct is_contiguous_range<T,
+        decltype((void)std::declval<const T&>().data(), (void)std::declval<const T&>().size())>
+        : public is_pointer<decltype(std::declval<const T&>().data())> {};
+
+#if defined(__cpp_structured_bindings)
+    template <class T>
+    struct is_field_hashable : public is_aggregate_class<T> {};
+#else
+    template <class T>
+    struct is_field_hashable : public false_type {};
+#endif
+}
+
+// Provides the member constant value which is the hash_category T is hashed with.
+template <class T>
+struct hash_category_of : public integral_constant<unsigned,
+    (is_integral<T>::value || is_enum<T>::value || is_pointer<T>::value || is_null_pointer<T>::value)
+        && sizeof(T) <= sizeof(uint64_t) ? hash_scalar
+    : is_floating_point<T>::value ? hash_floating_point
+    : detail::is_contiguous_range<T>::value ? hash_range
+    : is_bitwise_hashable<T>::value ? hash_bitwise
+    : is_array<T>::value ? hash_range
+    : detail::is_field_hashable<T>::value ? hash_fields
+    : hash_none> {};
+
+// The hash function object of T, selected by its category. Specialize hash<T> for
+// a type of category hash_none, with the member
+//      size_t operator()(const T& value) const noexcept;
+// which can build on hash_mix, hash_bytes and hash_combine.
+template <class T, unsigned = hash_category_of<T>::value>
+struct hash;
+
+namespace detail {
+    // Implementation detail
+    // 1. The constants of wyhash (hash_short) and the xxh3 accumulators (hash_long),
+    //      the key of a stripe is 8 consecutive words of hash_secret starting at
+    //      its index in the block, so swapped stripes hash differently
+    META_INLINE_VAR constexpr uint64_t hash_wyp[4] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+    };
+
+    META_INLINE_VAR constexpr uint64_t hash_secret[24] = {
+        0xe220a8397b1dcdafull, 0x6e789e6aa1b965f4ull, 0x06c45d188009454full, 0xf88bb8a8724c81ecull,
+        0x1b39896a51a8749bull, 0x53cb9f0c747ea2eaull, 0x2c829abe1f4532e1ull, 0xc584133ac916ab3cull,
+        0x3ee5789041c98ac3ull, 0xf3b8488c368cb0a6ull, 0x657eecdd3cb13d09ull, 0xc2d326e0055bdef6ull,
+        0x8621a03fe0bbdb7bull, 0x8e1f7555983aa92full, 0xb54e0f1600cc4d19ull, 0x84bb3f97971d80abull,
+        0x7d29825c75521255ull, 0xc3cf17102b7f7f86ull, 0x3466e9a083914f64ull, 0xd81a8d2b5a4485acull,
+        0xdb01602b100b9ed7ull, 0xa9038a921825f10dull, 0xedf5f1d90dca2f6aull, 0x54496ad67bd2634cull,
+    };
+
+    // the hash_long stripes, a block is 16 of them, then the lanes are scrambled
+    constexpr size_t hash_stripe = 64;
+    constexpr size_t hash_block_stripes = 16;
+    constexpr size_t hash_short_max = 256;
+
+    META_ALWAYS_INLINE uint64_t hash_read64(const unsigned char* p) noexcept {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    META_ALWAYS_INLINE uint64_t hash_read32(const unsigned char* p) noexcept {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    // a and b become the low and high words of a * b
+    META_ALWAYS_INLINE void mum128(uint64_t& a, uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 uint128;
+        const uint128 r = static_cast<uint128>(a) * b;
+        a = static_cast<uint64_t>(r);
+        b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const uint64_t t = rl + (rm0 << 32);
+        const uint64_t lo = t + (rm1 << 32);
+        const uint64_t carry = static_cast<uint64_t>(t < rl) + static_cast<uint64_t>(lo < t);
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+    }
+
+    // the 128-bit product folded to 64 bits
+    META_ALWAYS_INLINE uint64_t mum(uint64_t a, uint64_t b) noexcept {
+        mum128(a, b);
+        return a ^ b;
+    }
+
+    META_ALWAYS_INLINE uint64_t hash_short(const unsigned char* p, size_t n, uint64_t seed) noexcept {
+        seed ^= mum(seed ^ hash_wyp[0], hash_wyp[1]);
+        uint64_t a, b;
+        if (n <= 16) {
+            if (n >= 4) {
+                // two overlapping pairs of 4-byte reads cover 4 to 16 bytes
+                const size_t q = (n >> 3) << 2;
+                a = (hash_read32(p) << 32) | hash_read32(p + q);
+                b = (hash_read32(p + n - 4) << 32) | hash_read32(p + n - 4 - q);
+            } else if (n > 0) {
+                a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[n >> 1]) << 8) | p[n - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = n;
+            if (i > 48) {
+                uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = mum(hash_read64(p) ^ hash_wyp[1], hash_read64(p + 8) ^ seed);
+                    see1 = mum(hash_read64(p + 16) ^ hash_wyp[2], hash_read64(p + 24) ^ see1);
+                    see2 = mum(hash_read64(p + 32) ^ hash_wyp[3], hash_read64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = mum(hash_read64(p) ^ hash_wyp[1], hash_read64(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            // the last 16 bytes, overlapping the ones already mixed
+            a = hash_read64(p + i - 16);
+            b = hash_read64(p + i - 8);
+        }
+        a ^= hash_wyp[1];
+        b ^= seed;
+        mum128(a, b);
+        return mum(a ^ hash_wyp[0] ^ n, b ^ hash_wyp[1]);
+    }
+
+    // Implementation detail
+    // 1. A stripe is 8 lanes of 64 bits. Element-wise loops over them don't
+    //      become vector instructions (gcc doesn't pair the lanes of the swap),
+    //      so with __builtin_shufflevector the lanes are compiler vectors of L
+    //      lanes of the run_kernel entry, else the scalar loop. Both compute
+    //      the same sums
+    struct hash_scalar_lanes {
+        using lane_type = uint64_t;
+
+        static META_ALWAYS_INLINE void accumulate(uint64_t* acc, const unsigned char* p, const uint64_t* key) {
+            for (size_t j = 0; j < 8; ++j) {
+                const uint64_t data = hash_read64(p + 8 * j);
+                const uint64_t keyed = data ^ key[j];
+                acc[j ^ 1] += data;
+                acc[j] += (keyed & 0xffffffffu) * (keyed >> 32);
+            }
+        }
+
+        static META_ALWAYS_INLINE void scramble(uint64_t* acc) {
+            for (size_t j = 0; j < 8; ++j) {
+                acc[j] = (acc[j] ^ (acc[j] >> 47) ^ hash_secret[16 + j]) * 0x9e3779b1u;
+            }
+        }
+    };
+
+#if META_HAS_BUILTIN(__builtin_shufflevector)
+    template <class V, size_t... Is>
+    META_ALWAYS_INLINE void swap_lane_pairs(V& to, const V& from, index_sequence<Is...>) {
+        to = __builtin_shufflevector(from, from, (Is ^ 1)...);
+    }
+
+    template <size_t L>
+    struct hash_vector_lanes {
+        using lane_type = typename lane_vector<uint64_t, L>::type;
+        static constexpr size_t vectors = 8 / L;
+
+        static META_ALWAYS_INLINE void accumulate(lane_type* acc, const unsigned char* p, const uint64_t* key) {
+            for (size_t c = 0; c < vectors; ++c) {
+                lane_type data, keyed, swapped;
+                std::memcpy(&data, p + c * sizeof(lane_type), sizeof(lane_type));
+                std::memcpy(&keyed, key + c * L, sizeof(lane_type));
+                keyed ^= data;
+                swap_lane_pairs(swapped, data, make_index_sequence<L>());
+                acc[c] += swapped + (keyed & 0xffffffffu) * (keyed >> 32);
+            }
+        }
+
+        static META_ALWAYS_INLINE void scramble(lane_type* acc) {
+            for (size_t c = 0; c < vectors; ++c) {
+                lane_type key;
+                std::memcpy(&key, hash_secret + 16 + c * L, sizeof(lane_type));
+                acc[c] = (acc[c] ^ (acc[c] >> 47) ^ key) * 0x9e3779b1u;
+            }
+        }
+    };
+#endif
+
+    struct hash_stripes_kernel {
+        // n > hash_stripe, the last stripe is the last 64 bytes with their own key
+        template <class Lanes>
+        static META_ALWAYS_INLINE void run_lanes(const unsigned char* p, size_t n, uint64_t* out) {
+            typename Lanes::lane_type acc[64 / sizeof(typename Lanes::lane_type)];
+            std::memcpy(acc, out, sizeof(acc));
+            const size_t stripes = (n - 1) / hash_stripe;
+            size_t s = 0;
+            for (; s + hash_block_stripes <= stripes; s += hash_block_stripes) {
+                for (size_t k = 0; k < hash_block_stripes; ++k) {
+                    Lanes::accumulate(acc, p + (s + k) * hash_stripe, hash_secret + k);
+                }
+                Lanes::scramble(acc);
+            }
+            for (size_t k = 0; s + k < stripes; ++k) {
+                Lanes::accumulate(acc, p + (s + k) * hash_stripe, hash_secret + k);
+            }
+            Lanes::accumulate(acc, p + n - hash_stripe, hash_secret + 13);
+            std::memcpy(out, acc, sizeof(acc));
+        }
+
+        template <size_t L>
+        static META_ALWAYS_INLINE void run(const unsigned char* p, size_t n, uint64_t* out, false_type) {
+            run_lanes<hash_scalar_lanes>(p, n, out);
+        }
+
+#if META_HAS_BUILTIN(__builtin_shufflevector)
+        template <size_t L>
+        static META_ALWAYS_INLINE void run(const unsigned char* p, size_t n, uint64_t* out, true_type) {
+            run_lanes<hash_vector_lanes<L>>(p, n, out);
+        }
+#endif
+
+        template <size_t L, size_t K>
+        static META_ALWAYS_INLINE void run(const unsigned char* p, size_t n, uint64_t* out) {
+#if META_HAS_BUILTIN(__builtin_shufflevector)
+            run<L>(p, n, out, bool_constant<(L > 1)>());
+#else
+            run<L>(p, n, out, false_type());
+#endif
+        }
+    };
+
+    inline uint64_t hash_long(const unsigned char* p, size_t n, uint64_t seed) noexcept {
+        uint64_t acc[8] = {
+            0x00000000c2b2ae3dull, 0x9e3779b185ebca87ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull,
+            0x85ebca77c2b2ae63ull, 0x0000000085ebca77ull, 0x27d4eb2f165667c5ull, 0x000000009e3779b1ull,
+        };
+        dispatch_kernel<hash_stripes_kernel, uint64_t>(true_type(), p, n, static_cast<uint64_t*>(acc));
+        uint64_t h = (n * 0x9e3779b185ebca87ull) ^ seed;
+        for (size_t i = 0; i < 4; ++i) {
+            h += mum(acc[2 * i] ^ hash_secret[8 + 2 * i], acc[2 * i + 1] ^ hash_secret[9 + 2 * i]);
+        }
+        h ^= h >> 37;
+        h *= 0x165667919e3779f9ull;
+        return h ^ (h >> 32);
+    }
+}
+
+// Returns the hash of an integer, one multiply-xorshift: the 128-bit product with
+// a constant folded to 64 bits.
+inline uint64_t hash_mix(uint64_t value) noexcept {
+    return detail::mum(value ^ detail::hash_wyp[0], detail::hash_wyp[1]);
+}
+
+// Returns the hash of a sequence of hashes seed, value, order-dependent. A range
+// starts from any constant seed, hash_combine(0, hash of the first element).
+inline uint64_t hash_combine(uint64_t seed, uint64_t value) noexcept {
+    return detail::mum(seed ^ detail::hash_wyp[2], value ^ detail::hash_wyp[3]);
+}
+
+// Returns the hash of the n bytes at p.
+META_ALWAYS_INLINE uint64_t hash_bytes(const void* p, size_t n, uint64_t seed = 0) noexcept {
+    const unsigned char* bytes = static_cast<const unsigned char*>(p);
+    return n <= detail::hash_short_max ? detail::hash_short(bytes, n, seed) : detail::hash_long(bytes, n, seed);
+}
+
+namespace detail {
+    template <class T>
+    META_ALWAYS_INLINE uint64_t scalar_bits(T value) noexcept {
+        return static_cast<uint64_t>(value);
+    }
+
+    template <class T>
+    META_ALWAYS_INLINE uint64_t scalar_bits(T* value) noexcept {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+    }
+
+    META_ALWAYS_INLINE uint64_t scalar_bits(decltype(nullptr)) noexcept {
+        return 0;
+    }
+
+    template <class T, size_t N>
+    META_ALWAYS_INLINE const T* range_data(const T (&array)[N]) noexcept {
+        return array;
+    }
+
+    template <class T, size_t N>
+    META_ALWAYS_INLINE size_t range_size(const T (&)[N]) noexcept {
+        return N;
+    }
+
+    template <class R>
+    META_ALWAYS_INLINE auto range_data(const R& range) noexcept -> decltype(range.data()) {
+        return range.data();
+    }
+
+    template <class R>
+    META_ALWAYS_INLINE size_t range_size(const R& range) noexcept {
+        return static_cast<size_t>(range.size());
+    }
+
+    template <class R>
+    using range_element_t = remove_cv_t<remove_pointer_t<decltype(range_data(std::declval<const R&>()))>>;
+
+    // the element bytes are hashed in one pass, the length is part of hash_bytes
+    template <class T>
+    uint64_t hash_elements(const T* p, size_t n, true_type) noexcept {
+        return hash_bytes(p, n * sizeof(T));
+    }
+
+    template <class T>
+    uint64_t hash_elements(const T* p, size_t n, false_type) noexcept {
+        hash<T> hasher;
+        uint64_t h = hash_mix(n);
+        for (size_t i = 0; i < n; ++i) {
+            h = hash_combine(h, hasher(p[i]));
+        }
+        return h;
+    }
+}
+
+template <class T, unsigned>
+struct hash {
+    static_assert(hash_category_of<T>::value != hash_none,
+        "T can't be hashed, specialize metaprogram::hash<T>");
+};
+
+template <class T>
+struct hash<T, hash_scalar> {
+    META_ALWAYS_INLINE size_t operator()(const T& value) const noexcept {
+        return static_cast<size_t>(hash_mix(detail::scalar_bits(value)));
+    }
+};
+
+template <class T>
+struct hash<T, hash_floating_point> {
+    size_t operator()(const T& value) const noexcept {
+        // long double has padding bytes, equal values are equal doubles
+        using bits_type = conditional_t<(sizeof(T) > sizeof(double)), double, T>;
+        const bits_type normalized = value == 0 ? bits_type(0) : static_cast<bits_type>(value);
+        uint64_t bits = 0;
+        std::memcpy(&bits, &normalized, sizeof(normalized));
+        return static_cast<size_t>(hash_mix(bits));
+    }
+};
+
+template <class T>
+struct hash<T, hash_bitwise> {
+    size_t operator()(const T& value) const noexcept {
+        // the size is a constant, the branches of hash_short fold away
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        return static_cast<size_t>(sizeof(T) <= detail::hash_short_max
+            ? detail::hash_short(bytes, sizeof(T), 0) : detail::hash_long(bytes, sizeof(T), 0));
+    }
+};
+
+// transparent: another contiguous range of the same elements has the same hash,
+// a std::string_view looks up a std::string key
+template <class T>
+struct hash<T, hash_range> {
+    using is_transparent = void;
+
+    size_t operator()(const T& value) const noexcept {
+        return hash_range_of(value);
+    }
+
+    template <class R, class = enable_if_t<detail::is_contiguous_range<R>::value &&
+        is_same<detail::range_element_t<R>, detail::range_element_t<T>>::value>>
+    size_t operator()(const R& value) const noexcept {
+        return hash_range_of(value);
+    }
+
+private:
+    template <class R>
+    static size_t hash_range_of(const R& value) noexcept {
+        return static_cast<size_t>(detail::hash_elements(detail::range_data(value), detail::range_size(value),
+            is_bitwise_hashable<detail::range_element_t<R>>()));
+    }
+};
+
+#if defined(__cpp_structured_bindings)
+template <class T>
+struct hash<T, hash_fields> {
+    size_t operator()(const T& value) const noexcept {
+        uint64_t h = 0;
+        for_each_field(value, [&h](const auto& field) {
+            h = hash_combine(h, hash<remove_cvref_t<decltype(field)>>()(field));
+        });
+        return static_cast<size_t>(h);
+    }
+};
+#endif
+
+NS_META_END
+
+#endif /* hash_h */
@@ -0,0 +1,211 @@
+//
+//  integer_sequence.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef integer_sequence_h
+#define integer_sequence_h
+
+#include <cstddef>
+
+#include "config.h"
+#include "type_traits_helper.h"
+
+NS_META_BEG
+
+/***************************** Integer sequences **************************
+A compile-time sequence of integers, to expand a pack over indices, and the
+sequences made from one: ranges, offsets, reversals and slices.
+Example:
+    template <class Tuple, size_t... Is>
+    void print(const Tuple& t, index_sequence<Is...>) { ((std::cout << std::get<Is>(t)), ...); }
+    print(t, make_index_sequence<3>());
+
+    static_assert(is_same<index_sequence<2, 1, 0>, make_reverse_index_sequence<3>>(), "");
+    static_assert(is_same<index_sequence<5, 6>, make_index_range<5, 7>>(), "");
+    static_assert(is_same<index_sequence<1, 2>, slice_sequence_t<index_sequence<0, 1, 2, 3>, 1, 3>>(), "");
+Implementation Note:
+1. make_integer_sequence is the compiler's __make_integer_seq (clang, msvc)
+    or __integer_pack (gcc) when there is one, a single instantiation for
+    any N. Otherwise it doubles a sequence of half the length, so N takes
+    O(log N) depth and O(N) work instead of the N levels of a recursion
+    which adds one element at a time
+2. Ranges, iotas and reversed index sequences are computed from the
+    indices, a single pack expansion on top of make_index_sequence
+3. reverse_sequence and slice_sequence read the elements of any sequence
+    from a constexpr array, O(1) depth, but gcc evaluates every read in
+    O(N), so they are meant for sequences of a few thousand elements. A
+    slice of 10k elements takes gcc 12 about 2s. make_reverse_index_sequence
+    and make_index_range don't read and have no such limit
+**************************************************************************/
+
+template <class T, T... Is>
+struct integer_sequence {
+    using value_type = T;
+
+    static constexpr size_t size() noexcept {
+        return sizeof...(Is);
+    }
+};
+
+template <size_t... Is>
+using index_sequence = integer_sequence<size_t, Is...>;
+
+namespace detail {
+    // Implementation detail
+    // 1. The sequence of 2N or 2N + 1 elements from the sequence of N, the
+    //      second half is the first one shifted by N
+    // 2. N is a template argument, gcc expands sizeof...(Is) in O(N) for
+    //      every element it is used in
+    template <size_t N, class S, bool Odd>
+    struct double_index_sequence;
+
+    template <size_t N, size_t... Is>
+    struct double_index_sequence<N, index_sequence<Is...>, false>
+        : type_identity<index_sequence<Is..., (N + Is)...>> {};
+
+    template <size_t N, size_t... Is>
+    struct double_index_sequence<N, index_sequence<Is...>, true>
+        : type_identity<index_sequence<Is..., (N + Is)..., 2 * N>> {};
+
+    template <size_t N>
+    struct make_index_sequence_impl
+        : double_index_sequence<N / 2, typename make_index_sequence_impl<N / 2>::type, N % 2 == 1> {
+        META_PROBE(make_index_sequence_impl);
+    };
+
+    template <>
+    struct make_index_sequence_impl<0> : type_identity<index_sequence<>> {};
+
+    template <>
+    struct make_index_sequence_impl<1> : type_identity<index_sequence<0>> {};
+
+    template <class T, class S>
+    struct cast_sequence;
+
+    template <class T, size_t... Is>
+    struct cast_sequence<T, index_sequence<Is...>> : type_identity<integer_sequence<T, static_cast<T>(Is)...>> {};
+
+    template <class T, T N>
+    struct make_integer_sequence_impl : cast_sequence<T, typename make_index_sequence_impl<static_cast<size_t>(N)>::type> {
+        static_assert(N >= 0, "make_integer_sequence: the length must not be negative");
+    };
+
+    template <class T, T Offset, class S>
+    struct offset_sequence;
+
+    template <class T, T Offset, T... Is>
+    struct offset_sequence<T, Offset, integer_sequence<T, Is...>>
+        : type_identity<integer_sequence<T, static_cast<T>(Is + Offset)...>> {};
+
+    template <size_t Last, class Is>
+    struct reverse_index_sequence;
+
+    template <size_t Last, size_t... Is>
+    struct reverse_index_sequence<Last, index_sequence<Is...>> : type_identity<index_sequence<(Last - Is)...>> {};
+
+    template <class T, T Start, T Step, class Is>
+    struct iota_sequence;
+
+    template <class T, T Start, T Step, size_t... Is>
+    struct iota_sequence<T, Start, Step, index_sequence<Is...>>
+        : type_identity<integer_sequence<T, static_cast<T>(Start + static_cast<T>(Is) * Step)...>> {};
+}
+
+// The sequence 0, 1, ..., N - 1 of type T.
+#if defined(META_BUILTIN_MAKE_INTEGER_SEQ)
+template <class T, T N>
+using make_integer_sequence = META_BUILTIN_MAKE_INTEGER_SEQ(integer_sequence, T, N);
+#elif defined(META_BUILTIN_INTEGER_PACK)
+template <class T, T N>
+using make_integer_sequence = integer_sequence<T, META_BUILTIN_INTEGER_PACK(N)...>;
+#else
+template <class T, T N>
+using make_integer_sequence = typename detail::make_integer_sequence_impl<T, N>::type;
+#endif
+
+template <size_t N>
+using make_index_sequence = make_integer_sequence<size_t, N>;
+
+// The indices of the pack Ts, 0, 1, ..., sizeof...(Ts) - 1.
+template <class... Ts>
+using index_sequence_for = make_index_sequence<sizeof...(Ts)>;
+
+// Provides the member typedef type which is the sequence S with Offset added to
+// every element.
+template <class S, typename S::value_type Offset>
+struct offset_sequence : detail::offset_sequence<typename S::value_type, Offset, S> {};
+
+template <class S, typename S::value_type Offset>
+using offset_sequence_t = typename offset_sequence<S, Offset>::type;
+
+// The sequence Begin, Begin + 1, ..., End - 1.
+template <size_t Begin, size_t End>
+using make_index_range = offset_sequence_t<make_index_sequence<End - Begin>, Begin>;
+
+// The sequence Start, Start + Step, ..., Start + (N - 1) * Step of type T.
+template <class T, T Start, size_t N, T Step = 1>
+using make_iota_sequence = typename detail::iota_sequence<T, Start, Step, make_index_sequence<N>>::type;
+
+namespace detail {
+    // Implementation detail
+    // 1. The elements of a sequence as an array, with a sentinel so an empty
+    //      sequence still makes one
+    template <class S>
+    struct sequence_values;
+
+    template <class T, T... Is>
+    struct sequence_values<integer_sequence<T, Is...>> {
+        static constexpr T values[sizeof...(Is) + 1] = {Is..., T()};
+    };
+
+    template <class T, T... Is>
+    constexpr T sequence_values<integer_sequence<T, Is...>>::values[sizeof...(Is) + 1];
+
+    // Implementation detail
+    // 1. The array is named through V, a single type argument, spelling
+    //      sequence_values<integer_sequence<T, Is...>> in the expansion would
+    //      substitute the whole pack for every element, O(N^2)
+    template <class V, class T, size_t Begin, class Js>
+    struct select_values;
+
+    template <class V, class T, size_t Begin, size_t... Js>
+    struct select_values<V, T, Begin, index_sequence<Js...>>
+        : type_identity<integer_sequence<T, V::values[Begin + Js]...>> {};
+
+    template <class V, class T, size_t Last, class Js>
+    struct reverse_values;
+
+    template <class V, class T, size_t Last, size_t... Js>
+    struct reverse_values<V, T, Last, index_sequence<Js...>>
+        : type_identity<integer_sequence<T, V::values[Last - Js]...>> {};
+}
+
+// Provides the member typedef type which is the sequence S in reverse order.
+template <class S>
+struct reverse_sequence : detail::reverse_values<detail::sequence_values<S>, typename S::value_type,
+    S::size() - 1, make_index_sequence<S::size()>> {};
+
+template <class S>
+using reverse_sequence_t = typename reverse_sequence<S>::type;
+
+// The sequence N - 1, ..., 1, 0.
+template <size_t N>
+using make_reverse_index_sequence = typename detail::reverse_index_sequence<N - 1, make_index_sequence<N>>::type;
+
+// Provides the member typedef type which is the elements [Begin, End) of the sequence S.
+template <class S, size_t Begin, size_t End>
+struct slice_sequence : detail::select_values<detail::sequence_values<S>, typename S::value_type,
+    Begin, make_index_sequence<(Begin < End ? End - Begin : 0)>> {
+    static_assert(Begin <= End && End <= S::size(), "slice_sequence: [Begin, End) is out of the sequence");
+};
+
+template <class S, size_t Begin, size_t End>
+using slice_sequence_t = typename slice_sequence<S, Begin, End>::type;
+
+NS_META_END
+
+#endif /* integer_sequence_h */
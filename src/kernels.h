@@ -0,0 +1,453 @@
+//
+//  kernels.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef kernels_h
+#define kernels_h
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+
+NS_META_BEG
+
+/***************************** Numeric kernels ****************************
+sum, min_value, max_value, dot, axpy, clamp and prefix_sum over arrays. The
+element type picks the kernel at compile time through kernel_traits:
+1. integral types but bool, float and double are processed in vector lanes,
+    the lane count is the register width of the instruction set over the
+    element size
+2. any other type goes through the scalar loop, it only needs the operators
+    the plain loop would use
+On x86 with gcc and clang the SSSE3, AVX2 and AVX-512 versions are compiled in
+every build, and the widest one the CPU supports is selected with cpuid on the
+first call. Elsewhere the kernels use the instruction set the build targets (SSE2
+on x86-64).
+Implementation Note:
+1. The lanes are independent accumulators, so the floating point sums, dot
+    products and prefix sums are reassociated. They can differ from the plain
+    loop in the last bits, and between instruction sets
+2. min_value and max_value of an array with a NaN are unspecified
+**************************************************************************/
+
+enum class simd_isa : unsigned {
+    scalar,
+    sse2,
+    ssse3,
+    avx2,
+    avx512,
+};
+
+// The width of the vector registers of an instruction set, in bytes.
+template <simd_isa Isa>
+struct simd_register_bytes : public integral_constant<size_t,
+    Isa == simd_isa::avx512 ? 64 : Isa == simd_isa::avx2 ? 32 : Isa == simd_isa::scalar ? 0 : 16> {};
+
+// The instruction set the build targets.
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+META_INLINE_VAR constexpr simd_isa build_simd_isa = simd_isa::avx512;
+#elif defined(__AVX2__)
+META_INLINE_VAR constexpr simd_isa build_simd_isa = simd_isa::avx2;
+#elif defined(__SSSE3__)
+META_INLINE_VAR constexpr simd_isa build_simd_isa = simd_isa::ssse3;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+META_INLINE_VAR constexpr simd_isa build_simd_isa = simd_isa::sse2;
+#else
+META_INLINE_VAR constexpr simd_isa build_simd_isa = simd_isa::scalar;
+#endif
+
+enum kernel_family : unsigned {
+    kernel_scalar,
+    kernel_integral,
+    kernel_floating_point,
+};
+
+// How the kernels process T, the classification traits decide it.
+// Provides the members
+//      family: kernel_integral for the integral types but bool, kernel_floating_point
+//          for float and double, kernel_scalar for anything else (long double too,
+//          there are no vector instructions for it)
+//      accumulators: the vectors a reduction keeps in flight, floating point adds
+//          have a latency of about 4 cycles, integer adds of 1
+//      lanes<Isa>::value: the elements in a vector register, 1 for kernel_scalar
+template <class T>
+struct kernel_traits {
+    static constexpr kernel_family family =
+        is_floating_point<T>::value && sizeof(T) <= 8 ? kernel_floating_point
+        : is_integral<T>::value && !is_same<remove_cv_t<T>, bool>::value ? kernel_integral
+        : kernel_scalar;
+
+    static constexpr size_t accumulators =
+        family == kernel_floating_point ? 4 : family == kernel_integral ? 2 : 1;
+
+    template <simd_isa Isa>
+    struct lanes : public integral_constant<size_t,
+        family == kernel_scalar || Isa == simd_isa::scalar ? 1 : simd_register_bytes<Isa>::value / sizeof(T)> {};
+};
+
+template <class T>
+constexpr kernel_family kernel_traits<T>::family;
+
+template <class T>
+constexpr size_t kernel_traits<T>::accumulators;
+
+namespace detail {
+    inline simd_isa detect_simd_isa() noexcept {
+#if defined(META_TARGET)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+            && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+            return simd_isa::avx512;
+        }
+        if (__builtin_cpu_supports("avx2") && build_simd_isa < simd_isa::avx2) {
+            return simd_isa::avx2;
+        }
+        if (__builtin_cpu_supports("ssse3") && build_simd_isa < simd_isa::ssse3) {
+            return simd_isa::ssse3;
+        }
+#endif
+        return build_simd_isa;
+    }
+}
+
+// The instruction set the kernels run with, detected on the first call.
+inline simd_isa active_simd_isa() noexcept {
+    static const simd_isa isa = detail::detect_simd_isa();
+    return isa;
+}
+
+namespace detail {
+    // Implementation detail
+    // 1. A kernel is a struct with a static run<L, K> template, L lanes and K
+    //      accumulators, most kernels process W = L * K elements per step. The
+    //      body is always inlined, so it is compiled for the instruction set of
+    //      the run_kernel entry it is instantiated in, and the loops over W
+    //      elements become vector instructions
+    // 2. The transforms compute a step into a local block before they store it,
+    //      so the compiler doesn't need to prove the input and output apart
+    struct sum_kernel {
+        template <size_t L, size_t K, class T>
+        static META_ALWAYS_INLINE T run(const T* p, size_t n) {
+            constexpr size_t W = L * K;
+            T acc[W];
+            for (size_t j = 0; j < W; ++j) {
+                acc[j] = T();
+            }
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                for (size_t j = 0; j < W; ++j) {
+                    acc[j] += p[i + j];
+                }
+            }
+            for (size_t j = 1; j < W; ++j) {
+                acc[0] += acc[j];
+            }
+            for (; i < n; ++i) {
+                acc[0] += p[i];
+            }
+            return acc[0];
+        }
+    };
+
+    template <bool Max>
+    struct extremum_kernel {
+        template <class T>
+        static META_ALWAYS_INLINE T pick(const T& a, const T& b) {
+            return Max ? (a < b ? b : a) : (b < a ? b : a);
+        }
+
+        template <size_t L, size_t K, class T>
+        static META_ALWAYS_INLINE T run(const T* p, size_t n) {
+            constexpr size_t W = L * K;
+            if (n == 0) {
+                return T();
+            }
+            T acc[W];
+            for (size_t j = 0; j < W; ++j) {
+                acc[j] = p[0];
+            }
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                for (size_t j = 0; j < W; ++j) {
+                    acc[j] = pick(acc[j], p[i + j]);
+                }
+            }
+            for (size_t j = 1; j < W; ++j) {
+                acc[0] = pick(acc[0], acc[j]);
+            }
+            for (; i < n; ++i) {
+                acc[0] = pick(acc[0], p[i]);
+            }
+            return acc[0];
+        }
+    };
+
+    struct dot_kernel {
+        template <size_t L, size_t K, class T>
+        static META_ALWAYS_INLINE T run(const T* a, const T* b, size_t n) {
+            constexpr size_t W = L * K;
+            T acc[W];
+            for (size_t j = 0; j < W; ++j) {
+                acc[j] = T();
+            }
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                for (size_t j = 0; j < W; ++j) {
+                    acc[j] += a[i + j] * b[i + j];
+                }
+            }
+            for (size_t j = 1; j < W; ++j) {
+                acc[0] += acc[j];
+            }
+            for (; i < n; ++i) {
+                acc[0] += a[i] * b[i];
+            }
+            return acc[0];
+        }
+    };
+
+    struct axpy_kernel {
+        template <size_t L, size_t K, class T>
+        static META_ALWAYS_INLINE void run(const T& alpha, const T* x, T* y, size_t n) {
+            constexpr size_t W = L * K;
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                T block[W];
+                for (size_t j = 0; j < W; ++j) {
+                    block[j] = alpha * x[i + j] + y[i + j];
+                }
+                for (size_t j = 0; j < W; ++j) {
+                    y[i + j] = block[j];
+                }
+            }
+            for (; i < n; ++i) {
+                y[i] = alpha * x[i] + y[i];
+            }
+        }
+    };
+
+    // Implementation detail
+    // 1. The bounds are copied, a reference could alias the output, and the
+    //      two selects are separate so each becomes a vector min/max
+    struct clamp_kernel {
+        template <size_t L, size_t K, class T>
+        static META_ALWAYS_INLINE void run(const T* in, size_t n, const T& lo_ref, const T& hi_ref, T* out) {
+            constexpr size_t W = L * K;
+            const T lo = lo_ref;
+            const T hi = hi_ref;
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                T block[W];
+                for (size_t j = 0; j < W; ++j) {
+                    block[j] = in[i + j] < lo ? lo : in[i + j];
+                    block[j] = hi < block[j] ? hi : block[j];
+                }
+                for (size_t j = 0; j < W; ++j) {
+                    out[i + j] = block[j];
+                }
+            }
+            for (; i < n; ++i) {
+                out[i] = in[i] < lo ? lo : hi < in[i] ? hi : in[i];
+            }
+        }
+    };
+
+#if META_HAS_BUILTIN(__builtin_shufflevector)
+    // the compiler vector of L lanes of T
+    template <class T, size_t L>
+    struct lane_vector {
+        typedef T type __attribute__((vector_size(L * sizeof(T))));
+    };
+
+    // Implementation detail
+    // 1. The helpers take the vectors by reference, a vector passed or returned
+    //      by value in a function compiled without AVX changes the ABI
+
+    // adds lane i - Shift of v to lane i, for the lanes from Shift
+    template <size_t Shift, class V, size_t... Is>
+    META_ALWAYS_INLINE void add_shifted_lanes(V& v, std::index_sequence<Is...>) {
+        v += __builtin_shufflevector(V{}, v, (Is < Shift ? 0 : sizeof...(Is) + Is - Shift)...);
+    }
+
+    template <class V, size_t... Is>
+    META_ALWAYS_INLINE void broadcast_last_lane(V& to, const V& from, std::index_sequence<Is...>) {
+        to = __builtin_shufflevector(from, from, (Is * 0 + sizeof...(Is) - 1)...);
+    }
+
+    // the inclusive scan of the lanes in log2(L) shifted adds
+    template <size_t Shift, size_t L, bool = (Shift < L)>
+    struct scan_lanes {
+        template <class V>
+        static META_ALWAYS_INLINE void run(V& v) {
+            add_shifted_lanes<Shift>(v, std::make_index_sequence<L>());
+            scan_lanes<Shift * 2, L>::run(v);
+        }
+    };
+
+    template <size_t Shift, size_t L>
+    struct scan_lanes<Shift, L, false> {
+        template <class V>
+        static META_ALWAYS_INLINE void run(V&) {}
+    };
+#endif
+
+    // Implementation detail
+    // 1. A scan is a chain of dependent adds. With vector shuffles a step of L
+    //      lanes is scanned in log2(L) shifted adds and the carry of the previous
+    //      steps is added to every lane. Element-wise loops over the lanes don't
+    //      become shuffles, they are slower than the chain, so without
+    //      __builtin_shufflevector the scan is the plain loop
+    struct prefix_sum_kernel {
+        template <size_t L, class T>
+        static META_ALWAYS_INLINE void run_scalar(const T* in, size_t n, T* out, T carry) {
+            for (size_t i = 0; i < n; ++i) {
+                carry += in[i];
+                out[i] = carry;
+            }
+        }
+
+        template <size_t L, class T>
+        static META_ALWAYS_INLINE void run(const T* in, size_t n, T* out, false_type) {
+            run_scalar<L>(in, n, out, T());
+        }
+
+#if META_HAS_BUILTIN(__builtin_shufflevector)
+        template <size_t L, class T>
+        static META_ALWAYS_INLINE void run(const T* in, size_t n, T* out, true_type) {
+            using V = typename lane_vector<T, L>::type;
+            V carry = V{};
+            size_t i = 0;
+            for (; i + L <= n; i += L) {
+                V v;
+                std::memcpy(&v, in + i, sizeof(V));
+                scan_lanes<1, L>::run(v);
+                v += carry;
+                std::memcpy(out + i, &v, sizeof(V));
+                broadcast_last_lane(carry, v, std::make_index_sequence<L>());
+            }
+            run_scalar<L>(in + i, n - i, out + i, T(carry[0]));
+        }
+#endif
+
+        template <size_t L, size_t K, class T>
+        static META_ALWAYS_INLINE void run(const T* in, size_t n, T* out) {
+#if META_HAS_BUILTIN(__builtin_shufflevector)
+            run<L>(in, n, out, bool_constant<(L > 1)>());
+#else
+            run<L>(in, n, out, false_type());
+#endif
+        }
+    };
+
+    template <class Kernel, size_t L, size_t K, class... Args>
+    auto run_kernel(const Args&... args) -> decltype(Kernel::template run<L, K>(args...)) {
+        return Kernel::template run<L, K>(args...);
+    }
+
+#if defined(META_TARGET)
+    template <class Kernel, size_t L, size_t K, class... Args>
+    META_TARGET("ssse3")
+    auto run_kernel_ssse3(const Args&... args) -> decltype(Kernel::template run<L, K>(args...)) {
+        return Kernel::template run<L, K>(args...);
+    }
+
+    template <class Kernel, size_t L, size_t K, class... Args>
+    META_TARGET("avx2")
+    auto run_kernel_avx2(const Args&... args) -> decltype(Kernel::template run<L, K>(args...)) {
+        return Kernel::template run<L, K>(args...);
+    }
+
+    template <class Kernel, size_t L, size_t K, class... Args>
+    META_TARGET("avx512f,avx512bw,avx512dq,avx512vl")
+    auto run_kernel_avx512(const Args&... args) -> decltype(Kernel::template run<L, K>(args...)) {
+        return Kernel::template run<L, K>(args...);
+    }
+#endif
+
+    template <class T>
+    using is_vector_kernel = bool_constant<kernel_traits<T>::family != kernel_scalar>;
+
+    template <class Kernel, class T, class... Args>
+    auto dispatch_kernel(false_type, const Args&... args) -> decltype(run_kernel<Kernel, 1, 1>(args...)) {
+        return run_kernel<Kernel, 1, 1>(args...);
+    }
+
+    template <class Kernel, class T, class... Args>
+    auto dispatch_kernel(true_type, const Args&... args) -> decltype(run_kernel<Kernel, 1, 1>(args...)) {
+        using traits = kernel_traits<T>;
+#if defined(META_TARGET)
+        switch (active_simd_isa()) {
+        case simd_isa::avx512:
+            return run_kernel_avx512<Kernel, traits::template lanes<simd_isa::avx512>::value,
+                traits::accumulators>(args...);
+        case simd_isa::avx2:
+            return run_kernel_avx2<Kernel, traits::template lanes<simd_isa::avx2>::value,
+                traits::accumulators>(args...);
+        case simd_isa::ssse3:
+            return run_kernel_ssse3<Kernel, traits::template lanes<simd_isa::ssse3>::value,
+                traits::accumulators>(args...);
+        default:
+            break;
+        }
+#endif
+        return run_kernel<Kernel, traits::template lanes<build_simd_isa>::value, traits::accumulators>(args...);
+    }
+}
+
+// Returns the sum of the n elements at p, T() when n is 0.
+template <class T>
+T sum(const T* p, size_t n) {
+    return detail::dispatch_kernel<detail::sum_kernel, T>(detail::is_vector_kernel<T>(), p, n);
+}
+
+// Returns the smallest of the n elements at p, T() when n is 0.
+template <class T>
+T min_value(const T* p, size_t n) {
+    return detail::dispatch_kernel<detail::extremum_kernel<false>, T>(detail::is_vector_kernel<T>(), p, n);
+}
+
+// Returns the largest of the n elements at p, T() when n is 0.
+template <class T>
+T max_value(const T* p, size_t n) {
+    return detail::dispatch_kernel<detail::extremum_kernel<true>, T>(detail::is_vector_kernel<T>(), p, n);
+}
+
+// Returns the sum of a[i] * b[i] over the n elements.
+template <class T>
+T dot(const T* a, const T* b, size_t n) {
+    return detail::dispatch_kernel<detail::dot_kernel, T>(detail::is_vector_kernel<T>(), a, b, n);
+}
+
+// y[i] = alpha * x[i] + y[i] for the n elements, x and y are the same array or
+// don't overlap.
+template <class T>
+void axpy(const T& alpha, const T* x, T* y, size_t n) {
+    detail::dispatch_kernel<detail::axpy_kernel, T>(detail::is_vector_kernel<T>(), alpha, x, y, n);
+}
+
+// out[i] is in[i] clamped to [lo, hi] for the n elements, lo must not be greater
+// than hi. in and out are the same array or don't overlap.
+template <class T>
+void clamp(const T* in, size_t n, const T& lo, const T& hi, T* out) {
+    detail::dispatch_kernel<detail::clamp_kernel, T>(detail::is_vector_kernel<T>(), in, n, lo, hi, out);
+}
+
+// out[i] is the sum of in[0..i] for the n elements (the inclusive scan), in and out
+// are the same array or don't overlap.
+template <class T>
+void prefix_sum(const T* in, size_t n, T* out) {
+    detail::dispatch_kernel<detail::prefix_sum_kernel, T>(detail::is_vector_kernel<T>(), in, n, out);
+}
+
+NS_META_END
+
+#endif /* kernels_h */
@@ -0,0 +1,52 @@
+//
+//  metaprogram.cppm
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+// The named module of the library, import metaprogram; gives the namespace of
+// metaprogram.h. Macros don't cross a module boundary: META_USE_BUILTINS is
+// fixed when the module is built, and NS_META_BEG/USE_META are not exported,
+// an importer writes using namespace metaprogram.
+// The module is experimental: gcc 12 stops with an internal compiler error on
+// it and no build imports it yet. An importer includes <new> before import
+// metaprogram;, the containers construct their elements with placement new and
+// gcc doesn't make the declaration of the global module fragment below
+// visible to the importers.
+//      #include <new>
+//      import metaprogram;
+module;
+
+// the standard headers go to the global module fragment, so they are not
+// attached to the module and the includes in the headers below are no-ops
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+export module metaprogram;
+
+export {
+#include "metaprogram.h"
+}
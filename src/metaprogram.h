@@ -0,0 +1,37 @@
+//
+//  metaprogram.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef metaprogram_h
+#define metaprogram_h
+
+// The whole library, for a precompiled header or the module interface
+// (metaprogram.cppm). The parts built on c++17 (reflect.h accessors,
+// soa_vector) are empty in a c++14 build.
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+#include "function_traits.h"
+#include "integer_sequence.h"
+#include "type_list.h"
+#include "type_id.h"
+#include "algorithm.h"
+#include "byte_order.h"
+#include "kernels.h"
+#include "array_view.h"
+#include "reflect.h"
+#include "serialize.h"
+#include "hash.h"
+#include "flat_hash_map.h"
+#include "static_map.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "arena.h"
+#include "object_pool.h"
+
+#endif /* metaprogram_h */
@@ -0,0 +1,299 @@
+//
+//  object_pool.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef object_pool_h
+#define object_pool_h
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_type.h"
+
+NS_META_BEG
+
+namespace detail {
+    template <size_t Value, size_t Multiple>
+    struct round_up : public integral_constant<size_t, (Value + Multiple - 1) / Multiple * Multiple> {};
+
+    template <size_t A, size_t B>
+    struct max_size : public integral_constant<size_t, (A < B ? B : A)> {};
+
+    // a free block, the link is kept in the block itself
+    struct pool_node {
+        pool_node* next;
+    };
+
+    // Implementation detail
+    // 1. The depot of a size class: the slabs the blocks are carved from and the
+    //      chains of free blocks given back by the thread caches, behind a mutex
+    //      which is only taken once per batch
+    // 2. It is never destroyed, so a thread cache can give its blocks back at
+    //      thread exit whatever the order of static destruction
+    class pool_depot {
+    public:
+        pool_depot(size_t block_size, size_t alignment, size_t batch_size) noexcept
+            : block_size_(block_size), alignment_(alignment), batch_size_(batch_size),
+              slab_size_(64 * 1024), current_(nullptr), end_(nullptr) {
+            while (slab_size_ < block_size * batch_size * 4) {
+                slab_size_ *= 2;
+            }
+        }
+
+        pool_depot(const pool_depot&) = delete;
+        pool_depot& operator=(const pool_depot&) = delete;
+
+        size_t batch_size() const noexcept {
+            return batch_size_;
+        }
+
+        // a chain of blocks, a free one if there is any, else batch_size blocks
+        // carved from the current slab, count is set to its length
+        pool_node* take_batch(size_t& count) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                const batch b = free_.back();
+                free_.pop_back();
+                count = b.count;
+                return b.first;
+            }
+            if (static_cast<size_t>(end_ - current_) < block_size_ * batch_size_) {
+                add_slab();
+            }
+            pool_node* first = reinterpret_cast<pool_node*>(current_);
+            for (size_t i = 1; i < batch_size_; ++i) {
+                reinterpret_cast<pool_node*>(current_)->next = reinterpret_cast<pool_node*>(current_ + block_size_);
+                current_ += block_size_;
+            }
+            reinterpret_cast<pool_node*>(current_)->next = nullptr;
+            current_ += block_size_;
+            count = batch_size_;
+            return first;
+        }
+
+        // takes back a chain of count blocks
+        void give_batch(pool_node* first, size_t count) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(batch{first, count});
+        }
+
+        size_t slab_count() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return slabs_.size();
+        }
+
+    private:
+        struct batch {
+            pool_node* first;
+            size_t count;
+        };
+
+        // the slab is over-allocated by the alignment, so the blocks of an
+        // over-aligned type can start on its alignment before c++17 aligned new
+        void add_slab() {
+            char* slab = static_cast<char*>(::operator new(slab_size_ + alignment_));
+            slabs_.push_back(slab);
+            const uintptr_t address = reinterpret_cast<uintptr_t>(slab);
+            current_ = slab + ((address + alignment_ - 1) & ~(alignment_ - 1)) - address;
+            end_ = current_ + slab_size_ / block_size_ * block_size_;
+        }
+
+        mutable std::mutex mutex_;
+        const size_t block_size_;
+        const size_t alignment_;
+        const size_t batch_size_;
+        size_t slab_size_;
+        char* current_;
+        char* end_;
+        std::vector<batch> free_;
+        std::vector<char*> slabs_;
+    };
+
+    // Implementation detail
+    // 1. The free blocks a thread keeps: it refills a batch from the depot when
+    //      it is empty and gives one back when it holds two
+    // 2. The second batch is kept apart, so giving it back doesn't walk the list
+    class pool_cache {
+    public:
+        explicit pool_cache(pool_depot& depot) noexcept
+            : depot_(depot), head_(nullptr), count_(0), spill_(nullptr), spill_count_(0) {}
+
+        pool_cache(const pool_cache&) = delete;
+        pool_cache& operator=(const pool_cache&) = delete;
+
+        // the spare batch, then the list, go back to the depot
+        ~pool_cache() {
+            spill();
+            spill();
+        }
+
+        META_ALWAYS_INLINE void* pop() {
+            if (head_ == nullptr) {
+                refill();
+            }
+            pool_node* node = head_;
+            head_ = node->next;
+            --count_;
+            return node;
+        }
+
+        META_ALWAYS_INLINE void push(void* p) noexcept {
+            if (count_ == depot_.batch_size()) {
+                spill();
+            }
+            pool_node* node = static_cast<pool_node*>(p);
+            node->next = head_;
+            head_ = node;
+            ++count_;
+        }
+
+    private:
+        void refill() {
+            if (spill_) {
+                head_ = spill_;
+                count_ = spill_count_;
+                spill_ = nullptr;
+                spill_count_ = 0;
+            } else {
+                head_ = depot_.take_batch(count_);
+            }
+        }
+
+        // the list becomes the spare batch and the previous spare goes to the
+        // depot; if the depot can't take it (bad_alloc), those blocks stay
+        // unused in their slab, so deallocate doesn't throw
+        void spill() noexcept {
+            if (spill_) {
+                try {
+                    depot_.give_batch(spill_, spill_count_);
+                } catch (...) {
+                }
+            }
+            spill_ = head_;
+            spill_count_ = count_;
+            head_ = nullptr;
+            count_ = 0;
+        }
+
+        pool_depot& depot_;
+        pool_node* head_;
+        size_t count_;
+        pool_node* spill_;
+        size_t spill_count_;
+    };
+
+    // The blocks of Size bytes aligned to Align, shared by every type of that layout.
+    template <size_t Size, size_t Align>
+    struct pool_size_class {
+        static constexpr size_t block_size = Size;
+        static constexpr size_t alignment = Align;
+        // about 4KiB of blocks per batch, between 8 and 256 of them
+        static constexpr size_t batch_size = Size * 256 <= 4096 ? 256 : Size * 8 >= 4096 ? 8 : 4096 / Size;
+
+        static pool_depot& depot() {
+            static pool_depot* d = new pool_depot(Size, Align, batch_size);
+            return *d;
+        }
+
+        static pool_cache& cache() {
+            static thread_local pool_cache c(depot());
+            return c;
+        }
+    };
+
+    template <size_t Size, size_t Align>
+    constexpr size_t pool_size_class<Size, Align>::block_size;
+
+    template <size_t Size, size_t Align>
+    constexpr size_t pool_size_class<Size, Align>::alignment;
+
+    template <size_t Size, size_t Align>
+    constexpr size_t pool_size_class<Size, Align>::batch_size;
+
+    template <class T>
+    using pool_size_class_of = pool_size_class<
+        round_up<max_size<sizeof(T), sizeof(pool_node)>::value,
+            max_size<alignof(T), alignof(pool_node)>::value>::value,
+        max_size<alignof(T), alignof(pool_node)>::value>;
+}
+
+/***************************** Object pool ********************************
+Fixed-size blocks for objects of T, recycled instead of going back to the
+heap. Types are grouped into size classes by sizeof and alignof, rounded up
+to hold the free-list link, so distinct types of the same layout share the
+same slabs. Every thread keeps a cache of free blocks for each size class,
+refilled and drained a batch at a time through a global depot, so the lock
+is taken once per batch rather than once per object.
+Example:
+    Order* order = object_pool<Order>::create(id, price);
+    object_pool<Order>::destroy(order);
+    static_assert(is_same<object_pool<Order>::size_class,
+        object_pool<Quote>::size_class>::value, "the same layout shares slabs");
+Implementation Note:
+1. A block can be destroyed on another thread than the one which created it,
+    it goes to the cache of the destroying thread
+2. destroy skips the destructor of a trivially destructible T, and the slabs
+    are never returned to the heap, the pool holds the high-water mark
+3. Abstract, function, reference and void types are rejected at compile time
+**************************************************************************/
+
+template <class T>
+class object_pool {
+    static_assert(!is_reference<T>::value, "object_pool<T>: T must not be a reference");
+    static_assert(!is_function<T>::value, "object_pool<T>: T must not be a function type");
+    static_assert(!is_void<T>::value, "object_pool<T>: T must not be void");
+    static_assert(!is_abstract<T>::value, "object_pool<T>: T must not be abstract");
+
+public:
+    using value_type = T;
+    using size_class = detail::pool_size_class_of<T>;
+
+    // an uninitialized block for a T
+    static void* allocate() {
+        return size_class::cache().pop();
+    }
+
+    static void deallocate(void* p) noexcept {
+        size_class::cache().push(p);
+    }
+
+    // a T constructed from args, the block is given back if the constructor throws
+    template <class... Args>
+    static T* create(Args&&... args) {
+        void* p = allocate();
+        try {
+            return ::new (p) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    static void destroy(T* p) noexcept {
+        if (p) {
+            destroy_object(p, is_trivially_destructible<T>());
+            deallocate(p);
+        }
+    }
+
+private:
+    static void destroy_object(T*, true_type) noexcept {}
+
+    static void destroy_object(T* p, false_type) noexcept {
+        p->~T();
+    }
+};
+
+NS_META_END
+
+#endif /* object_pool_h */
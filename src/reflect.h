@@ -0,0 +1,398 @@
+//
+//  reflect.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef reflect_h
+#define reflect_h
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+#include "type_list.h"
+
+NS_META_BEG
+
+/***************************** Aggregate reflection ***********************
+The fields of an aggregate class, without listing them:
+1. field_count<T> counts them by brace-initializing T from placeholders
+    which convert to anything, it only needs c++14
+2. fields_t<T>, get<I>(agg), for_each_field(agg, f) and apply_fields(agg, f)
+    bind them with a structured binding, so they need c++17. All of them
+    resolve at compile time, for_each_field inlines to one call per field
+Example:
+    struct Point { int x; float y; };
+    static_assert(field_count<Point>::value == 2, "");
+    static_assert(is_same<type_list<int, float>, fields_t<Point>>(), "");
+    Point p{1, 2.f};
+    get<1>(p) = 3.f;
+    for_each_field(p, [](auto& field) { std::cout << field; });
+Implementation Note:
+1. An array member is brace-initialized element by element (brace elision),
+    so it is counted once per element and the structured binding doesn't
+    compile. Neither does it for aggregates with base classes
+2. A member whose type has a constructor template taking anything (std::any,
+    std::optional<U>, ...) makes the placeholder ambiguous, so such a member
+    and the ones after it are not counted
+3. get and friends take lvalues, the fields of a const aggregate are const
+**************************************************************************/
+
+// The most fields get, for_each_field and apply_fields can bind, one structured
+// binding is written per count.
+META_INLINE_VAR constexpr size_t max_reflected_fields = 64;
+
+namespace detail {
+    // Converts to any field type, only used in unevaluated operands.
+    // Implementation detail
+    // 1. The placeholders are prvalues, so a field of value type takes the &&
+    //      qualified conversion. A non-const lvalue reference field can't bind
+    //      the value and takes the conversion to U&, gcc binds an rvalue
+    //      reference field only with the conversion to U&&
+    struct any_field {
+        template <class U>
+        constexpr operator U() const && noexcept;
+
+        template <class U>
+        constexpr operator U&() const & noexcept;
+
+        template <class U>
+        constexpr operator U&&() const & noexcept;
+    };
+
+    template <class T, class Is, class = void>
+    struct is_brace_constructible_from : public false_type {};
+
+    template <class T, size_t... Is>
+    struct is_brace_constructible_from<T, std::index_sequence<Is...>,
+        decltype((void)T{((void)Is, any_field{})...})> : public true_type {};
+
+    template <class T, size_t N>
+    using is_brace_constructible_n = is_brace_constructible_from<T, std::make_index_sequence<N>>;
+
+    // Implementation detail
+    // 1. T can be brace-initialized from N placeholders when N is at most the
+    //      field count and the fields after the N-th can be initialized from {},
+    //      so the N which work are a range ending at the count
+    // 2. least_field_count finds where the range starts counting up from 0, it
+    //      is 0 unless a field has no default constructor, and gives up (0) past
+    //      max_reflected_fields
+    // 3. grow_field_count doubles N from there until it fails, then
+    //      bisect_field_count searches [Lo, Hi] knowing Lo works. A probe costs N
+    //      conversions, so the count is found in O(count log count) and not
+    //      bounded by sizeof(T)
+    template <class T, size_t Lo, size_t Hi, bool = (Lo < Hi)>
+    struct bisect_field_count;
+
+    template <class T, size_t Lo, size_t Hi, size_t Mid, bool = is_brace_constructible_n<T, Mid>::value>
+    struct bisect_field_step : public bisect_field_count<T, Mid, Hi> {};
+
+    template <class T, size_t Lo, size_t Hi, size_t Mid>
+    struct bisect_field_step<T, Lo, Hi, Mid, false> : public bisect_field_count<T, Lo, Mid - 1> {};
+
+    template <class T, size_t Lo, size_t Hi, bool>
+    struct bisect_field_count : public bisect_field_step<T, Lo, Hi, Lo + (Hi - Lo + 1) / 2> {};
+
+    template <class T, size_t Lo, size_t Hi>
+    struct bisect_field_count<T, Lo, Hi, false> : public integral_constant<size_t, Lo> {};
+
+    template <class T, size_t N, bool = is_brace_constructible_n<T, N>::value>
+    struct grow_field_count : public grow_field_count<T, N * 2> {};
+
+    template <class T, size_t N>
+    struct grow_field_count<T, N, false> : public bisect_field_count<T, N / 2, N - 1> {};
+
+    template <class T, size_t N, bool = is_brace_constructible_n<T, N>::value, bool = (N < max_reflected_fields)>
+    struct least_field_count : public least_field_count<T, N + 1> {};
+
+    template <class T, size_t N, bool Searching>
+    struct least_field_count<T, N, true, Searching> : public integral_constant<size_t, N> {};
+
+    template <class T, size_t N>
+    struct least_field_count<T, N, false, false> : public integral_constant<size_t, 0> {};
+
+    template <class T, size_t Least = least_field_count<T, 0>::value>
+    struct search_field_count : public grow_field_count<T, Least * 2> {};
+
+    template <class T>
+    struct search_field_count<T, 0> : public grow_field_count<T, 1> {};
+
+    // Implementation detail
+    // 1. The probe is only run on aggregate classes, a class with an initializer
+    //      list constructor would take any number of placeholders. Without
+    //      is_aggregate (c++14 without the builtin) only classes are checked
+#if defined(META_BUILTIN_IS_AGGREGATE) || defined(__cpp_lib_is_aggregate)
+    template <class T>
+    struct is_aggregate_class : public conjunction<is_class<T>, is_aggregate<T>> {};
+#else
+    template <class T>
+    struct is_aggregate_class : public is_class<T> {};
+#endif
+
+    template <class T, bool = is_aggregate_class<T>::value>
+    struct count_fields : public search_field_count<T> {};
+
+    template <class T>
+    struct count_fields<T, false> : public integral_constant<size_t, 0> {};
+}
+
+// Provides the member constant value which is the number of fields of the
+// aggregate class T.
+template <class T>
+struct field_count : public detail::count_fields<remove_cv_t<T>> {
+    static_assert(detail::is_aggregate_class<T>::value, "field_count requires an aggregate class");
+};
+
+template <class T>
+META_INLINE_VAR constexpr size_t field_count_v = field_count<T>::value;
+
+#if defined(__cpp_structured_bindings)
+
+namespace detail {
+    // Implementation detail
+    // 1. bind_fields<N>::apply binds the N fields by reference and passes them
+    //      to f, one specialization per N. META_FIELDS_N is the list of names
+    template <size_t N>
+    struct bind_fields;
+
+    template <>
+    struct bind_fields<0> {
+        template <class T, class F>
+        static META_ALWAYS_INLINE decltype(auto) apply(T&, F&& f) {
+            return std::forward<F>(f)();
+        }
+    };
+
+#define META_FIELDS_1 f0
+#define META_FIELDS_2 META_FIELDS_1, f1
+#define META_FIELDS_3 META_FIELDS_2, f2
+#define META_FIELDS_4 META_FIELDS_3, f3
+#define META_FIELDS_5 META_FIELDS_4, f4
+#define META_FIELDS_6 META_FIELDS_5, f5
+#define META_FIELDS_7 META_FIELDS_6, f6
+#define META_FIELDS_8 META_FIELDS_7, f7
+#define META_FIELDS_9 META_FIELDS_8, f8
+#define META_FIELDS_10 META_FIELDS_9, f9
+#define META_FIELDS_11 META_FIELDS_10, f10
+#define META_FIELDS_12 META_FIELDS_11, f11
+#define META_FIELDS_13 META_FIELDS_12, f12
+#define META_FIELDS_14 META_FIELDS_13, f13
+#define META_FIELDS_15 META_FIELDS_14, f14
+#define META_FIELDS_16 META_FIELDS_15, f15
+#define META_FIELDS_17 META_FIELDS_16, f16
+#define META_FIELDS_18 META_FIELDS_17, f17
+#define META_FIELDS_19 META_FIELDS_18, f18
+#define META_FIELDS_20 META_FIELDS_19, f19
+#define META_FIELDS_21 META_FIELDS_20, f20
+#define META_FIELDS_22 META_FIELDS_21, f21
+#define META_FIELDS_23 META_FIELDS_22, f22
+#define META_FIELDS_24 META_FIELDS_23, f23
+#define META_FIELDS_25 META_FIELDS_24, f24
+#define META_FIELDS_26 META_FIELDS_25, f25
+#define META_FIELDS_27 META_FIELDS_26, f26
+#define META_FIELDS_28 META_FIELDS_27, f27
+#define META_FIELDS_29 META_FIELDS_28, f28
+#define META_FIELDS_30 META_FIELDS_29, f29
+#define META_FIELDS_31 META_FIELDS_30, f30
+#define META_FIELDS_32 META_FIELDS_31, f31
+#define META_FIELDS_33 META_FIELDS_32, f32
+#define META_FIELDS_34 META_FIELDS_33, f33
+#define META_FIELDS_35 META_FIELDS_34, f34
+#define META_FIELDS_36 META_FIELDS_35, f35
+#define META_FIELDS_37 META_FIELDS_36, f36
+#define META_FIELDS_38 META_FIELDS_37, f37
+#define META_FIELDS_39 META_FIELDS_38, f38
+#define META_FIELDS_40 META_FIELDS_39, f39
+#define META_FIELDS_41 META_FIELDS_40, f40
+#define META_FIELDS_42 META_FIELDS_41, f41
+#define META_FIELDS_43 META_FIELDS_42, f42
+#define META_FIELDS_44 META_FIELDS_43, f43
+#define META_FIELDS_45 META_FIELDS_44, f44
+#define META_FIELDS_46 META_FIELDS_45, f45
+#define META_FIELDS_47 META_FIELDS_46, f46
+#define META_FIELDS_48 META_FIELDS_47, f47
+#define META_FIELDS_49 META_FIELDS_48, f48
+#define META_FIELDS_50 META_FIELDS_49, f49
+#define META_FIELDS_51 META_FIELDS_50, f50
+#define META_FIELDS_52 META_FIELDS_51, f51
+#define META_FIELDS_53 META_FIELDS_52, f52
+#define META_FIELDS_54 META_FIELDS_53, f53
+#define META_FIELDS_55 META_FIELDS_54, f54
+#define META_FIELDS_56 META_FIELDS_55, f55
+#define META_FIELDS_57 META_FIELDS_56, f56
+#define META_FIELDS_58 META_FIELDS_57, f57
+#define META_FIELDS_59 META_FIELDS_58, f58
+#define META_FIELDS_60 META_FIELDS_59, f59
+#define META_FIELDS_61 META_FIELDS_60, f60
+#define META_FIELDS_62 META_FIELDS_61, f61
+#define META_FIELDS_63 META_FIELDS_62, f62
+#define META_FIELDS_64 META_FIELDS_63, f63
+
+#define META_BIND_FIELDS(N) \
+    template <> \
+    struct bind_fields<N> { \
+        template <class T, class F> \
+        static META_ALWAYS_INLINE decltype(auto) apply(T& agg, F&& f) { \
+            auto& [META_FIELDS_##N] = agg; \
+            return std::forward<F>(f)(META_FIELDS_##N); \
+        } \
+    };
+
+    META_BIND_FIELDS(1) META_BIND_FIELDS(2) META_BIND_FIELDS(3) META_BIND_FIELDS(4)
+    META_BIND_FIELDS(5) META_BIND_FIELDS(6) META_BIND_FIELDS(7) META_BIND_FIELDS(8)
+    META_BIND_FIELDS(9) META_BIND_FIELDS(10) META_BIND_FIELDS(11) META_BIND_FIELDS(12)
+    META_BIND_FIELDS(13) META_BIND_FIELDS(14) META_BIND_FIELDS(15) META_BIND_FIELDS(16)
+    META_BIND_FIELDS(17) META_BIND_FIELDS(18) META_BIND_FIELDS(19) META_BIND_FIELDS(20)
+    META_BIND_FIELDS(21) META_BIND_FIELDS(22) META_BIND_FIELDS(23) META_BIND_FIELDS(24)
+    META_BIND_FIELDS(25) META_BIND_FIELDS(26) META_BIND_FIELDS(27) META_BIND_FIELDS(28)
+    META_BIND_FIELDS(29) META_BIND_FIELDS(30) META_BIND_FIELDS(31) META_BIND_FIELDS(32)
+    META_BIND_FIELDS(33) META_BIND_FIELDS(34) META_BIND_FIELDS(35) META_BIND_FIELDS(36)
+    META_BIND_FIELDS(37) META_BIND_FIELDS(38) META_BIND_FIELDS(39) META_BIND_FIELDS(40)
+    META_BIND_FIELDS(41) META_BIND_FIELDS(42) META_BIND_FIELDS(43) META_BIND_FIELDS(44)
+    META_BIND_FIELDS(45) META_BIND_FIELDS(46) META_BIND_FIELDS(47) META_BIND_FIELDS(48)
+    META_BIND_FIELDS(49) META_BIND_FIELDS(50) META_BIND_FIELDS(51) META_BIND_FIELDS(52)
+    META_BIND_FIELDS(53) META_BIND_FIELDS(54) META_BIND_FIELDS(55) META_BIND_FIELDS(56)
+    META_BIND_FIELDS(57) META_BIND_FIELDS(58) META_BIND_FIELDS(59) META_BIND_FIELDS(60)
+    META_BIND_FIELDS(61) META_BIND_FIELDS(62) META_BIND_FIELDS(63) META_BIND_FIELDS(64)
+
+#undef META_BIND_FIELDS
+#undef META_FIELDS_1
+#undef META_FIELDS_2
+#undef META_FIELDS_3
+#undef META_FIELDS_4
+#undef META_FIELDS_5
+#undef META_FIELDS_6
+#undef META_FIELDS_7
+#undef META_FIELDS_8
+#undef META_FIELDS_9
+#undef META_FIELDS_10
+#undef META_FIELDS_11
+#undef META_FIELDS_12
+#undef META_FIELDS_13
+#undef META_FIELDS_14
+#undef META_FIELDS_15
+#undef META_FIELDS_16
+#undef META_FIELDS_17
+#undef META_FIELDS_18
+#undef META_FIELDS_19
+#undef META_FIELDS_20
+#undef META_FIELDS_21
+#undef META_FIELDS_22
+#undef META_FIELDS_23
+#undef META_FIELDS_24
+#undef META_FIELDS_25
+#undef META_FIELDS_26
+#undef META_FIELDS_27
+#undef META_FIELDS_28
+#undef META_FIELDS_29
+#undef META_FIELDS_30
+#undef META_FIELDS_31
+#undef META_FIELDS_32
+#undef META_FIELDS_33
+#undef META_FIELDS_34
+#undef META_FIELDS_35
+#undef META_FIELDS_36
+#undef META_FIELDS_37
+#undef META_FIELDS_38
+#undef META_FIELDS_39
+#undef META_FIELDS_40
+#undef META_FIELDS_41
+#undef META_FIELDS_42
+#undef META_FIELDS_43
+#undef META_FIELDS_44
+#undef META_FIELDS_45
+#undef META_FIELDS_46
+#undef META_FIELDS_47
+#undef META_FIELDS_48
+#undef META_FIELDS_49
+#undef META_FIELDS_50
+#undef META_FIELDS_51
+#undef META_FIELDS_52
+#undef META_FIELDS_53
+#undef META_FIELDS_54
+#undef META_FIELDS_55
+#undef META_FIELDS_56
+#undef META_FIELDS_57
+#undef META_FIELDS_58
+#undef META_FIELDS_59
+#undef META_FIELDS_60
+#undef META_FIELDS_61
+#undef META_FIELDS_62
+#undef META_FIELDS_63
+#undef META_FIELDS_64
+
+    template <class T>
+    struct reflected_field_count : public field_count<T> {
+        static_assert(field_count<T>::value <= max_reflected_fields,
+            "the aggregate has more fields than max_reflected_fields");
+    };
+
+    struct field_types_of {
+        template <class... Fs>
+        type_identity<type_list<Fs...>> operator()(Fs&...) const;
+    };
+
+    template <size_t I>
+    struct select_field {
+        template <class... Fs>
+        META_ALWAYS_INLINE auto& operator()(Fs&... fs) const noexcept {
+            return std::get<I>(std::tie(fs...));
+        }
+    };
+
+    template <class F>
+    struct visit_fields {
+        F& f;
+
+        template <class... Fs>
+        META_ALWAYS_INLINE void operator()(Fs&... fs) const {
+            (f(fs), ...);
+        }
+    };
+}
+
+// Calls f with every field of the aggregate agg, as lvalues in declaration order,
+// and returns what f returns.
+template <class T, class F>
+META_ALWAYS_INLINE decltype(auto) apply_fields(T& agg, F&& f) {
+    return detail::bind_fields<detail::reflected_field_count<T>::value>::apply(agg, std::forward<F>(f));
+}
+
+// Provides the member typedef type which is the type_list of the field types of
+// the aggregate T, with their cv-qualifiers. A reference member is listed as the
+// type it refers to.
+template <class T>
+struct fields : public decltype(apply_fields(std::declval<T&>(), detail::field_types_of())) {};
+
+template <class T>
+using fields_t = typename fields<T>::type;
+
+// The type of the I-th field of the aggregate T.
+template <class T, size_t I>
+using field_t = at_t<fields_t<T>, I>;
+
+// The I-th field of the aggregate agg.
+template <size_t I, class T>
+META_ALWAYS_INLINE auto& get(T& agg) noexcept {
+    static_assert(I < field_count<T>::value, "field index out of range");
+    return apply_fields(agg, detail::select_field<I>());
+}
+
+// Calls f(field) for every field of the aggregate agg, in declaration order.
+template <class T, class F>
+META_ALWAYS_INLINE void for_each_field(T& agg, F&& f) {
+    apply_fields(agg, detail::visit_fields<remove_reference_t<F>>{f});
+}
+
+#endif // __cpp_structured_bindings
+
+NS_META_END
+
+#endif /* reflect_h */
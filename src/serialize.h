@@ -0,0 +1,443 @@
+//
+//  serialize.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef serialize_h
+#define serialize_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+#include "array_view.h"
+#include "reflect.h"
+
+NS_META_BEG
+
+/***************************** Binary serialization ***********************
+serialize / deserialize a value to and from a caller-provided buffer. The
+encoding is picked at compile time from the type category, see
+serial_category_of:
+1. arithmetic types and enums (as their underlying type) are copied as is
+2. trivially copyable classes and arrays of bitwise types are one memcpy,
+    padding included
+3. contiguous containers (data(), operator[] and resize(), like std::vector,
+    std::string and small_vector) are a uint64_t count, then one memcpy of
+    the elements when they are bitwise, else the elements one by one. The
+    bulk elements are aligned to alignof(value_type) from the start of the
+    buffer, so a reader can view them in place
+4. other aggregate classes are their fields one by one, from c++17
+5. pointers are rejected, any other type must specialize serializer<T>
+Example:
+    struct Record { uint32_t id; std::string name; std::vector<float> samples; };
+    char buffer[4096];
+    buffer_writer writer(buffer, sizeof(buffer));
+    writer.write(record);
+    buffer_reader reader(buffer, writer.size());
+    uint32_t id;
+    reader.read(id);
+    array_view<const char> name = reader.read_view<char>();
+Implementation Note:
+1. The writer and reader are concrete classes and serializer<T> is resolved
+    at compile time, so a record is written without virtual calls. The
+    writer never allocates, when the buffer is too small it fails
+2. A failure is sticky: the writer or reader stops at the first one and
+    ok() is false, so a record is checked once and not field by field
+3. The bytes are in the host byte order and layout, the reader must be
+    built for the same ABI as the writer
+**************************************************************************/
+
+// The encodings, serial_category_of<T>::value is one of them.
+enum serial_category : unsigned {
+    serial_none,
+    serial_scalar,
+    serial_bitwise,
+    serial_array,
+    serial_range,
+    serial_fields,
+};
+
+// Checks whether T is written by copying its bytes: a trivially copyable type which
+// is not, and doesn't end in, a pointer. Specialize it to false_type for a trivially
+// copyable class which holds pointers or padding that shouldn't be written.
+template <class T>
+struct is_bitwise_serializable : public conjunction<is_trivially_copyable<T>,
+    negation<is_pointer<T>>, negation<is_member_pointer<T>>> {};
+
+template <class T, size_t N>
+struct is_bitwise_serializable<T[N]> : public is_bitwise_serializable<T> {};
+
+namespace detail {
+    template <class T, class = void>
+    struct is_contiguous_container : public false_type {};
+
+    template <class T>
+    struct is_contiguous_container<T, decltype((void)std::declval<T&>().resize(size_t()))>
+        : public bool_constant<is_same<decltype(std::declval<const T&>().data()), const typename T::value_type*>::value &&
+            is_same<decltype(std::declval<T&>()[0]), typename T::value_type&>::value> {};
+
+#if defined(__cpp_structured_bindings)
+    template <class T>
+    struct is_field_serializable : public is_aggregate_class<T> {};
+#else
+    template <class T>
+    struct is_field_serializable : public false_type {};
+#endif
+
+    // an enum is stored as its underlying type
+    template <class T, bool = is_enum<T>::value>
+    struct stored_type : public type_identity<T> {};
+
+    template <class T>
+    struct stored_type<T, true> : public type_identity<typename std::underlying_type<T>::type> {};
+}
+
+// Provides the member constant value which is the serial_category T is written as.
+template <class T>
+struct serial_category_of : public integral_constant<unsigned,
+    is_arithmetic<T>::value || is_enum<T>::value ? serial_scalar
+    : is_pointer<T>::value || is_member_pointer<T>::value ? serial_none
+    : is_bitwise_serializable<T>::value ? serial_bitwise
+    : is_array<T>::value ? serial_array
+    : detail::is_contiguous_container<T>::value ? serial_range
+    : detail::is_field_serializable<T>::value ? serial_fields
+    : serial_none> {};
+
+// Writes and reads a T, selected by its category. Specialize serializer<T> for a
+// type of category serial_none, with the members
+//      template <class Writer> static void write(Writer& writer, const T& value);
+//      template <class Reader> static void read(Reader& reader, T& value);
+// which call writer.write / reader.read for the parts of the value.
+template <class T, unsigned = serial_category_of<T>::value>
+struct serializer {
+    static_assert(serial_category_of<T>::value != serial_none,
+        "T can't be serialized, specialize metaprogram::serializer<T>");
+};
+
+template <class T>
+struct serializer<T, serial_scalar> {
+    using stored_type = typename detail::stored_type<T>::type;
+
+    template <class Writer>
+    static META_ALWAYS_INLINE void write(Writer& writer, const T& value) {
+        const stored_type stored = static_cast<stored_type>(value);
+        writer.write_bytes(&stored, sizeof(stored));
+    }
+
+    template <class Reader>
+    static META_ALWAYS_INLINE void read(Reader& reader, T& value) {
+        stored_type stored = stored_type();
+        reader.read_bytes(&stored, sizeof(stored));
+        value = static_cast<T>(stored);
+    }
+};
+
+template <class T>
+struct serializer<T, serial_bitwise> {
+    template <class Writer>
+    static META_ALWAYS_INLINE void write(Writer& writer, const T& value) {
+        writer.write_bytes(&value, sizeof(T));
+    }
+
+    template <class Reader>
+    static META_ALWAYS_INLINE void read(Reader& reader, T& value) {
+        reader.read_bytes(&value, sizeof(T));
+    }
+};
+
+template <class T, size_t N>
+struct serializer<T[N], serial_array> {
+    template <class Writer>
+    static void write(Writer& writer, const T (&value)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            writer.write(value[i]);
+        }
+    }
+
+    template <class Reader>
+    static void read(Reader& reader, T (&value)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            reader.read(value[i]);
+        }
+    }
+};
+
+template <class T>
+struct serializer<T, serial_range> {
+    using element_type = typename T::value_type;
+
+    template <class Writer>
+    static void write(Writer& writer, const T& value) {
+        const uint64_t count = static_cast<uint64_t>(value.size());
+        writer.write_bytes(&count, sizeof(count));
+        write_elements(writer, value.data(), value.size(), is_bitwise_serializable<element_type>());
+    }
+
+    template <class Reader>
+    static void read(Reader& reader, T& value) {
+        uint64_t count = 0;
+        reader.read_bytes(&count, sizeof(count));
+        read_elements(reader, value, count, is_bitwise_serializable<element_type>());
+    }
+
+private:
+    template <class Writer>
+    static void write_elements(Writer& writer, const element_type* data, size_t count, true_type) {
+        writer.align(alignof(element_type));
+        writer.write_bytes(data, count * sizeof(element_type));
+    }
+
+    template <class Writer>
+    static void write_elements(Writer& writer, const element_type* data, size_t count, false_type) {
+        for (size_t i = 0; i < count; ++i) {
+            writer.write(data[i]);
+        }
+    }
+
+    // the count is checked against the remaining input before resizing, so a
+    // corrupt count fails instead of allocating
+    template <class Reader>
+    static void read_elements(Reader& reader, T& value, uint64_t count, true_type) {
+        reader.align(alignof(element_type));
+        if (count > reader.remaining() / sizeof(element_type)) {
+            reader.fail();
+            return;
+        }
+        value.resize(static_cast<size_t>(count));
+        if (count != 0) {
+            reader.read_bytes(&value[0], value.size() * sizeof(element_type));
+        }
+    }
+
+    template <class Reader>
+    static void read_elements(Reader& reader, T& value, uint64_t count, false_type) {
+        if (count > reader.remaining()) {
+            reader.fail();
+            return;
+        }
+        value.resize(static_cast<size_t>(count));
+        for (size_t i = 0; i < value.size() && reader.ok(); ++i) {
+            reader.read(value[i]);
+        }
+    }
+};
+
+#if defined(__cpp_structured_bindings)
+template <class T>
+struct serializer<T, serial_fields> {
+    template <class Writer>
+    static void write(Writer& writer, const T& value) {
+        for_each_field(value, [&writer](const auto& field) { writer.write(field); });
+    }
+
+    template <class Reader>
+    static void read(Reader& reader, T& value) {
+        for_each_field(value, [&reader](auto& field) { reader.read(field); });
+    }
+};
+#endif
+
+// Writes into a caller-provided buffer, see the section comment.
+class buffer_writer {
+public:
+    buffer_writer(void* data, size_t capacity) noexcept
+        : data_(static_cast<unsigned char*>(data)), size_(0), capacity_(capacity), ok_(true) {}
+
+    template <class T>
+    META_ALWAYS_INLINE bool write(const T& value) {
+        serializer<T>::write(*this, value);
+        return ok_;
+    }
+
+    META_ALWAYS_INLINE bool write_bytes(const void* bytes, size_t count) noexcept {
+        if (count > capacity_ - size_) {
+            fail();
+            return false;
+        }
+        if (count != 0) {
+            std::memcpy(data_ + size_, bytes, count);
+        }
+        size_ += count;
+        return true;
+    }
+
+    // pads with zeros to a multiple of alignment, a power of two, from the start
+    bool align(size_t alignment) noexcept {
+        const size_t padding = (0 - size_) & (alignment - 1);
+        if (padding > capacity_ - size_) {
+            fail();
+            return false;
+        }
+        if (padding != 0) {
+            std::memset(data_ + size_, 0, padding);
+            size_ += padding;
+        }
+        return true;
+    }
+
+    // the capacity is cut to the size, so every later write fails too
+    void fail() noexcept {
+        capacity_ = size_;
+        ok_ = false;
+    }
+
+    // starts over at the beginning of the buffer
+    void reset() noexcept {
+        size_ = 0;
+        ok_ = true;
+    }
+
+    void reset(void* data, size_t capacity) noexcept {
+        data_ = static_cast<unsigned char*>(data);
+        capacity_ = capacity;
+        reset();
+    }
+
+    bool ok() const noexcept { return ok_; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    void* data() const noexcept { return data_; }
+
+private:
+    unsigned char* data_;
+    size_t size_;
+    size_t capacity_;
+    bool ok_;
+};
+
+// Counts the bytes buffer_writer would write, with the same interface.
+class size_writer {
+public:
+    size_writer() noexcept : size_(0) {}
+
+    template <class T>
+    META_ALWAYS_INLINE bool write(const T& value) {
+        serializer<T>::write(*this, value);
+        return true;
+    }
+
+    META_ALWAYS_INLINE bool write_bytes(const void*, size_t count) noexcept {
+        size_ += count;
+        return true;
+    }
+
+    bool align(size_t alignment) noexcept {
+        size_ += (0 - size_) & (alignment - 1);
+        return true;
+    }
+
+    void fail() noexcept {}
+
+    bool ok() const noexcept { return true; }
+    size_t size() const noexcept { return size_; }
+
+private:
+    size_t size_;
+};
+
+// Reads from a buffer, see the section comment. read_view returns the elements of
+// a container in place, without copying them.
+class buffer_reader {
+public:
+    buffer_reader(const void* data, size_t size) noexcept
+        : data_(static_cast<const unsigned char*>(data)), position_(0), size_(size), ok_(true) {}
+
+    template <class T>
+    META_ALWAYS_INLINE bool read(T& value) {
+        serializer<T>::read(*this, value);
+        return ok_;
+    }
+
+    META_ALWAYS_INLINE bool read_bytes(void* bytes, size_t count) noexcept {
+        const void* source = take(count);
+        if (source && count != 0) {
+            std::memcpy(bytes, source, count);
+        }
+        return source != nullptr;
+    }
+
+    // the next count bytes, nullptr if there are fewer left
+    META_ALWAYS_INLINE const void* take(size_t count) noexcept {
+        if (count > size_ - position_) {
+            fail();
+            return nullptr;
+        }
+        const unsigned char* bytes = data_ + position_;
+        position_ += count;
+        return bytes;
+    }
+
+    // the elements of a contiguous container of bitwise T, written by
+    // buffer_writer, pointing into the buffer. Fails when they are not aligned
+    // for T in memory, which can only be when the buffer itself isn't
+    template <class T>
+    array_view<const T> read_view() noexcept {
+        static_assert(is_bitwise_serializable<T>::value, "read_view requires a bitwise serializable type");
+        uint64_t count = 0;
+        if (!read_bytes(&count, sizeof(count)) || !align(alignof(T)) || count > remaining() / sizeof(T) ||
+            reinterpret_cast<uintptr_t>(data_ + position_) % alignof(T) != 0) {
+            fail();
+            return array_view<const T>();
+        }
+        const T* elements = static_cast<const T*>(take(static_cast<size_t>(count) * sizeof(T)));
+        return array_view<const T>(elements, static_cast<size_t>(count));
+    }
+
+    bool align(size_t alignment) noexcept {
+        return take((0 - position_) & (alignment - 1)) != nullptr;
+    }
+
+    // the size is cut to the position, so every later read fails too
+    void fail() noexcept {
+        size_ = position_;
+        ok_ = false;
+    }
+
+    bool ok() const noexcept { return ok_; }
+    size_t position() const noexcept { return position_; }
+    size_t remaining() const noexcept { return size_ - position_; }
+
+private:
+    const unsigned char* data_;
+    size_t position_;
+    size_t size_;
+    bool ok_;
+};
+
+// The number of bytes value is serialized to.
+template <class T>
+size_t serialized_size(const T& value) {
+    size_writer writer;
+    writer.write(value);
+    return writer.size();
+}
+
+// Serializes value to the buffer, returns the bytes written, or 0 if the buffer is
+// too small.
+template <class T>
+size_t serialize(const T& value, void* data, size_t capacity) {
+    buffer_writer writer(data, capacity);
+    return writer.write(value) ? writer.size() : 0;
+}
+
+// Deserializes value from the buffer, returns false if the input is truncated or
+// corrupt, value is then partially read.
+template <class T>
+bool deserialize(const void* data, size_t size, T& value) {
+    buffer_reader reader(data, size);
+    return reader.read(value);
+}
+
+NS_META_END
+
+#endif /* serialize_h */
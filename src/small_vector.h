@@ -0,0 +1,367 @@
+//
+//  small_vector.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef small_vector_h
+#define small_vector_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_type.h"
+#include "algorithm.h"
+
+NS_META_BEG
+
+namespace detail {
+    // Implementation detail
+    // 1. The inline buffer, there is none when N is 0, so small_vector<T, 0>
+    //      is a plain vector with relocating growth
+    template <class T, size_t N>
+    struct small_vector_storage {
+        T* inline_data() noexcept { return reinterpret_cast<T*>(buffer); }
+        const T* inline_data() const noexcept { return reinterpret_cast<const T*>(buffer); }
+
+        alignas(T) unsigned char buffer[N * sizeof(T)];
+    };
+
+    template <class T>
+    struct small_vector_storage<T, 0> {
+        T* inline_data() noexcept { return nullptr; }
+        const T* inline_data() const noexcept { return nullptr; }
+    };
+}
+
+// A vector which keeps up to N elements in place and moves to the heap beyond.
+// Growth, insert and erase relocate the elements: when is_trivially_relocatable<T>
+// holds that is a memcpy/memmove of the bytes instead of a move construction and
+// a destruction per element.
+// Example:
+//      small_vector<std::unique_ptr<Foo>, 8> v;    // no allocation up to 8 elements
+//      v.erase(v.begin() + 2);                     // one memmove
+// Implementation Note:
+// 1. The iterators are pointers, they are invalidated as in std::vector, and
+//      also by moving a small_vector whose elements are inline
+// 2. emplace and a growing emplace_back construct the new element before the
+//      elements are relocated, so the arguments can refer to the elements
+template <class T, size_t N>
+class small_vector : private detail::small_vector_storage<T, N> {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    small_vector() noexcept : data_(this->inline_data()), size_(0), capacity_(N) {}
+
+    explicit small_vector(size_type count) : small_vector() {
+        resize(count);
+    }
+
+    small_vector(size_type count, const T& value) : small_vector() {
+        resize(count, value);
+    }
+
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    small_vector(InputIt first, InputIt last) : small_vector() {
+        append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+
+    small_vector(std::initializer_list<T> init) : small_vector(init.begin(), init.end()) {}
+
+    small_vector(const small_vector& other) : small_vector(other.begin(), other.end()) {}
+
+    small_vector(small_vector&& other) noexcept(is_nothrow_relocate) : small_vector() {
+        take(other);
+    }
+
+    ~small_vector() {
+        metaprogram::destroy(begin(), end());
+        deallocate();
+    }
+
+    small_vector& operator=(const small_vector& other) {
+        if (this != &other) {
+            clear();
+            append(other.begin(), other.end(), std::random_access_iterator_tag());
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(is_nothrow_relocate) {
+        if (this != &other) {
+            clear();
+            if (!other.is_inline()) {
+                deallocate();
+                data_ = this->inline_data();
+                capacity_ = N;
+            }
+            take(other);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<T> init) {
+        clear();
+        append(init.begin(), init.end(), std::random_access_iterator_tag());
+        return *this;
+    }
+
+    iterator begin() noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    // true while the elements are in the inline buffer
+    bool is_inline() const noexcept { return data_ == this->inline_data(); }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    reference operator[](size_type pos) noexcept { return data_[pos]; }
+    const_reference operator[](size_type pos) const noexcept { return data_[pos]; }
+
+    reference at(size_type pos) {
+        if (pos >= size_) {
+            throw std::out_of_range("small_vector::at");
+        }
+        return data_[pos];
+    }
+
+    const_reference at(size_type pos) const {
+        return const_cast<small_vector*>(this)->at(pos);
+    }
+
+    reference front() noexcept { return data_[0]; }
+    const_reference front() const noexcept { return data_[0]; }
+    reference back() noexcept { return data_[size_ - 1]; }
+    const_reference back() const noexcept { return data_[size_ - 1]; }
+
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity_) {
+            reallocate(new_capacity);
+        }
+    }
+
+    void clear() noexcept {
+        metaprogram::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            T value(std::forward<Args>(args)...);
+            reallocate(grown_capacity(size_ + 1));
+            ::new (static_cast<void*>(data_ + size_)) T(std::move(value));
+        } else {
+            ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        --size_;
+        data_[size_].~T();
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const size_type index = static_cast<size_type>(pos - data_);
+        if (index == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return data_ + index;
+        }
+        T value(std::forward<Args>(args)...);
+        if (size_ == capacity_) {
+            reallocate(grown_capacity(size_ + 1));
+        }
+        insert_gap(index, value, bool_constant<is_trivially_relocatable<T>::value>());
+        return data_ + index;
+    }
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        iterator it = data_ + (first - data_);
+        const size_type count = static_cast<size_type>(last - first);
+        if (count != 0) {
+            erase_range(it, count, bool_constant<is_trivially_relocatable<T>::value>());
+        }
+        return it;
+    }
+
+    void resize(size_type count) {
+        if (count <= size_) {
+            shrink(count);
+            return;
+        }
+        reserve(count);
+        metaprogram::uninitialized_value_construct(end(), data_ + count);
+        size_ = count;
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count <= size_) {
+            shrink(count);
+            return;
+        }
+        // value may be an element which reserve relocates
+        const T copy(value);
+        reserve(count);
+        std::uninitialized_fill(end(), data_ + count, copy);
+        size_ = count;
+    }
+
+    friend bool operator==(const small_vector& lhs, const small_vector& rhs) {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const small_vector& lhs, const small_vector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    // relocation moves, or copies when the move may throw
+    static constexpr bool is_nothrow_relocate =
+        disjunction<is_trivially_relocatable<T>, std::is_nothrow_move_constructible<T>>::value;
+
+    size_type grown_capacity(size_type required) const noexcept {
+        return std::max(required, capacity_ * 2);
+    }
+
+    void reallocate(size_type new_capacity) {
+        T* new_data = std::allocator<T>().allocate(new_capacity);
+        try {
+            metaprogram::uninitialized_relocate(begin(), end(), new_data);
+        } catch (...) {
+            std::allocator<T>().deallocate(new_data, new_capacity);
+            throw;
+        }
+        deallocate();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    void deallocate() noexcept {
+        if (!is_inline()) {
+            std::allocator<T>().deallocate(data_, capacity_);
+        }
+    }
+
+    // steals the heap buffer of other, or relocates its inline elements into
+    // this, which is empty and has room for N elements
+    void take(small_vector& other) noexcept(is_nothrow_relocate) {
+        if (other.is_inline()) {
+            metaprogram::uninitialized_relocate(other.begin(), other.end(), data_);
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    template <class InputIt>
+    void append(InputIt first, InputIt last, std::input_iterator_tag) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    template <class ForwardIt>
+    void append(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+        reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+        size_ = static_cast<size_type>(metaprogram::uninitialized_copy(first, last, end()) - data_);
+    }
+
+    void shrink(size_type count) noexcept {
+        metaprogram::destroy(data_ + count, end());
+        size_ = count;
+    }
+
+    // Implementation detail
+    // 1. Moves [index, size) one slot up and moves value into the gap, there
+    //      is room for one more element
+    // 2. A trivially relocatable range moves up with one memmove, if the
+    //      construction in the gap throws it moves back
+    void insert_gap(size_type index, T& value, true_type) {
+        T* pos = data_ + index;
+        const size_t bytes = (size_ - index) * sizeof(T);
+        std::memmove(static_cast<void*>(pos + 1), static_cast<const void*>(pos), bytes);
+        try {
+            ::new (static_cast<void*>(pos)) T(std::move(value));
+        } catch (...) {
+            std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos + 1), bytes);
+            throw;
+        }
+        ++size_;
+    }
+
+    void insert_gap(size_type index, T& value, false_type) {
+        ::new (static_cast<void*>(end())) T(std::move(back()));
+        ++size_;
+        std::move_backward(data_ + index, end() - 2, end() - 1);
+        data_[index] = std::move(value);
+    }
+
+    void erase_range(iterator it, size_type count, true_type) {
+        metaprogram::destroy(it, it + count);
+        std::memmove(static_cast<void*>(it), static_cast<const void*>(it + count),
+            static_cast<size_t>(end() - (it + count)) * sizeof(T));
+        size_ -= count;
+    }
+
+    void erase_range(iterator it, size_type count, false_type) {
+        shrink(static_cast<size_type>(std::move(it + count, end(), it) - data_));
+    }
+
+    T* data_;
+    size_type size_;
+    size_type capacity_;
+};
+
+template <class T, size_t N>
+constexpr bool small_vector<T, N>::is_nothrow_relocate;
+
+NS_META_END
+
+#endif /* small_vector_h */
@@ -0,0 +1,423 @@
+//
+//  soa_vector.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef soa_vector_h
+#define soa_vector_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+#include "type_list.h"
+#include "algorithm.h"
+#include "array_view.h"
+#include "reflect.h"
+
+NS_META_BEG
+
+#if defined(__cpp_structured_bindings)
+
+/***************************** Struct of arrays ***************************
+soa_vector<T> stores the aggregate T as one contiguous column per field, the
+fields are found by reflect.h, so T is declared as usual and nothing lists
+its members. A loop reading one or two fields walks only their columns:
+column<I>() is an array_view of the I-th field of every row, each column
+starts on column_alignment bytes for aligned vector loads.
+Rows are proxies: v[i] and *it are soa_row, which reads and writes the
+fields in place, converts to T and binds with a structured binding.
+Example:
+    struct Trade { uint64_t id; double price; double quantity; };
+    soa_vector<Trade> trades;
+    trades.push_back(Trade{1, 10.5, 100});
+    trades.emplace_back(2, 11.0, 50);
+    double total = 0;
+    for (double price : trades.column<1>()) { total += price; }
+    for (auto [id, price, quantity] : trades) { quantity *= 2; }
+    Trade t = trades[0];
+Implementation Note:
+1. It needs c++17 as the field accessors of reflect.h do
+2. The field types must be nothrow movable, so growth can relocate the
+    columns one after the other without a partial state to undo
+3. A column holds the field type without cv-qualifiers, a reference field
+    is stored as the type it refers to
+**************************************************************************/
+
+template <class T>
+class soa_vector;
+
+// A row of a soa_vector (V) or of a const soa_vector (const V), by reference.
+template <class V>
+class soa_row {
+public:
+    using value_type = typename remove_cv_t<V>::value_type;
+
+    soa_row(V& v, size_t index) noexcept : v_(&v), index_(index) {}
+
+    soa_row(const soa_row&) = default;
+
+    // assigns the fields, not the reference
+    soa_row& operator=(const soa_row& other) {
+        return *this = static_cast<value_type>(other);
+    }
+
+    soa_row& operator=(const value_type& value) {
+        apply_fields(value, [this](const auto&... fs) { assign(std::index_sequence_for<decltype(fs)...>(), fs...); });
+        return *this;
+    }
+
+    soa_row& operator=(value_type&& value) {
+        apply_fields(value, [this](auto&... fs) { assign(std::index_sequence_for<decltype(fs)...>(), std::move(fs)...); });
+        return *this;
+    }
+
+    // the I-th field
+    template <size_t I>
+    auto& get() const noexcept {
+        return v_->template column<I>()[index_];
+    }
+
+    // a copy of the row
+    operator value_type() const {
+        return load(std::make_index_sequence<remove_cv_t<V>::column_count>());
+    }
+
+    size_t index() const noexcept {
+        return index_;
+    }
+
+private:
+    template <size_t... Is>
+    value_type load(std::index_sequence<Is...>) const {
+        return value_type{get<Is>()...};
+    }
+
+    template <size_t... Is, class... Fs>
+    void assign(std::index_sequence<Is...>, Fs&&... fs) {
+        ((get<Is>() = std::forward<Fs>(fs)), ...);
+    }
+
+    V* v_;
+    size_t index_;
+};
+
+// A random access iterator over the rows of a soa_vector, *it is a soa_row.
+template <class V>
+class soa_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename remove_cv_t<V>::value_type;
+    using difference_type = ptrdiff_t;
+    using reference = soa_row<V>;
+    using pointer = void;
+
+    soa_iterator() noexcept : v_(nullptr), index_(0) {}
+    soa_iterator(V* v, size_t index) noexcept : v_(v), index_(index) {}
+
+    reference operator*() const noexcept { return reference(*v_, index_); }
+    reference operator[](difference_type n) const noexcept { return reference(*v_, index_ + n); }
+
+    soa_iterator& operator++() noexcept { ++index_; return *this; }
+    soa_iterator& operator--() noexcept { --index_; return *this; }
+    soa_iterator operator++(int) noexcept { soa_iterator it = *this; ++index_; return it; }
+    soa_iterator operator--(int) noexcept { soa_iterator it = *this; --index_; return it; }
+    soa_iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+    soa_iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+
+    friend soa_iterator operator+(soa_iterator it, difference_type n) noexcept { return it += n; }
+    friend soa_iterator operator+(difference_type n, soa_iterator it) noexcept { return it += n; }
+    friend soa_iterator operator-(soa_iterator it, difference_type n) noexcept { return it -= n; }
+    friend difference_type operator-(const soa_iterator& lhs, const soa_iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const soa_iterator& lhs, const soa_iterator& rhs) noexcept { return lhs.index_ == rhs.index_; }
+    friend bool operator!=(const soa_iterator& lhs, const soa_iterator& rhs) noexcept { return lhs.index_ != rhs.index_; }
+    friend bool operator<(const soa_iterator& lhs, const soa_iterator& rhs) noexcept { return lhs.index_ < rhs.index_; }
+    friend bool operator>(const soa_iterator& lhs, const soa_iterator& rhs) noexcept { return rhs < lhs; }
+    friend bool operator<=(const soa_iterator& lhs, const soa_iterator& rhs) noexcept { return !(rhs < lhs); }
+    friend bool operator>=(const soa_iterator& lhs, const soa_iterator& rhs) noexcept { return !(lhs < rhs); }
+
+private:
+    V* v_;
+    size_t index_;
+};
+
+template <class T>
+class soa_vector {
+    static_assert(is_class<T>::value, "soa_vector<T>: T must be an aggregate class");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = soa_row<soa_vector>;
+    using const_reference = soa_row<const soa_vector>;
+    using iterator = soa_iterator<soa_vector>;
+    using const_iterator = soa_iterator<const soa_vector>;
+
+    // The column types, the field types of T without cv-qualifiers.
+    using column_types = transform_t<fields_t<T>, remove_cv>;
+
+    template <size_t I>
+    using column_type = at_t<column_types, I>;
+
+    static constexpr size_t column_count = field_count<T>::value;
+    // a cache line, and the widest vector register
+    static constexpr size_t column_alignment = 64;
+
+    static_assert(column_count > 0, "soa_vector<T>: T has no fields");
+
+    soa_vector() noexcept : block_(nullptr), size_(0), capacity_(0), columns_() {}
+
+    soa_vector(const soa_vector& other) : soa_vector() {
+        reserve(other.size_);
+        size_t copied = 0;
+        try {
+            for_each_column([&](auto i) {
+                constexpr size_t I = decltype(i)::value;
+                metaprogram::uninitialized_copy(other.data<I>(), other.data<I>() + other.size_, data<I>());
+                ++copied;
+            });
+        } catch (...) {
+            for_each_column([&](auto i) {
+                constexpr size_t I = decltype(i)::value;
+                if (I < copied) {
+                    metaprogram::destroy(data<I>(), data<I>() + other.size_);
+                }
+            });
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    soa_vector(soa_vector&& other) noexcept : soa_vector() {
+        swap(other);
+    }
+
+    soa_vector& operator=(const soa_vector& other) {
+        if (this != &other) {
+            soa_vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    soa_vector& operator=(soa_vector&& other) noexcept {
+        soa_vector moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~soa_vector() {
+        clear();
+        ::operator delete(block_);
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_t capacity() const noexcept { return capacity_; }
+
+    reference operator[](size_t pos) noexcept { return reference(*this, pos); }
+    const_reference operator[](size_t pos) const noexcept { return const_reference(*this, pos); }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size_); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, size_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // the I-th field of every row
+    template <size_t I>
+    array_view<column_type<I>> column() noexcept {
+        return array_view<column_type<I>>(data<I>(), size_);
+    }
+
+    template <size_t I>
+    array_view<const column_type<I>> column() const noexcept {
+        return array_view<const column_type<I>>(data<I>(), size_);
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            std::array<void*, column_count> columns;
+            void* block = allocate_columns(capacity, columns);
+            adopt(block, columns, capacity);
+        }
+    }
+
+    void push_back(const T& value) {
+        apply_fields(value, [this](const auto&... fs) { emplace_back(fs...); });
+    }
+
+    void push_back(T&& value) {
+        apply_fields(value, [this](auto&... fs) { emplace_back(std::move(fs)...); });
+    }
+
+    // appends a row whose I-th field is constructed from the I-th argument; when
+    // the columns grow the row is constructed first, so the arguments can refer
+    // to the rows
+    template <class... Args>
+    reference emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == column_count, "soa_vector::emplace_back takes one argument per field");
+        if (size_ == capacity_) {
+            const size_t capacity = capacity_ ? capacity_ * 2 : 16;
+            std::array<void*, column_count> columns;
+            void* block = allocate_columns(capacity, columns);
+            try {
+                construct_row(std::index_sequence_for<Args...>(), columns, size_, std::forward<Args>(args)...);
+            } catch (...) {
+                ::operator delete(block);
+                throw;
+            }
+            adopt(block, columns, capacity);
+        } else {
+            construct_row(std::index_sequence_for<Args...>(), columns_, size_, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return reference(*this, size_ - 1);
+    }
+
+    void pop_back() noexcept {
+        --size_;
+        for_each_column([this](auto i) {
+            constexpr size_t I = decltype(i)::value;
+            metaprogram::destroy(data<I>() + size_, data<I>() + size_ + 1);
+        });
+    }
+
+    void clear() noexcept {
+        for_each_column([this](auto i) {
+            constexpr size_t I = decltype(i)::value;
+            metaprogram::destroy(data<I>(), data<I>() + size_);
+        });
+        size_ = 0;
+    }
+
+    void swap(soa_vector& other) noexcept {
+        std::swap(block_, other.block_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(columns_, other.columns_);
+    }
+
+private:
+    template <class F, size_t... Is>
+    static void for_each_column(F& f, std::index_sequence<Is...>) {
+        (f(integral_constant<size_t, Is>()), ...);
+    }
+
+    // calls f(integral_constant<size_t, I>()) for every column I
+    template <class F>
+    static void for_each_column(F&& f) {
+        for_each_column(f, std::make_index_sequence<column_count>());
+    }
+
+    template <size_t I>
+    column_type<I>* data() const noexcept {
+        return static_cast<column_type<I>*>(columns_[I]);
+    }
+
+    static size_t column_bytes(size_t capacity, size_t size) noexcept {
+        return (capacity * size + column_alignment - 1) & ~(column_alignment - 1);
+    }
+
+    // one block for all the columns, each of them aligned
+    static void* allocate_columns(size_t capacity, std::array<void*, column_count>& columns) {
+        size_t bytes = column_alignment;
+        for_each_column([&](auto i) {
+            using U = column_type<decltype(i)::value>;
+            static_assert(alignof(U) <= column_alignment, "soa_vector<T>: a field is over-aligned");
+            static_assert(disjunction<is_trivially_relocatable<U>, std::is_nothrow_move_constructible<U>>::value,
+                "soa_vector<T>: the fields must be nothrow movable");
+            bytes += column_bytes(capacity, sizeof(U));
+        });
+        char* block = static_cast<char*>(::operator new(bytes));
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block);
+        char* next = block + ((address + column_alignment - 1) & ~(column_alignment - 1)) - address;
+        for_each_column([&](auto i) {
+            columns[decltype(i)::value] = next;
+            next += column_bytes(capacity, sizeof(column_type<decltype(i)::value>));
+        });
+        return block;
+    }
+
+    // relocates the rows into the columns of block and frees the old block
+    void adopt(void* block, const std::array<void*, column_count>& columns, size_t capacity) noexcept {
+        for_each_column([&](auto i) {
+            constexpr size_t I = decltype(i)::value;
+            metaprogram::uninitialized_relocate(data<I>(), data<I>() + size_, static_cast<column_type<I>*>(columns[I]));
+        });
+        ::operator delete(block_);
+        block_ = block;
+        columns_ = columns;
+        capacity_ = capacity;
+    }
+
+    // constructs the fields of row pos, the ones constructed are destroyed if one throws
+    template <size_t... Is, class... Args>
+    static void construct_row(std::index_sequence<Is...>, const std::array<void*, column_count>& columns, size_t pos,
+                              Args&&... args) {
+        size_t constructed = 0;
+        try {
+            ((::new (static_cast<void*>(static_cast<column_type<Is>*>(columns[Is]) + pos))
+                column_type<Is>(std::forward<Args>(args)), ++constructed), ...);
+        } catch (...) {
+            ((Is < constructed ? metaprogram::destroy(static_cast<column_type<Is>*>(columns[Is]) + pos,
+                static_cast<column_type<Is>*>(columns[Is]) + pos + 1) : void()), ...);
+            throw;
+        }
+    }
+
+    void* block_;
+    size_t size_;
+    size_t capacity_;
+    std::array<void*, column_count> columns_;
+};
+
+template <class T>
+constexpr size_t soa_vector<T>::column_count;
+
+template <class T>
+constexpr size_t soa_vector<T>::column_alignment;
+
+#endif // __cpp_structured_bindings
+
+NS_META_END
+
+#if defined(__cpp_structured_bindings)
+
+// a row binds as its fields: auto [id, price] = v[i];
+namespace std {
+    template <class V>
+    struct tuple_size<metaprogram::soa_row<V>>
+        : public integral_constant<size_t, metaprogram::remove_cv_t<V>::column_count> {};
+
+    template <size_t I, class V>
+    struct tuple_element<I, metaprogram::soa_row<V>> {
+        using type = typename V::template column_type<I>;
+    };
+
+    template <size_t I, class V>
+    struct tuple_element<I, metaprogram::soa_row<const V>> {
+        using type = const typename V::template column_type<I>;
+    };
+}
+
+#endif
+
+#endif /* soa_vector_h */
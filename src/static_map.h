@@ -0,0 +1,375 @@
+//
+//  static_map.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef static_map_h
+#define static_map_h
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+#include "type_traits_type.h"
+#include "integer_sequence.h"
+#include "hash.h"
+
+NS_META_BEG
+
+/***************************** Static map *********************************
+static_map<Key, Value, N> is a constant map of N entries known at compile
+time. Its perfect hash is found during constant evaluation: every key has a
+slot of its own, so a lookup is one hash of the key, one slot read and one
+key compare, and never probes. make_static_map builds it from an array of
+key/value pairs. The keys are the ones of static_map_key:
+1. integral types and enums, compared with ==
+2. strings: ranges of char with data() and size(), like std::string_view and
+    array_view<const char>. A lookup takes any of them, a std::string looks
+    up a std::string_view key without a conversion
+Any other key type must specialize static_map_key<T>.
+Example:
+    constexpr auto verbs = make_static_map<std::string_view, int>({
+        {"GET", 1}, {"PUT", 2}, {"POST", 3}, {"DELETE", 4},
+    });
+    static_assert(verbs.at("PUT") == 2, "");
+    auto it = verbs.find(request.verb);     // verbs.end() when it's no verb
+Implementation Note:
+1. The perfect hash is CHD: the keys are split by hash into buckets of 4 on
+    average, and each bucket, the largest first, gets the smallest pilot
+    which maps its keys to free slots. The slot of a key is
+    ((hash ^ pilot * k1) * k2) >> shift, the slots are a power of two at
+    least 5/4 of the keys
+2. The slots hold the positions of the entries, in the smallest unsigned
+    type for N. The free slots refer to entry 0, a missing key which hashes
+    there fails the key compare like any other
+3. Duplicate keys are an error: in a constant expression the construction
+    doesn't compile, at runtime it throws std::invalid_argument
+4. The hash of static_map_key is its own constexpr hash, not hash<T>, and a
+    table built by one compiler or version of the library is not a table of
+    another: don't store the slots
+**************************************************************************/
+
+// The keys static_map_key supports, static_key_category_of<T>::value is one of them.
+enum static_key_category : unsigned {
+    static_key_none,
+    static_key_integral,
+    static_key_string,
+};
+
+namespace detail {
+    template <class T, bool = is_contiguous_range<T>::value>
+    struct is_string_key : public false_type {};
+
+    template <class T>
+    struct is_string_key<T, true> : public is_same<range_element_t<T>, char> {};
+}
+
+template <class T>
+struct static_key_category_of : public integral_constant<unsigned,
+    (is_integral<T>::value || is_enum<T>::value) ? static_key_integral
+    : detail::is_string_key<T>::value ? static_key_string
+    : static_key_none> {};
+
+namespace detail {
+    // murmur3 fmix64, every input bit flips about half of the output bits
+    constexpr uint64_t static_hash_mix(uint64_t h) noexcept {
+        h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdull;
+        h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53ull;
+        return h ^ (h >> 33);
+    }
+
+    // N bytes, little endian whatever the host is, which the compiler turns
+    // into one load at runtime
+    template <size_t N>
+    constexpr uint64_t static_hash_read(const char* p) noexcept {
+        uint64_t word = 0;
+        for (size_t i = 0; i < N; ++i) {
+            word |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+        }
+        return word;
+    }
+
+    // Implementation detail
+    // 1. The reads have a fixed size, the last word of a string overlaps the
+    //      one before it and strings shorter than 8 bytes are read as two
+    //      overlapping halves (wyhash does the same), so there is no loop over
+    //      the bytes of the tail
+    // 2. Every word step is a bijection of the state and the length is in the
+    //      seed, the hashes of distinct keys collide like random 64-bit values
+    constexpr uint64_t static_hash_string(const char* p, size_t n) noexcept {
+        uint64_t h = n * 0x9e3779b97f4a7c15ull;
+        uint64_t last = 0;
+        if (n > 8) {
+            for (size_t i = 0; i + 8 < n; i += 8) {
+                h = (h ^ static_hash_read<8>(p + i)) * 0xbf58476d1ce4e5b9ull;
+                h ^= h >> 31;
+            }
+            last = static_hash_read<8>(p + n - 8);
+        } else if (n >= 4) {
+            last = (static_hash_read<4>(p) << 32) | static_hash_read<4>(p + n - 4);
+        } else if (n > 0) {
+            last = (static_hash_read<1>(p) << 16) | (static_hash_read<1>(p + n / 2) << 8) |
+                static_hash_read<1>(p + n - 1);
+        }
+        return static_hash_mix(h ^ last);
+    }
+}
+
+// The constexpr hash and equality static_map uses for keys of type T.
+// Specialize it for another key type, with
+//      static constexpr uint64_t hash(const T& key);
+//      static constexpr bool equal(const T& lhs, const T& rhs);
+template <class T, unsigned = static_key_category_of<T>::value>
+struct static_map_key {
+    static_assert(static_key_category_of<T>::value != static_key_none,
+        "T is no static_map key, specialize metaprogram::static_map_key<T>");
+};
+
+template <class T>
+struct static_map_key<T, static_key_integral> {
+    static constexpr uint64_t hash(const T& key) noexcept {
+        return detail::static_hash_mix(static_cast<uint64_t>(key));
+    }
+
+    static constexpr bool equal(const T& lhs, const T& rhs) noexcept {
+        return lhs == rhs;
+    }
+};
+
+// any string type, so a lookup doesn't convert its key
+template <class T>
+struct static_map_key<T, static_key_string> {
+    template <class S>
+    static constexpr uint64_t hash(const S& key) noexcept {
+        return detail::static_hash_string(key.data(), static_cast<size_t>(key.size()));
+    }
+
+    template <class S>
+    static constexpr bool equal(const T& lhs, const S& rhs) noexcept {
+        if (static_cast<size_t>(lhs.size()) != static_cast<size_t>(rhs.size())) {
+            return false;
+        }
+#if META_HAS_BUILTIN(__builtin_memcmp)
+        // a constant expression too, with gcc and clang
+        return __builtin_memcmp(lhs.data(), rhs.data(), static_cast<size_t>(lhs.size())) == 0;
+#else
+        for (size_t i = 0; i < static_cast<size_t>(lhs.size()); ++i) {
+            if (lhs.data()[i] != rhs.data()[i]) {
+                return false;
+            }
+        }
+        return true;
+#endif
+    }
+};
+
+namespace detail {
+    constexpr size_t static_map_pow2(size_t n) noexcept {
+        size_t p = 1;
+        while (p < n) {
+            p *= 2;
+        }
+        return p;
+    }
+
+    constexpr unsigned static_map_log2(size_t p) noexcept {
+        unsigned log = 0;
+        while (p > 1) {
+            p /= 2;
+            ++log;
+        }
+        return log;
+    }
+
+    // the sizes of the arrays of a static_map of N entries
+    template <size_t N>
+    struct static_map_layout {
+        static constexpr size_t slot_count = static_map_pow2(N + N / 4 > 2 ? N + N / 4 : 2);
+        static constexpr size_t bucket_count = static_map_pow2((N + 3) / 4);
+        static constexpr unsigned shift = 64 - static_map_log2(slot_count);
+        static constexpr size_t max_pilot = 0xffff;
+        using index_type = conditional_t<(N <= 0xff), uint8_t, conditional_t<(N <= 0xffff), uint16_t, uint32_t>>;
+    };
+
+    template <size_t N>
+    constexpr size_t static_map_layout<N>::slot_count;
+
+    template <size_t N>
+    constexpr size_t static_map_layout<N>::bucket_count;
+
+    template <size_t N>
+    constexpr unsigned static_map_layout<N>::shift;
+
+    template <size_t N>
+    constexpr size_t static_map_layout<N>::max_pilot;
+
+    constexpr size_t static_map_slot(uint64_t h, uint64_t pilot, unsigned shift) noexcept {
+        return static_cast<size_t>(((h ^ (pilot * 0x9e3779b97f4a7c15ull)) * 0xd6e8feb86659fd93ull) >> shift);
+    }
+
+    template <size_t N>
+    struct static_map_index {
+        uint16_t pilots[static_map_layout<N>::bucket_count];
+        typename static_map_layout<N>::index_type slots[static_map_layout<N>::slot_count];
+    };
+
+    // Implementation detail
+    // 1. The keys are sorted by bucket with a counting sort, the buckets are
+    //      placed by decreasing size
+    // 2. Keys with equal hashes land on the same slot whatever the pilot,
+    //      they are checked first: they are duplicates, a 64-bit collision of
+    //      two distinct keys is not expected to happen
+    template <size_t N>
+    constexpr static_map_index<N> build_static_map_index(const uint64_t (&hashes)[N]) {
+        using layout = static_map_layout<N>;
+        static_map_index<N> index = {{}, {}};
+
+        size_t start[layout::bucket_count + 1] = {};
+        for (size_t i = 0; i < N; ++i) {
+            ++start[(hashes[i] & (layout::bucket_count - 1)) + 1];
+        }
+        size_t largest = 0;
+        for (size_t b = 0; b < layout::bucket_count; ++b) {
+            largest = start[b + 1] > largest ? start[b + 1] : largest;
+            start[b + 1] += start[b];
+        }
+        size_t next[layout::bucket_count] = {};
+        for (size_t b = 0; b < layout::bucket_count; ++b) {
+            next[b] = start[b];
+        }
+        size_t keys[N] = {};
+        for (size_t i = 0; i < N; ++i) {
+            keys[next[hashes[i] & (layout::bucket_count - 1)]++] = i;
+        }
+
+        bool taken[layout::slot_count] = {};
+        for (size_t size = largest; size > 0; --size) {
+            for (size_t b = 0; b < layout::bucket_count; ++b) {
+                const size_t first = start[b];
+                const size_t last = start[b + 1];
+                if (last - first != size) {
+                    continue;
+                }
+                for (size_t i = first; i < last; ++i) {
+                    for (size_t j = first; j < i; ++j) {
+                        if (hashes[keys[i]] == hashes[keys[j]]) {
+                            throw std::invalid_argument("static_map: duplicate key");
+                        }
+                    }
+                }
+                size_t pilot = 0;
+                for (bool placed = false; !placed; ) {
+                    placed = true;
+                    for (size_t i = first; placed && i < last; ++i) {
+                        const size_t slot = static_map_slot(hashes[keys[i]], pilot, layout::shift);
+                        placed = !taken[slot];
+                        for (size_t j = first; placed && j < i; ++j) {
+                            placed = slot != static_map_slot(hashes[keys[j]], pilot, layout::shift);
+                        }
+                    }
+                    if (!placed && ++pilot > layout::max_pilot) {
+                        throw std::length_error("static_map: no perfect hash");
+                    }
+                }
+                index.pilots[b] = static_cast<uint16_t>(pilot);
+                for (size_t i = first; i < last; ++i) {
+                    const size_t slot = static_map_slot(hashes[keys[i]], pilot, layout::shift);
+                    taken[slot] = true;
+                    index.slots[slot] = static_cast<typename layout::index_type>(keys[i]);
+                }
+            }
+        }
+        return index;
+    }
+}
+
+template <class Key, class Value, size_t N>
+class static_map {
+    static_assert(N > 0, "static_map needs at least one entry");
+
+    using layout = detail::static_map_layout<N>;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = size_t;
+    using key_traits = static_map_key<Key>;
+    using const_reference = const value_type&;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    constexpr explicit static_map(const value_type (&entries)[N])
+        : static_map(entries, make_index_sequence<N>()) {}
+
+    constexpr const_iterator begin() const noexcept { return entries_; }
+    constexpr const_iterator end() const noexcept { return entries_ + N; }
+    constexpr size_type size() const noexcept { return N; }
+    constexpr bool empty() const noexcept { return false; }
+
+    constexpr const_iterator find(const key_type& key) const noexcept {
+        return find_key(key);
+    }
+
+    // a string of another type than key_type
+    template <class K, class = enable_if_t<detail::is_string_key<Key>::value && detail::is_string_key<K>::value>>
+    constexpr const_iterator find(const K& key) const noexcept {
+        return find_key(key);
+    }
+
+    template <class K>
+    constexpr bool contains(const K& key) const noexcept {
+        return find(key) != end();
+    }
+
+    template <class K>
+    constexpr size_type count(const K& key) const noexcept {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <class K>
+    constexpr const mapped_type& at(const K& key) const {
+        const const_iterator it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("static_map::at");
+        }
+        return it->second;
+    }
+
+private:
+    template <size_t... Is>
+    constexpr static_map(const value_type (&entries)[N], index_sequence<Is...>)
+        : entries_{entries[Is]...},
+          index_(detail::build_static_map_index<N>({key_traits::hash(entries[Is].first)...})) {}
+
+    template <class K>
+    constexpr const_iterator find_key(const K& key) const noexcept {
+        const uint64_t h = key_traits::hash(key);
+        const size_t slot = detail::static_map_slot(h, index_.pilots[h & (layout::bucket_count - 1)], layout::shift);
+        const value_type* entry = entries_ + index_.slots[slot];
+        return key_traits::equal(entry->first, key) ? entry : entries_ + N;
+    }
+
+    value_type entries_[N];
+    detail::static_map_index<N> index_;
+};
+
+// Returns the static_map of the entries, Key and Value are given and N is
+// deduced from the list.
+// Example:
+//      constexpr auto codes = make_static_map<int, const char*>({{200, "OK"}, {404, "Not Found"}});
+template <class Key, class Value, size_t N>
+constexpr static_map<Key, Value, N> make_static_map(const std::pair<Key, Value> (&entries)[N]) {
+    return static_map<Key, Value, N>(entries);
+}
+
+NS_META_END
+
+#endif /* static_map_h */
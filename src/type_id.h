@@ -0,0 +1,198 @@
+//
+//  type_id.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef type_id_h
+#define type_id_h
+
+#include <cstddef>
+#include <cstdint>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_cvrp.h"
+
+NS_META_BEG
+
+// An identifier of a type which doesn't need RTTI, the key of the runtime
+// registries. The hash is the 64-bit FNV-1a of the name, the comparisons
+// only look at the hash, so they are a single integer compare.
+// Implementation Note:
+// 1. The name is the one the compiler prints, it is readable but differs
+//      between compilers, so the hash is stable within a build, not across
+//      compilers
+// 2. The name is not null terminated
+struct type_index {
+    uint64_t hash;
+    const char* name;
+    size_t name_size;
+
+    constexpr bool operator==(type_index other) const noexcept { return hash == other.hash; }
+    constexpr bool operator!=(type_index other) const noexcept { return hash != other.hash; }
+    constexpr bool operator<(type_index other) const noexcept { return hash < other.hash; }
+    constexpr bool operator>(type_index other) const noexcept { return hash > other.hash; }
+    constexpr bool operator<=(type_index other) const noexcept { return hash <= other.hash; }
+    constexpr bool operator>=(type_index other) const noexcept { return hash >= other.hash; }
+};
+
+namespace detail {
+    template <class T>
+    constexpr const char* signature() noexcept {
+        return META_PRETTY_FUNCTION;
+    }
+
+    template <size_t N>
+    constexpr size_t signature_size(const char (&)[N]) noexcept {
+        return N - 1;
+    }
+
+    template <class T>
+    constexpr size_t signature_size() noexcept {
+        return signature_size(META_PRETTY_FUNCTION);
+    }
+
+    // Implementation detail
+    // 1. The signature of signature<void>() locates the type name, whatever
+    //      the compiler prints around it is the same for every T
+    constexpr size_t find(const char* s, size_t size, const char* what, size_t what_size) noexcept {
+        for (size_t i = 0; i + what_size <= size; ++i) {
+            size_t j = 0;
+            while (j < what_size && s[i + j] == what[j]) {
+                ++j;
+            }
+            if (j == what_size) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    constexpr size_t name_prefix() noexcept {
+        return find(signature<void>(), signature_size<void>(), "void", 4);
+    }
+
+    constexpr size_t name_suffix() noexcept {
+        return signature_size<void>() - name_prefix() - 4;
+    }
+
+    constexpr uint64_t fnv1a(const char* s, size_t size) noexcept {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(s[i])) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    template <class T>
+    struct type_index_of {
+        static constexpr size_t name_size = signature_size<T>() - name_prefix() - name_suffix();
+        static constexpr type_index value = {
+            fnv1a(signature<T>() + name_prefix(), name_size), signature<T>() + name_prefix(), name_size};
+    };
+
+    template <class T>
+    constexpr size_t type_index_of<T>::name_size;
+
+    template <class T>
+    constexpr type_index type_index_of<T>::value;
+}
+
+// Returns the type_index of T, cv-qualifiers and references are part of the type.
+// Example:
+//      static_assert(type_id<int>() != type_id<const int&>(), "");
+template <class T>
+constexpr type_index type_id() noexcept {
+    return detail::type_index_of<T>::value;
+}
+
+// Returns the type_index of remove_cvref_t<T>, so T, const T& and T&& match.
+// Example:
+//      static_assert(unqualified_type_id<int>() == unqualified_type_id<const int&>(), "");
+template <class T>
+constexpr type_index unqualified_type_id() noexcept {
+    return detail::type_index_of<remove_cvref_t<T>>::value;
+}
+
+namespace detail {
+    // one spare slot so an empty table still has arrays
+    template <size_t N>
+    struct type_id_entries {
+        uint64_t hash[N + 1];
+        size_t index[N + 1];
+    };
+
+    template <class... Ts>
+    constexpr type_id_entries<sizeof...(Ts)> sort_type_ids() noexcept {
+        type_id_entries<sizeof...(Ts)> e = {{type_id<Ts>().hash..., 0}, {}};
+        for (size_t i = 0; i < sizeof...(Ts); ++i) {
+            e.index[i] = i;
+        }
+        // insertion sort, the tables are small
+        for (size_t i = 1; i < sizeof...(Ts); ++i) {
+            uint64_t hash = e.hash[i];
+            size_t index = e.index[i];
+            size_t j = i;
+            for (; j > 0 && e.hash[j - 1] > hash; --j) {
+                e.hash[j] = e.hash[j - 1];
+                e.index[j] = e.index[j - 1];
+            }
+            e.hash[j] = hash;
+            e.index[j] = index;
+        }
+        return e;
+    }
+
+    template <size_t N>
+    constexpr bool distinct_type_ids(const type_id_entries<N>& e) noexcept {
+        for (size_t i = 1; i < N; ++i) {
+            if (e.hash[i - 1] == e.hash[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// A constexpr table of the type_index of Ts, sorted by hash. find is a binary
+// search which returns the position of the type in Ts, so dispatch on a
+// type_index is a lookup in an array of handlers instead of a chain of
+// dynamic_cast or typeid.
+// Example:
+//      using table = type_id_table<int, float, Foo>;
+//      handlers[table::find(id)](...);     // handlers has table::size + 1 entries
+template <class... Ts>
+struct type_id_table {
+    static constexpr size_t size = sizeof...(Ts);
+    static constexpr detail::type_id_entries<sizeof...(Ts)> table = detail::sort_type_ids<Ts...>();
+
+    static_assert(detail::distinct_type_ids(table), "type_id_table: duplicated types or a hash collision");
+
+    // Returns the position of the type in Ts, or size if it is not in the table.
+    static constexpr size_t find(type_index id) noexcept {
+        size_t first = 0;
+        size_t last = size;
+        while (first < last) {
+            size_t mid = first + (last - first) / 2;
+            if (table.hash[mid] < id.hash) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+        return first < size && table.hash[first] == id.hash ? table.index[first] : size;
+    }
+};
+
+template <class... Ts>
+constexpr size_t type_id_table<Ts...>::size;
+
+template <class... Ts>
+constexpr detail::type_id_entries<sizeof...(Ts)> type_id_table<Ts...>::table;
+
+NS_META_END
+
+#endif /* type_id_h */
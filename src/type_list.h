@@ -0,0 +1,376 @@
+//
+//  type_list.h
+//  metaprogram
+//
+//  Created by Gong Wenzhu on 2026/10/17.
+//  Copyright © 2026 Gong Wenzhu. All rights reserved.
+//
+
+#ifndef type_list_h
+#define type_list_h
+
+#include <cstddef>
+
+#include "config.h"
+#include "type_traits_helper.h"
+#include "type_traits_type.h"
+#include "integer_sequence.h"
+
+NS_META_BEG
+
+// A compile-time list of types, the algorithms below take it as the first
+// template argument and provide the member typedef type (or constant value).
+// Example:
+//      using L = type_list<int, float, int>;
+//      static_assert(L::size == 3, "");
+//      static_assert(is_same<float, at_t<L, 1>>(), "");
+//      static_assert(is_same<type_list<int, float>, unique_t<L>>(), "");
+// Implementation Note:
+// 1. Lists of several hundred or thousand types are expected, so nothing
+//      recurses over the elements one by one: indexing is O(1) depth and
+//      the other algorithms are O(log N) depth
+template <class... Ts>
+struct type_list {
+    static constexpr size_t size = sizeof...(Ts);
+};
+
+template <class... Ts>
+constexpr size_t type_list<Ts...>::size;
+
+namespace detail {
+    // Implementation detail
+    // 1. indexer<0..N-1, Ts...> derives from indexed<integral_constant<I>, T> for
+    //      every element, so select<I> deduces T from the only base keyed by I.
+    //      This is a single overload resolution, whatever the size of the list
+    template <class I, class T>
+    struct indexed {};
+
+    template <class Is, class... Ts>
+    struct indexer;
+
+    template <size_t... Is, class... Ts>
+    struct indexer<index_sequence<Is...>, Ts...> : indexed<integral_constant<size_t, Is>, Ts>... {};
+
+    template <size_t I, class T>
+    type_identity<T> select(const indexed<integral_constant<size_t, I>, T>*);
+
+    // Implementation detail
+    // 1. First true in the array, or N - 1 when there is none. The array ends
+    //      with a false sentinel, so an empty pack still makes an array, and
+    //      only the size is a template argument, not the pack of results
+    template <size_t N>
+    constexpr size_t find_first(const bool (&matches)[N]) {
+        for (size_t i = 0; i + 1 < N; ++i) {
+            if (matches[i]) {
+                return i;
+            }
+        }
+        return N - 1;
+    }
+
+    // Implementation detail
+    // 1. keep_if<B>::type<T> is type_list<T> or type_list<>, only the two
+    //      specializations are ever instantiated, the alias is free
+    template <bool B>
+    struct keep_if {
+        template <class T>
+        using type = type_list<T>;
+    };
+
+    template <>
+    struct keep_if<false> {
+        template <class T>
+        using type = type_list<>;
+    };
+}
+
+// Provides the member typedef type which is the I-th type of the list.
+template <class L, size_t I>
+struct at;
+
+#if defined(META_BUILTIN_TYPE_PACK_ELEMENT)
+template <class... Ts, size_t I>
+struct at<type_list<Ts...>, I> : type_identity<META_BUILTIN_TYPE_PACK_ELEMENT(I, Ts...)> {
+    META_PROBE(at);
+};
+#else
+template <class... Ts, size_t I>
+struct at<type_list<Ts...>, I>
+    : decltype(detail::select<I>(static_cast<detail::indexer<index_sequence_for<Ts...>, Ts...>*>(nullptr))) {
+    META_PROBE(at);
+};
+#endif
+
+template <class L, size_t I>
+using at_t = typename at<L, I>::type;
+
+// Provides the member constant value which is the index of the first T in the list,
+// or the size of the list if T is not in it.
+template <class L, class T>
+struct index_of;
+
+#if defined(META_BUILTIN_IS_SAME)
+template <class... Ts, class T>
+struct index_of<type_list<Ts...>, T>
+    : integral_constant<size_t, detail::find_first({META_BUILTIN_IS_SAME(T, Ts)..., false})> {
+    META_PROBE(index_of);
+};
+#else
+template <class... Ts, class T>
+struct index_of<type_list<Ts...>, T>
+    : integral_constant<size_t, detail::find_first({is_same<T, Ts>::value..., false})> {
+    META_PROBE(index_of);
+};
+#endif
+
+template <class L, class T>
+META_INLINE_VAR constexpr size_t index_of_v = index_of<L, T>::value;
+
+// Checks whether T is in the list.
+template <class L, class T>
+struct contains : bool_constant<index_of<L, T>::value != L::size> {};
+
+template <class L, class T>
+META_INLINE_VAR constexpr bool contains_v = contains<L, T>::value;
+
+// Provides the member typedef type which is the concatenation of the lists.
+// Implementation Note:
+// 1. Up to four lists are joined directly, more are merged in rounds, see merge_rounds
+template <class... Ls>
+struct concat;
+
+namespace detail {
+    // Implementation detail
+    // 1. shift<0..D-1>::type<Qs...> is the list Qs[D..N-1] padded with D empty
+    //      lists. The first D arguments go to the void* parameters and the rest
+    //      are deduced, a single deduction instead of N lookups
+    template <class Is>
+    struct shift;
+
+    template <size_t... Is>
+    struct shift<index_sequence<Is...>> {
+        template <class... Ts>
+        static type_list<typename Ts::type...> drop(decltype((void)Is, static_cast<void*>(nullptr))..., Ts*...);
+
+        template <class... Qs>
+        using type = decltype(drop(static_cast<type_identity<Qs>*>(nullptr)...,
+            static_cast<type_identity<type_list<>>*>(((void)Is, nullptr))...));
+    };
+
+    template <bool B>
+    struct merge_if {
+        template <template <class, class> class Merge, class L, class R>
+        using type = typename Merge<L, R>::type;
+    };
+
+    template <>
+    struct merge_if<false> {
+        template <template <class, class> class Merge, class L, class R>
+        using type = type_list<>;
+    };
+
+    // Implementation detail
+    // 1. Reduces the lists Qs with Merge, which must be associative, in O(log N)
+    //      depth. Before the round of stride D, Qs[i] with i % D == 0 holds the
+    //      merge of Qs[i..i+D-1] and the others are empty, the round merges
+    //      Qs[i] with Qs[i+D] for i % 2D == 0 and empties the others. The list
+    //      keeps its length, so every round is a single pack expansion
+    template <template <class, class> class Merge, size_t D, class Qs, bool = (D < Qs::size)>
+    struct merge_rounds;
+
+    template <template <class, class> class Merge, size_t D, class Js, class Qs, class Ss>
+    struct merge_round;
+
+    template <template <class, class> class Merge, size_t D, size_t... Js, class... Qs, class... Ss>
+    struct merge_round<Merge, D, index_sequence<Js...>, type_list<Qs...>, type_list<Ss...>>
+        : merge_rounds<Merge, 2 * D,
+            type_list<typename merge_if<Js % (2 * D) == 0>::template type<Merge, Qs, Ss>...>> {};
+
+    template <template <class, class> class Merge, size_t D, class... Qs>
+    struct merge_rounds<Merge, D, type_list<Qs...>, true>
+        : merge_round<Merge, D, index_sequence_for<Qs...>, type_list<Qs...>,
+            typename shift<make_index_sequence<D>>::template type<Qs...>> {};
+
+    template <template <class, class> class Merge, size_t D, class Q, class... Qs>
+    struct merge_rounds<Merge, D, type_list<Q, Qs...>, false>
+        : type_identity<Q> {};
+
+    // concat itself can't be named as the Merge of its own base class
+    template <class A, class B>
+    struct join : concat<A, B> {};
+}
+
+template <>
+struct concat<> : type_identity<type_list<>> {};
+
+template <class... As>
+struct concat<type_list<As...>> : type_identity<type_list<As...>> {};
+
+template <class... As, class... Bs>
+struct concat<type_list<As...>, type_list<Bs...>> : type_identity<type_list<As..., Bs...>> {};
+
+template <class... As, class... Bs, class... Cs>
+struct concat<type_list<As...>, type_list<Bs...>, type_list<Cs...>>
+    : type_identity<type_list<As..., Bs..., Cs...>> {};
+
+template <class... As, class... Bs, class... Cs, class... Ds>
+struct concat<type_list<As...>, type_list<Bs...>, type_list<Cs...>, type_list<Ds...>>
+    : type_identity<type_list<As..., Bs..., Cs..., Ds...>> {};
+
+template <class L1, class L2, class L3, class L4, class L5, class... Ls>
+struct concat<L1, L2, L3, L4, L5, Ls...>
+    : detail::merge_rounds<detail::join, 1, type_list<L1, L2, L3, L4, L5, Ls...>> {};
+
+template <class... Ls>
+using concat_t = typename concat<Ls...>::type;
+
+// Provides the member typedef type which is the list of the types [Begin, End).
+// take and drop keep the first N types or the ones after them.
+// Example:
+//      using L = type_list<char, short, int, long>;
+//      static_assert(is_same<type_list<short, int>, slice_t<L, 1, 3>>(), "");
+//      static_assert(is_same<type_list<char>, take_t<L, 1>>(), "");
+//      static_assert(is_same<type_list<long>, drop_t<L, 3>>(), "");
+// Implementation Note:
+// 1. drop is a single deduction, O(N) for any N. slice and take pick the
+//      types with __type_pack_element, without it (gcc before 14) they keep
+//      or drop every type and concatenate the N lists, O(log N) depth but a
+//      large constant: taking half of 10k types takes gcc 12 about 10s
+template <class L, size_t Begin, size_t End>
+struct slice;
+
+namespace detail {
+    template <size_t Begin, size_t End, class Is, class L>
+    struct slice_list;
+
+#if defined(META_BUILTIN_TYPE_PACK_ELEMENT)
+    // every type of the slice is picked directly, O(1) depth
+    template <size_t Begin, size_t End, size_t... Js, class... Ts>
+    struct slice_list<Begin, End, index_sequence<Js...>, type_list<Ts...>>
+        : type_identity<type_list<META_BUILTIN_TYPE_PACK_ELEMENT(Begin + Js, Ts...)...>> {};
+
+    template <size_t Begin, size_t End, class... Ts>
+    using slice_of = slice_list<Begin, End, make_index_sequence<(Begin < End ? End - Begin : 0)>, type_list<Ts...>>;
+#else
+    // every type is kept or dropped by its index, and the lists are concatenated
+    template <size_t Begin, size_t End, size_t... Is, class... Ts>
+    struct slice_list<Begin, End, index_sequence<Is...>, type_list<Ts...>>
+        : concat<typename keep_if<(Begin <= Is && Is < End)>::template type<Ts>...> {};
+
+    template <size_t Begin, size_t End, class... Ts>
+    using slice_of = slice_list<Begin, End, index_sequence_for<Ts...>, type_list<Ts...>>;
+#endif
+}
+
+template <class... Ts, size_t Begin, size_t End>
+struct slice<type_list<Ts...>, Begin, End> : detail::slice_of<Begin, End, Ts...> {
+    static_assert(Begin <= End && End <= sizeof...(Ts), "slice: [Begin, End) is out of the list");
+};
+
+template <class L, size_t Begin, size_t End>
+using slice_t = typename slice<L, Begin, End>::type;
+
+template <class L, size_t N>
+struct take : slice<L, 0, N> {};
+
+template <class L, size_t N>
+using take_t = typename take<L, N>::type;
+
+template <class L, size_t N>
+struct drop;
+
+// the leading types go to the void* parameters of shift, see concat
+template <class... Ts, size_t N>
+struct drop<type_list<Ts...>, N>
+    : type_identity<decltype(detail::shift<make_index_sequence<N>>::drop(static_cast<type_identity<Ts>*>(nullptr)...))> {
+    static_assert(N <= sizeof...(Ts), "drop: N is larger than the list");
+};
+
+template <class L, size_t N>
+using drop_t = typename drop<L, N>::type;
+
+// Provides the member typedef type which is the list of the types T for which
+// Pred<T>::value is true, in order. Any of the is_xxx traits can be used as Pred.
+// Example:
+//      static_assert(is_same<type_list<int, long>,
+//                  filter_t<type_list<int, float, long>, is_integral>>(), "");
+template <class L, template <class> class Pred>
+struct filter;
+
+template <class... Ts, template <class> class Pred>
+struct filter<type_list<Ts...>, Pred>
+    : concat<typename detail::keep_if<Pred<Ts>::value>::template type<Ts>...> {};
+
+template <class L, template <class> class Pred>
+using filter_t = typename filter<L, Pred>::type;
+
+// Provides the member typedef first which is filter<L, Pred>::type, and second
+// which is the list of the other types, Pred is evaluated once per type.
+template <class L, template <class> class Pred>
+struct partition;
+
+template <class... Ts, template <class> class Pred>
+struct partition<type_list<Ts...>, Pred> {
+    using first = typename concat<typename detail::keep_if<Pred<Ts>::value>::template type<Ts>...>::type;
+    using second = typename concat<typename detail::keep_if<!Pred<Ts>::value>::template type<Ts>...>::type;
+};
+
+// Provides the member typedef type which is the list of F<T>::type for every T,
+// any of the type transformations (remove_cv, add_pointer, ...) can be used as F.
+template <class L, template <class> class F>
+struct transform;
+
+template <class... Ts, template <class> class F>
+struct transform<type_list<Ts...>, F> : type_identity<type_list<typename F<Ts>::type...>> {};
+
+template <class L, template <class> class F>
+using transform_t = typename transform<L, F>::type;
+
+// Provides the member typedef type which is the list without the duplicated
+// types, the first occurrence is kept.
+// Implementation Note:
+// 1. Every type starts as a list of its own and the lists are merged in rounds,
+//      merging drops the types of the second list which are in the first one.
+//      A unique list can be the bases of a struct, so that check is a single
+//      derived-to-base conversion
+template <class L>
+struct unique;
+
+namespace detail {
+    template <class... Ts>
+    struct type_set : type_identity<Ts>... {};
+
+    template <class A, class B>
+    struct unique_merge;
+
+#if defined(META_BUILTIN_IS_BASE_OF)
+    template <class... As, class... Bs>
+    struct unique_merge<type_list<As...>, type_list<Bs...>>
+        : concat<type_list<As...>, typename keep_if<
+            !META_BUILTIN_IS_BASE_OF(type_identity<Bs>, type_set<As...>)>::template type<Bs>...> {};
+#else
+    template <class T>
+    true_type set_has(type_identity<T>*);
+
+    template <class T>
+    false_type set_has(...);
+
+    template <class... As, class... Bs>
+    struct unique_merge<type_list<As...>, type_list<Bs...>>
+        : concat<type_list<As...>, typename keep_if<
+            !decltype(set_has<Bs>(static_cast<type_set<As...>*>(nullptr)))::value>::template type<Bs>...> {};
+#endif
+}
+
+template <class... Ts>
+struct unique<type_list<Ts...>> : detail::merge_rounds<detail::unique_merge, 1, type_list<type_list<Ts>...>> {};
+
+template <>
+struct unique<type_list<>> : type_identity<type_list<>> {};
+
+template <class L>
+using unique_t = typename unique<L>::type;
+
+NS_META_END
+
+#endif /* type_list_h */
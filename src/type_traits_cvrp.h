@@ -30,8 +30,29 @@ struct remove_volatile : type_identity<T> {};
 template <class T>
 struct remove_volatile<volatile T> : type_identity<T> {};
 
+// Implementation Note:
+// 1. remove_cv has its own specializations instead of chaining remove_const and
+// remove_volatile, so it is one instantiation
+template <class T>
+struct remove_cv : type_identity<T> {};
+
+template <class T>
+struct remove_cv<const T> : type_identity<T> {};
+
+template <class T>
+struct remove_cv<volatile T> : type_identity<T> {};
+
+template <class T>
+struct remove_cv<const volatile T> : type_identity<T> {};
+
+template <class T>
+using remove_const_t = typename remove_const<T>::type;
+
+template <class T>
+using remove_volatile_t = typename remove_volatile<T>::type;
+
 template <class T>
-using remove_cv = remove_const<typename remove_volatile<T>::type>;
+using remove_cv_t = typename remove_cv<T>::type;
 
 // Add cv-qualifier to the type T, except
 //      1. T already has a cv-qualifier 
@@ -52,7 +73,18 @@ template <class T>
 struct add_volatile : type_identity<volatile T> {};
 
 template <class T>
-using add_cv = add_const<typename add_volatile<T>::type>;
+struct add_cv : type_identity<const volatile T> {};
+
+// Implementation Note:
+// 1. The qualifiers are applied directly, no struct is instantiated
+template <class T>
+using add_const_t = const T;
+
+template <class T>
+using add_volatile_t = volatile T;
+
+template <class T>
+using add_cv_t = const volatile T;
 
 // If the type T is a reference type, provides the member typedef type which 
 // is the type referred to by T. Otherwise type is T.
@@ -61,6 +93,10 @@ using add_cv = add_const<typename add_volatile<T>::type>;
 //                  "remove_reference<int&>::type is same as int");
 //      static_assert(is_same<int, remove_reference<int&&>::type>(), 
 //                  "remove_reference<int&&>::type is same as int");
+#if defined(META_BUILTIN_REMOVE_REFERENCE)
+template <class T>
+struct remove_reference : type_identity<META_BUILTIN_REMOVE_REFERENCE(T)> {};
+#else
 template <class T>
 struct remove_reference : type_identity<T> {};
 
@@ -69,6 +105,15 @@ struct remove_reference<T&> : type_identity<T> {};
 
 template <class T>
 struct remove_reference<T&&> : type_identity<T> {};
+#endif
+
+#if defined(META_BUILTIN_REMOVE_REFERENCE)
+template <class T>
+using remove_reference_t = META_BUILTIN_REMOVE_REFERENCE(T);
+#else
+template <class T>
+using remove_reference_t = typename remove_reference<T>::type;
+#endif
 
 namespace detail {
     template <class T>
@@ -103,6 +148,12 @@ struct add_lvalue_reference : public decltype(detail::try_add_lref<T>(0)) {};
 template <class T>
 struct add_rvalue_reference : public decltype(detail::try_add_rref<T>(0)) {};
 
+template <class T>
+using add_lvalue_reference_t = typename decltype(detail::try_add_lref<T>(0))::type;
+
+template <class T>
+using add_rvalue_reference_t = typename decltype(detail::try_add_rref<T>(0))::type;
+
 // Provides the member typedef type which is the type pointed to by T, 
 // or, if T is not a pointer, then type is the same as T.
 // Example: 
@@ -126,9 +177,12 @@ struct remove_pointer<T* volatile> : type_identity<T> {};
 template <class T>
 struct remove_pointer<T* const volatile> : type_identity<T> {};
 
+template <class T>
+using remove_pointer_t = typename remove_pointer<T>::type;
+
 namespace detail {
     template <class T>
-    auto try_add_pointer(int) -> type_identity<typename remove_reference<T>::type*>;
+    auto try_add_pointer(int) -> type_identity<remove_reference_t<T>*>;
     template <class T>
     auto try_add_pointer(...) -> type_identity<T>;
 };
@@ -145,8 +199,21 @@ namespace detail {
 //      int f() &;
 //      int f() &&;
 // And add pointer to these type is ill-formed, so the SFINAE will be good
+#if defined(META_BUILTIN_ADD_POINTER)
+template <class T>
+struct add_pointer : type_identity<META_BUILTIN_ADD_POINTER(T)> {};
+#else
 template <class T>
 struct add_pointer : decltype(detail::try_add_pointer<T>(0)) {};
+#endif
+
+#if defined(META_BUILTIN_ADD_POINTER)
+template <class T>
+using add_pointer_t = META_BUILTIN_ADD_POINTER(T);
+#else
+template <class T>
+using add_pointer_t = typename decltype(detail::try_add_pointer<T>(0))::type;
+#endif
 
 // If the type T is a reference type, provides the member typedef type
 // which is the type referred to by T with its topmost cv-qualifiers removed. 
@@ -154,8 +221,25 @@ struct add_pointer : decltype(detail::try_add_pointer<T>(0)) {};
 // Example: 
 //      static_assert(is_same<int, remove_cvref<const volatile int&>::type>(), 
 //                  "remove_cvref<const volatile int&>::type is same as int");
+#if defined(META_BUILTIN_REMOVE_CVREF)
+template <class T>
+struct remove_cvref : type_identity<META_BUILTIN_REMOVE_CVREF(T)> {
+    META_PROBE(remove_cvref);
+};
+#else
+template <class T>
+struct remove_cvref : type_identity<remove_cv_t<remove_reference_t<T>>> {
+    META_PROBE(remove_cvref);
+};
+#endif
+
+#if defined(META_BUILTIN_REMOVE_CVREF)
+template <class T>
+using remove_cvref_t = META_BUILTIN_REMOVE_CVREF(T);
+#else
 template <class T>
-struct remove_cvref : type_identity<typename remove_cv<typename remove_reference<T>::type>::type> {};
+using remove_cvref_t = remove_cv_t<remove_reference_t<T>>;
+#endif
 
 NS_META_END
 
@@ -13,6 +13,19 @@
 
 NS_META_BEG
 
+#if META_INSTRUMENT
+namespace detail {
+    // Implementation detail
+    // 1. Named by META_PROBE(self) in the unevaluated operand of a member alias,
+    //      so it is used once per instantiation of self and the warning
+    //      spells self with its template arguments
+    template <class Trait>
+    [[deprecated("metaprogram instantiation")]] constexpr int instantiation_probe() noexcept {
+        return 0;
+    }
+}
+#endif
+
 // Provides the member typedef type that names T 
 // Example:
 // 		typename type_identity<int>::type value;
@@ -21,6 +34,9 @@ struct type_identity {
     using type = T;
 };
 
+template <class T>
+using type_identity_t = T;
+
 // integral_constant wraps a static constant of specified type. 
 // It is the base class for the C++ type traits.
 // The behavior of a program that adds specializations for integral_constant is undefined.
@@ -38,6 +54,10 @@ struct integral_constant {
     constexpr value_type operator()() const noexcept { return value; }
 };
 
+// the definition an odr-use of value needs before c++17 made it inline
+template <class T, T t>
+constexpr T integral_constant<T, t>::value;
+
 // bool constant
 template <bool B>
 using bool_constant = integral_constant<bool,B>;
@@ -46,6 +66,128 @@ using bool_constant = integral_constant<bool,B>;
 using true_type = bool_constant<true>;
 using false_type = bool_constant<false>;
 
+// Provides the member typedef type which is T if B is true, F otherwise.
+// Example:
+//      using word = conditional_t<sizeof(void*) == 8, uint64_t, uint32_t>;
+// Implementation Note:
+// 1. The choice is made by an alias member of one of two structs selected by B,
+//      so conditional_t<B, T, F> instantiates nothing per T and F
+namespace detail {
+    template <bool B>
+    struct select_type {
+        template <class T, class F>
+        using type = T;
+    };
+
+    template <>
+    struct select_type<false> {
+        template <class T, class F>
+        using type = F;
+    };
+}
+
+template <bool B, class T, class F>
+struct conditional {
+    using type = typename detail::select_type<B>::template type<T, F>;
+};
+
+template <bool B, class T, class F>
+using conditional_t = typename detail::select_type<B>::template type<T, F>;
+
+// Provides the member typedef type which is T if B is true, there is no member
+// otherwise, so a declaration which names it is removed by SFINAE.
+// Example:
+//      template <class T, class = enable_if_t<is_integral<T>::value>>
+//      T gcd(T a, T b);
+namespace detail {
+    template <bool B>
+    struct enable_type {};
+
+    template <>
+    struct enable_type<true> {
+        template <class T>
+        using type = T;
+    };
+}
+
+template <bool B, class T = void>
+struct enable_if {};
+
+template <class T>
+struct enable_if<true, T> {
+    using type = T;
+};
+
+template <bool B, class T = void>
+using enable_if_t = typename detail::enable_type<B>::template type<T>;
+
+/***************************** Logical operations *************************
+conjunction<Bs...> derives from the first B whose value is false, or the last
+one, disjunction<Bs...> from the first B whose value is true, or the last one,
+and negation<B> is the opposite of B. The operands after the one which decides
+are never instantiated, so they can be expensive or ill-formed for the types
+the first ones reject.
+Example:
+        template <class T>
+        struct is_cheap : disjunction<is_scalar<T>,
+            conjunction<is_trivially_copyable<T>, bool_constant<sizeof(T) <= 16>>> {};
+Implementation Note:
+1. Every step is an alias member of one of two structs, selected by the value
+    of the operand just checked, so a query only instantiates the operands it
+    reads and no conjunction<...> struct per suffix of the list
+**************************************************************************/
+namespace detail {
+    // Last is the last operand read, the ones before it were all true
+    template <bool Continue>
+    struct conjunction_step {
+        template <class Last, class B, class... Bs>
+        using type = typename conjunction_step<bool(B::value) && sizeof...(Bs) != 0>::template type<B, Bs...>;
+    };
+
+    template <>
+    struct conjunction_step<false> {
+        template <class Last, class... Bs>
+        using type = Last;
+    };
+
+    // Last is the last operand read, the ones before it were all false
+    template <bool Continue>
+    struct disjunction_step {
+        template <class Last, class B, class... Bs>
+        using type = typename disjunction_step<!bool(B::value) && sizeof...(Bs) != 0>::template type<B, Bs...>;
+    };
+
+    template <>
+    struct disjunction_step<false> {
+        template <class Last, class... Bs>
+        using type = Last;
+    };
+}
+
+template <class... Bs>
+struct conjunction : public detail::conjunction_step<sizeof...(Bs) != 0>::template type<true_type, Bs...> {
+    META_PROBE(conjunction);
+};
+
+template <class... Bs>
+struct disjunction : public detail::disjunction_step<sizeof...(Bs) != 0>::template type<false_type, Bs...> {
+    META_PROBE(disjunction);
+};
+
+template <class B>
+struct negation : public bool_constant<!bool(B::value)> {
+    META_PROBE(negation);
+};
+
+template <class... Bs>
+META_INLINE_VAR constexpr bool conjunction_v = conjunction<Bs...>::value;
+
+template <class... Bs>
+META_INLINE_VAR constexpr bool disjunction_v = disjunction<Bs...>::value;
+
+template <class B>
+META_INLINE_VAR constexpr bool negation_v = !bool(B::value);
+
 NS_META_END 
 
 #endif /* type_traits_helper_h */
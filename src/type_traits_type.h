@@ -9,7 +9,10 @@
 #ifndef type_traits_type_h
 #define type_traits_type_h
 
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 
 #include "config.h"
 #include "type_traits_helper.h"
@@ -21,14 +24,204 @@ NS_META_BEG
 // provides the member constant value equal to true. Otherwise value is false.
 // Example:
 // 		static_assert(!is_same<int, float>::value, "int and float are not the same type")
+#if defined(META_BUILTIN_IS_SAME)
+template <class T, class U>
+struct is_same : public bool_constant<META_BUILTIN_IS_SAME(T, U)> {
+    META_PROBE(is_same);
+};
+#else
 template <class T, class U>
 struct is_same : public false_type {
+    META_PROBE(is_same);
 };
 
 template <class T>
 struct is_same<T,T> : public true_type {
+    META_PROBE(is_same);
+};
+#endif
+
+/******************************* Type category ***************************
+Classifies T (ignoring the topmost cv-qualifiers) once, the result is a
+bitmask of type_category_flags with exactly one primary category bit set.
+All primary and composite type categories below are views over it, so asking
+several questions about the same T only classifies it once.
+Example:
+        switch (type_category<T>::value) {
+        case category_integral: ...
+        case category_enum: ...
+        }
+**************************************************************************/
+enum type_category_flags : unsigned {
+    category_none = 0,
+    category_void = 1u << 0,
+    category_null_pointer = 1u << 1,
+    category_integral = 1u << 2,
+    category_floating_point = 1u << 3,
+    category_array = 1u << 4,
+    category_enum = 1u << 5,
+    category_union = 1u << 6,
+    category_class = 1u << 7,
+    category_function = 1u << 8,
+    category_pointer = 1u << 9,
+    category_lvalue_reference = 1u << 10,
+    category_rvalue_reference = 1u << 11,
+    category_member_object_pointer = 1u << 12,
+    category_member_function_pointer = 1u << 13,
+
+    // composite categories
+    category_arithmetic = category_integral | category_floating_point,
+    category_fundamental = category_arithmetic | category_void | category_null_pointer,
+    category_reference = category_lvalue_reference | category_rvalue_reference,
+    category_member_pointer = category_member_object_pointer | category_member_function_pointer,
+    category_scalar = category_arithmetic | category_pointer | category_member_pointer
+        | category_enum | category_null_pointer,
+};
+
+namespace detail {
+    // Implementation detail
+    // 1. SFINAE
+    // 2. if T is class/union then T::* is well-formed
+    // 3. the int T::* don't mean T must has a member which type is int
+    //      until we set it, like (int T::*m = &T::member), now we just
+    //      do a declaration, so it is just fine
+	template <class T> true_type is_class_or_union(int T::*);
+	template <class T> false_type is_class_or_union(...);
+
+    // Implementation detail
+    // 1. Only function and reference types can't be const-qualified, cv-qualifiers
+    //    applied to them through a template argument are ignored. References are
+    //    matched before, so what is left is a function type (including the cv-,
+    //    ref-qualified and noexcept ones)
+#if defined(META_BUILTIN_IS_FUNCTION)
+    template <class T>
+    struct is_function_type : public bool_constant<META_BUILTIN_IS_FUNCTION(T)> {};
+#else
+    template <class T> struct is_const_qualified : public false_type {};
+    template <class T> struct is_const_qualified<const T> : public true_type {};
+
+    template <class T>
+    struct is_function_type : public bool_constant<!is_const_qualified<const T>::value> {};
+#endif
+
+    // Classifies the types which are not matched by a type_category specialization.
+    // Implementation detail
+    // 1. The second parameter splits classes, unions (and enums, with the builtins)
+    //    from the rest, so each side is resolved without instantiating the other
+    // 2. The rest is resolved by one explicit specialization per distinct fundamental
+    //    type. The <cstdint> typedefs (int32_t, int_fast32_t, intptr_t, ...) are
+    //    aliases of the standard types, so they are covered and must not be listed
+    // 3. Without the enum builtin an enum is what is left by the exclusion, like
+    //    the implementation-defined extended types
+#if defined(META_BUILTIN_IS_CLASS) && defined(META_BUILTIN_IS_UNION) && defined(META_BUILTIN_IS_ENUM)
+    template <class T, bool = META_BUILTIN_IS_CLASS(T) || META_BUILTIN_IS_UNION(T) || META_BUILTIN_IS_ENUM(T)>
+    struct primary_category : public integral_constant<unsigned,
+        is_function_type<T>::value ? category_function : category_none> {};
+
+    template <class T>
+    struct primary_category<T, true> : public integral_constant<unsigned,
+        META_BUILTIN_IS_CLASS(T) ? category_class
+        : META_BUILTIN_IS_UNION(T) ? category_union
+        : category_enum> {};
+#else
+    template <class T, bool = decltype(is_class_or_union<T>(0))::value>
+    struct primary_category : public integral_constant<unsigned,
+        is_function_type<T>::value ? category_function : category_enum> {};
+
+    template <class T>
+    struct primary_category<T, true> : public integral_constant<unsigned,
+        std::is_union<T>::value ? category_union : category_class> {};
+#endif
+
+    template <> struct primary_category<void, false> : public integral_constant<unsigned, category_void> {};
+    template <> struct primary_category<std::nullptr_t, false> : public integral_constant<unsigned, category_null_pointer> {};
+
+    template <> struct primary_category<bool, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<char, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<signed char, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<unsigned char, false> : public integral_constant<unsigned, category_integral> {};
+#if defined(__cpp_char8_t)
+    template <> struct primary_category<char8_t, false> : public integral_constant<unsigned, category_integral> {};
+#endif
+    template <> struct primary_category<char16_t, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<char32_t, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<wchar_t, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<short, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<unsigned short, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<int, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<unsigned int, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<long, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<unsigned long, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<long long, false> : public integral_constant<unsigned, category_integral> {};
+    template <> struct primary_category<unsigned long long, false> : public integral_constant<unsigned, category_integral> {};
+
+    template <> struct primary_category<float, false> : public integral_constant<unsigned, category_floating_point> {};
+    template <> struct primary_category<double, false> : public integral_constant<unsigned, category_floating_point> {};
+    template <> struct primary_category<long double, false> : public integral_constant<unsigned, category_floating_point> {};
+}
+
+// Provides the member constant value which is the type_category_flags of T,
+// the topmost cv-qualifiers are ignored.
+// Implementation Note:
+// 1. Compound types are matched by partial specialization, the cv-qualified ones
+//      forward to the unqualified type, so there is no remove_cv chain
+// 2. cv-qualified arrays match both const T and T[N], so they are listed
+template <class T>
+struct type_category : public detail::primary_category<T> {
+    META_PROBE(type_category);
 };
 
+template <class T>
+struct type_category<const T> : public type_category<T> {};
+
+template <class T>
+struct type_category<volatile T> : public type_category<T> {};
+
+template <class T>
+struct type_category<const volatile T> : public type_category<T> {};
+
+template <class T>
+struct type_category<T*> : public integral_constant<unsigned, category_pointer> {};
+
+template <class T>
+struct type_category<T&> : public integral_constant<unsigned, category_lvalue_reference> {};
+
+template <class T>
+struct type_category<T&&> : public integral_constant<unsigned, category_rvalue_reference> {};
+
+template <class T>
+struct type_category<T[]> : public integral_constant<unsigned, category_array> {};
+
+template <class T>
+struct type_category<const T[]> : public integral_constant<unsigned, category_array> {};
+
+template <class T>
+struct type_category<volatile T[]> : public integral_constant<unsigned, category_array> {};
+
+template <class T>
+struct type_category<const volatile T[]> : public integral_constant<unsigned, category_array> {};
+
+template <class T, size_t N>
+struct type_category<T[N]> : public integral_constant<unsigned, category_array> {};
+
+template <class T, size_t N>
+struct type_category<const T[N]> : public integral_constant<unsigned, category_array> {};
+
+template <class T, size_t N>
+struct type_category<volatile T[N]> : public integral_constant<unsigned, category_array> {};
+
+template <class T, size_t N>
+struct type_category<const volatile T[N]> : public integral_constant<unsigned, category_array> {};
+
+template <class T, class U>
+struct type_category<T U::*> : public integral_constant<unsigned,
+    detail::is_function_type<T>::value ? category_member_function_pointer : category_member_object_pointer> {};
+
+namespace detail {
+    template <class T, unsigned Mask>
+    using has_category = bool_constant<(type_category<T>::value & Mask) != 0>;
+}
+
 /******************************* Primary type categories ******************
 Provides the member constant value that is equal to true, if T is the type
 1. P
@@ -37,11 +230,11 @@ Provides the member constant value that is equal to true, if T is the type
 4. const volatile P
 **************************************************************************/
 template <class T>
-struct is_void : public is_same<void, typename remove_cv<T>::type> {
+struct is_void : public detail::has_category<T, category_void> {
 };
 
 template <class T>
-struct is_null_pointer : public is_same<std::nullptr_t, typename remove_cv<T>::type> {
+struct is_null_pointer : public detail::has_category<T, category_null_pointer> {
 };
 
 // Checks whether T is an integral type. Provides the member constant value 
@@ -50,63 +243,13 @@ struct is_null_pointer : public is_same<std::nullptr_t, typename remove_cv<T>::t
 // extended integer types, including any signed, unsigned, and cv-qualified 
 // variants. Otherwise, value is equal to false.
 template <class T>
-struct is_integral : 
-	public bool_constant<
-		is_same<bool, typename remove_cv<T>::type>::value
-		|| is_same<char, typename remove_cv<T>::type>::value
-		|| is_same<unsigned char, typename remove_cv<T>::type>::value
-		// || is_same<char8_t, typename remove_cv<T>::type>::value // c++20 has the type
-		|| is_same<char16_t, typename remove_cv<T>::type>::value
-		|| is_same<char32_t, typename remove_cv<T>::type>::value
-		|| is_same<wchar_t, typename remove_cv<T>::type>::value
-		|| is_same<short, typename remove_cv<T>::type>::value
-		|| is_same<unsigned short, typename remove_cv<T>::type>::value
-		|| is_same<int, typename remove_cv<T>::type>::value
-		|| is_same<unsigned int, typename remove_cv<T>::type>::value
-		|| is_same<long, typename remove_cv<T>::type>::value
-		|| is_same<unsigned long, typename remove_cv<T>::type>::value
-		|| is_same<long long, typename remove_cv<T>::type>::value
-		|| is_same<unsigned long long, typename remove_cv<T>::type>::value
-		|| is_same<std::int8_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int16_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int32_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int64_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_fast8_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_fast16_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_fast32_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_fast64_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_least8_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_least16_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_least32_t, typename remove_cv<T>::type>::value
-		|| is_same<std::int_least64_t, typename remove_cv<T>::type>::value
-		|| is_same<std::intmax_t, typename remove_cv<T>::type>::value
-		|| is_same<std::intptr_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint8_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint16_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint32_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint64_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_fast8_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_fast16_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_fast32_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_fast64_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_least8_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_least16_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_least32_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uint_least64_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uintmax_t, typename remove_cv<T>::type>::value
-		|| is_same<std::uintptr_t, typename remove_cv<T>::type>::value
-		> {};
+struct is_integral : public detail::has_category<T, category_integral> {};
 
 // Checks whether T is a floating-point type. Provides the member constant value
 // which is equal to true, if T is the type float, double, long double, including
 // any cv-qualified variants. Otherwise, value is equal to false.
 template <class T>
-struct is_floating_point :
-    public bool_constant<
-        is_same<float, typename remove_cv<T>::type>::value
-        || is_same<double, typename remove_cv<T>::type>::value
-        || is_same<long double, typename remove_cv<T>::type>::value
-    > {};
+struct is_floating_point : public detail::has_category<T, category_floating_point> {};
 
 // Checks whether T is an array type with bound. Provides the member constant value which is 
 // equal to true, if T is an array type with bound. Otherwise, value is equal to false.
@@ -127,33 +270,28 @@ struct is_unbounded_array<T[]> : public true_type {};
 // Checks whether T is an array type. Provides the member constant value which is 
 // equal to true, if T is an array type. Otherwise, value is equal to false.
 template <class T>
-struct is_array : public bool_constant<
-    is_bounded_array<T>::value
-    || is_unbounded_array<T>::value> {};
-
-
-namespace detail {
-    // Implementation detail
-    // 1. SFINAE
-    // 2. if T is class/union then T::* is well-formed
-    // 3. the int T::* don't mean T must has a member which type is int
-    //      until we set it, like (int T::*m = &T::member), now we just
-    //      do a declaration, so it is just fine
-	template <class T> true_type is_class_or_union(int T::*);
-	template <class T> false_type is_class_or_union(...);
-}
+struct is_array : public detail::has_category<T, category_array> {};
 
 // Checks whether T is a union class type.
 // Implemention Note:
-//      1. We can't distinguish between class and union
-//      2. is_union need some compoiler feature so use the std version
+//      1. The builtin is used directly when available, it is cheaper
+//          than the type_category lookup
+#if defined(META_BUILTIN_IS_UNION)
 template <class T>
-using is_union = std::is_union<T>;
+struct is_union : public bool_constant<META_BUILTIN_IS_UNION(T)> {};
+#else
+template <class T>
+struct is_union : public detail::has_category<T, category_union> {};
+#endif
 
 //Checks whether T is a non-union class type.
+#if defined(META_BUILTIN_IS_CLASS)
 template <class T>
-struct is_class : public bool_constant<decltype(detail::is_class_or_union<T>(0))::value && !is_union<T>::value> {};
-
+struct is_class : public bool_constant<META_BUILTIN_IS_CLASS(T)> {};
+#else
+template <class T>
+struct is_class : public detail::has_category<T, category_class> {};
+#endif
 
 // Checks whether T is a function type. Types like 
 // 		1. std::function
@@ -163,242 +301,58 @@ struct is_class : public bool_constant<decltype(detail::is_class_or_union<T>(0))
 //		5. member functions
 // don't count as function types. 
 // Implementation Note:
-// The cases are very many:
-// 1. regular functions (1)
-// 2. variadic functions (1)
-// 3. functions with cv-qualifiers (4)
-// 4. ref-qualifiers (3)
-// 5. noexcept version functions (2)
-// 6. sum = (1+1) * 4 * 3 * 2 = 48
-
-// primary template
+// Instead of one specialization for every combination of variadic, cv-, ref- and
+// noexcept qualifiers (96 cases), functions are the types that can't be
+// const-qualified, see detail::is_function_type. function_traits (function_traits.h)
+// decomposes the function types
+#if defined(META_BUILTIN_IS_FUNCTION)
 template <class T>
-struct is_function : public false_type {};
-
-// regular functions
-template <class R, class... ARGS>
-struct is_function<R(ARGS...)> : true_type {};
-
-// variadic functions
-template <class R, class... ARGS> 
-struct is_function<R(ARGS..., ...)> : true_type {};
-
-// cv-qualifiers
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS...) const> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS...) volatile> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS...) const volatile> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS..., ...) const> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS...,...) volatile> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS...,...) const volatile> : true_type {};
-
-// ref-qualifiers
-template <class R, class... ARGS> // regular
-struct is_function<R(ARGS...) &> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS...) const &> : true_type {};
-
-template <class R, class... ARGS> // volatile
-struct is_function<R(ARGS...) volatile &> : true_type {};
-
-template <class R, class... ARGS> // const volatile
-struct is_function<R(ARGS...) const volatile &> : true_type {};
-
-template <class R, class... ARGS> // variadic
-struct is_function<R(ARGS..., ...) &> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS..., ...) const &> : true_type {};
-
-template <class R, class... ARGS> // volatile
-struct is_function<R(ARGS..., ...) volatile &> : true_type {};
-
-template <class R, class... ARGS> // const volatile
-struct is_function<R(ARGS..., ...) const volatile &> : true_type {};
-
-template <class R, class... ARGS> // regular
-struct is_function<R(ARGS...) &&> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS...) const &&> : true_type {};
-
-template <class R, class... ARGS> // volatile
-struct is_function<R(ARGS...) volatile &&> : true_type {};
-
-template <class R, class... ARGS> // const volatile
-struct is_function<R(ARGS...) const volatile &&> : true_type {};
-
-template <class R, class... ARGS> // variadic
-struct is_function<R(ARGS..., ...) &&> : true_type {};
-
-template <class R, class... ARGS> // const
-struct is_function<R(ARGS..., ...) const &&> : true_type {};
-
-template <class R, class... ARGS> // volatile
-struct is_function<R(ARGS..., ...) volatile &&> : true_type {};
-
-template <class R, class... ARGS> // const volatile
-struct is_function<R(ARGS..., ...) const volatile &&> : true_type {};
-
-// noexcept (C++17 and later)
-// template <class R, class... ARGS> // regular
-// struct is_function<R(ARGS...) noexcept> : true_type {};
-
-// template <class R, class... ARGS>  // variadic
-// struct is_function<R(ARGS..., ...) noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS...) const noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS...) volatile noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS...) const volatile noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS..., ...) const noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS..., ...) volatile noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS..., ...) const volatile noexcept> : true_type {};
-
-// template <class R, class... ARGS> // regular
-// struct is_function<R(ARGS...) & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS...) const & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // volatile
-// struct is_function<R(ARGS...) volatile & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const volatile
-// struct is_function<R(ARGS...) const volatile & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // variadic
-// struct is_function<R(ARGS..., ...) & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS..., ...) const & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // volatile
-// struct is_function<R(ARGS..., ...) volatile & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const volatile
-// struct is_function<R(ARGS..., ...) const volatile & noexcept> : true_type {};
-
-// template <class R, class... ARGS> // regular
-// struct is_function<R(ARGS...) && noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS...) const && noexcept> : true_type {};
-
-// template <class R, class... ARGS> // volatile
-// struct is_function<R(ARGS...) volatile && noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const volatile
-// struct is_function<R(ARGS...) const volatile && noexcept> : true_type {};
-
-// template <class R, class... ARGS> // variadic
-// struct is_function<R(ARGS..., ...) && noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const
-// struct is_function<R(ARGS..., ...) const && noexcept> : true_type {};
-
-// template <class R, class... ARGS> // volatile
-// struct is_function<R(ARGS..., ...) volatile && noexcept> : true_type {};
-
-// template <class R, class... ARGS> // const volatile
-// struct is_function<R(ARGS..., ...) const volatile && noexcept> : true_type {};
+struct is_function : public bool_constant<META_BUILTIN_IS_FUNCTION(T)> {};
+#else
+template <class T>
+struct is_function : public detail::has_category<T, category_function> {};
+#endif
 
 // Checks whether T is a pointer to object or a pointer to function, except :
 // 		1. pointer to member/member function
 template <class T>
-struct is_pointer : public false_type {};
-
-template <class T>
-struct is_pointer<T*> : public true_type {};
+struct is_pointer : public detail::has_category<T, category_pointer> {};
 
 // Checks whether T is a lvalue reference type
 template <class T>
-struct is_lvalue_reference : public false_type {};
-
-template <class T>
-struct is_lvalue_reference<T&> : public true_type {};
+struct is_lvalue_reference : public detail::has_category<T, category_lvalue_reference> {};
 
 // Checks whether T is a rvalue reference type
 template <class T>
-struct is_rvalue_reference : public false_type {};
+struct is_rvalue_reference : public detail::has_category<T, category_rvalue_reference> {};
 
+// Checks whether T is a reference type
 template <class T>
-struct is_rvalue_reference<T&&> : public true_type {};
-
-// Checks whether T is a rvalue reference type
-template <class T>
-struct is_reference 
-	: public bool_constant<
-		is_lvalue_reference<T>::value
-		|| is_rvalue_reference<T>::value
-	> {};
+struct is_reference : public detail::has_category<T, category_reference> {};
 
 // Checks whether T is a non-static member function.
 template <class T>
-struct is_member_function_pointer_helper : public false_type {};
-
-template <class T, class U>
-struct is_member_function_pointer_helper<T U::*> : public is_function<T> {};
-
-template <class T>
-struct is_member_function_pointer : public is_member_function_pointer_helper<typename remove_cv<T>::type> {};
+struct is_member_function_pointer : public detail::has_category<T, category_member_function_pointer> {};
 
 // Checks whether T is a non-static member pointer.
 template <class T>
-struct is_member_pointer_helper : public false_type {};
-
-template <class T, class U>
-struct is_member_pointer_helper<T U::*> : public true_type {};
-
-template <class T>
-struct is_member_pointer : public is_member_pointer_helper<typename remove_cv<T>::type> {};
+struct is_member_pointer : public detail::has_category<T, category_member_pointer> {};
 
 // Checks whether T is a non-static member object.
 template <class T>
-struct is_member_object_pointer : bool_constant<is_member_pointer<T>::value && !is_member_function_pointer<T>::value> {};
-
+struct is_member_object_pointer : public detail::has_category<T, category_member_object_pointer> {};
 
 // Checks whether T is an enumeration type. 
 // Implemetation Note:
-// 1. We can't implement it directly, so use the exclusion
-template <class T>
-struct is_enum :
-	public bool_constant<
-        ! is_void<T>::value
-        && ! is_null_pointer<T>::value
-        && ! is_integral<T>::value
-        && ! is_floating_point<T>::value
-        && ! is_array<T>::value
-        && ! is_union<T>::value
-        && ! is_class<T>::value
-        && ! is_function<T>::value
-        && ! is_pointer<T>::value
-        && ! is_lvalue_reference<T>::value
-        && ! is_rvalue_reference<T>::value
-        && ! is_member_function_pointer<T>::value
-        && ! is_member_object_pointer<T>::value
-    > {};
+// 1. Without the builtin we can't implement it directly, so the
+//      classification uses the exclusion
+#if defined(META_BUILTIN_IS_ENUM)
+template <class T>
+struct is_enum : public bool_constant<META_BUILTIN_IS_ENUM(T)> {};
+#else
+template <class T>
+struct is_enum : public detail::has_category<T, category_enum> {};
+#endif
 
 /***************************** Composite type categories ******************
 Provides the member constant value that is equal to true, if T is the type
@@ -406,6 +360,11 @@ Provides the member constant value that is equal to true, if T is the type
 2. const P
 3. volatile P
 4. const volatile P
+Implementation Note:
+1. A composite category is a mask over type_category, not a disjunction of
+    the primary traits, so is_scalar<T> is one lookup whatever T is. Use
+    conjunction/disjunction (type_traits_helper.h) to join traits which
+    are not categories, like is_trivially_copyable and is_pointer
 **************************************************************************/
 
 // Check if T is an arithmetic type (that is, 
@@ -413,23 +372,14 @@ Provides the member constant value that is equal to true, if T is the type
 //		2. or a floating-point type)
 // or a cv-qualified version thereof
 template <class T>
-struct is_arithmetic : 
-	public bool_constant<
-		is_integral<T>::value
-		|| is_floating_point<T>::value
-	>{};
+struct is_arithmetic : public detail::has_category<T, category_arithmetic> {};
 
 // Check if T is a fundamental type (that is, 
 //		1. arithmetic type
 //		2. or void
 //		3. or nullptr_t)
 template <class T>
-struct is_fundamental :
-	public bool_constant<
-		is_arithmetic<T>::value
-		|| is_void<T>::value
-		|| is_null_pointer<T>::value
-	>{};
+struct is_fundamental : public detail::has_category<T, category_fundamental> {};
 
 // Check if T is a scalar type (that is a possibly cv-qualified
 //		1. arithmetic
@@ -438,26 +388,15 @@ struct is_fundamental :
 //		4. enumeration
 //		5. or std::nullptr_t type)
 template <class T>
-struct is_scalar :
-	public bool_constant<
-		is_arithmetic<T>::value
-		|| is_pointer<T>::value
-		|| is_member_pointer<T>::value
-		|| is_enum<T>::value
-		|| is_null_pointer<T>::value
-	> {};
+struct is_scalar : public detail::has_category<T, category_scalar> {};
 
 // Check if T is an object type (that is any possibly cv-qualified type other than
 //		1. function
 //		2. reference
 //		3. or void types)
 template <class T>
-struct is_object :
-	public bool_constant<
-		!is_function<T>::value
-		&& !is_reference<T>::value
-		&& !is_void<T>::value
-	> {};
+struct is_object : public bool_constant<
+    !detail::has_category<T, category_function | category_reference | category_void>::value> {};
 
 // Check if T is a compound type (that is, 
 //		1. array
@@ -472,8 +411,233 @@ struct is_object :
 //		10. or enumeration, 
 // including any cv-qualified variants)
 template <class T>
-struct is_compound : public bool_constant<!is_fundamental<T>::value> {};
+struct is_compound : public bool_constant<!detail::has_category<T, category_fundamental>::value> {};
+
+/***************************** Type properties ****************************
+Properties which the type category can't tell for classes, they need the
+compiler, so without the builtin they forward to <type_traits>.
+**************************************************************************/
+
+// Checks whether T is a trivially copyable type, so its object representation
+// can be copied with memcpy (scalars, trivially copyable classes, arrays of them,
+// and cv-qualified versions thereof).
+#if defined(META_BUILTIN_IS_TRIVIALLY_COPYABLE)
+template <class T>
+struct is_trivially_copyable : public bool_constant<META_BUILTIN_IS_TRIVIALLY_COPYABLE(T)> {};
+#else
+template <class T>
+struct is_trivially_copyable : public bool_constant<std::is_trivially_copyable<T>::value> {};
+#endif
+
+// Checks whether T is destructible and its destructor does nothing (scalars,
+// references, classes without user-provided destructor whose members and bases
+// are trivially destructible, and arrays of them).
+#if defined(META_BUILTIN_IS_TRIVIALLY_DESTRUCTIBLE)
+template <class T>
+struct is_trivially_destructible : public bool_constant<META_BUILTIN_IS_TRIVIALLY_DESTRUCTIBLE(T)> {};
+#else
+template <class T>
+struct is_trivially_destructible : public bool_constant<std::is_trivially_destructible<T>::value> {};
+#endif
+
+// Checks whether an object of T can be relocated, moved to new storage and the
+// original destroyed, by copying its bytes. True for trivially copyable types;
+// specialize it for the types which own resources through pointers that don't
+// point into the object itself (unique_ptr, most handles). The unique_ptr
+// specialization is in algorithm.h, which includes <memory>.
+// Example:
+//      template <> struct is_trivially_relocatable<Foo> : public true_type {};
+// Implementation Note:
+// 1. It is opt-in, the compiler can't tell, so is_trivially_relocatable_v
+//      reads the struct and sees the specializations
+template <class T>
+struct is_trivially_relocatable : public bool_constant<is_trivially_copyable<T>::value> {};
+
+// std::pair is relocated by relocating its members
+template <class T1, class T2>
+struct is_trivially_relocatable<std::pair<T1, T2>>
+    : public conjunction<is_trivially_relocatable<T1>, is_trivially_relocatable<T2>> {};
+
+// Checks whether T is an abstract class, a class with a pure virtual function
+// which can't be instantiated.
+#if defined(META_BUILTIN_IS_ABSTRACT)
+template <class T>
+struct is_abstract : public bool_constant<META_BUILTIN_IS_ABSTRACT(T)> {};
+#else
+template <class T>
+struct is_abstract : public bool_constant<std::is_abstract<T>::value> {};
+#endif
+
+// Checks whether T is an aggregate type, an array or a class without user-provided
+// constructors, virtual functions, or private or protected non-static members.
+// Implementation Note:
+// 1. <type_traits> has it since c++17, so without the builtin it is only
+//      defined from c++17
+#if defined(META_BUILTIN_IS_AGGREGATE)
+template <class T>
+struct is_aggregate : public bool_constant<META_BUILTIN_IS_AGGREGATE(T)> {};
+#elif defined(__cpp_lib_is_aggregate)
+template <class T>
+struct is_aggregate : public bool_constant<std::is_aggregate<T>::value> {};
+#endif
+
+// Checks whether T is trivially copyable and two objects of T with the same value
+// have the same bytes, so it has no padding and its bytes can be hashed or compared
+// (integral types, enums, pointers, classes of them without padding, and arrays
+// of them; not float and double, +0.0 and -0.0 compare equal).
+// Implementation Note:
+// 1. <type_traits> has it since c++17, before that without the builtin it is
+//      only true for the integral types, enums, pointers and arrays of them
+#if defined(META_BUILTIN_HAS_UNIQUE_OBJECT_REPRESENTATIONS)
+template <class T>
+struct has_unique_object_representations
+    : public bool_constant<META_BUILTIN_HAS_UNIQUE_OBJECT_REPRESENTATIONS(T)> {};
+#elif defined(__cpp_lib_has_unique_object_representations)
+template <class T>
+struct has_unique_object_representations
+    : public bool_constant<std::has_unique_object_representations<T>::value> {};
+#else
+template <class T>
+struct has_unique_object_representations
+    : public detail::has_category<T, category_integral | category_enum | category_pointer> {};
+
+template <class T, size_t N>
+struct has_unique_object_representations<T[N]> : public has_unique_object_representations<T> {};
+#endif
+
+
+/***************************** Helper variable templates ******************
+is_xxx_v<T> is is_xxx<T>::value, but it is computed from type_category (or the
+builtin) directly, so the is_xxx struct is never instantiated.
+Example:
+        static_assert(is_integral_v<int>, "int is integral");
+**************************************************************************/
+#if defined(META_BUILTIN_IS_SAME)
+template <class T, class U>
+META_INLINE_VAR constexpr bool is_same_v = META_BUILTIN_IS_SAME(T, U);
+#else
+template <class T, class U>
+META_INLINE_VAR constexpr bool is_same_v = is_same<T, U>::value;
+#endif
+
+template <class T>
+META_INLINE_VAR constexpr unsigned type_category_v = type_category<T>::value;
+
+namespace detail {
+    template <class T, unsigned Mask>
+    META_INLINE_VAR constexpr bool has_category_v = (type_category<T>::value & Mask) != 0;
+}
+
+template <class T>
+META_INLINE_VAR constexpr bool is_void_v = detail::has_category_v<T, category_void>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_null_pointer_v = detail::has_category_v<T, category_null_pointer>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_integral_v = detail::has_category_v<T, category_integral>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_floating_point_v = detail::has_category_v<T, category_floating_point>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_bounded_array_v = is_bounded_array<T>::value;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_unbounded_array_v = is_unbounded_array<T>::value;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_array_v = detail::has_category_v<T, category_array>;
+
+#if defined(META_BUILTIN_IS_UNION)
+template <class T>
+META_INLINE_VAR constexpr bool is_union_v = META_BUILTIN_IS_UNION(T);
+#else
+template <class T>
+META_INLINE_VAR constexpr bool is_union_v = detail::has_category_v<T, category_union>;
+#endif
+
+#if defined(META_BUILTIN_IS_CLASS)
+template <class T>
+META_INLINE_VAR constexpr bool is_class_v = META_BUILTIN_IS_CLASS(T);
+#else
+template <class T>
+META_INLINE_VAR constexpr bool is_class_v = detail::has_category_v<T, category_class>;
+#endif
+
+#if defined(META_BUILTIN_IS_FUNCTION)
+template <class T>
+META_INLINE_VAR constexpr bool is_function_v = META_BUILTIN_IS_FUNCTION(T);
+#else
+template <class T>
+META_INLINE_VAR constexpr bool is_function_v = detail::has_category_v<T, category_function>;
+#endif
+
+template <class T>
+META_INLINE_VAR constexpr bool is_pointer_v = detail::has_category_v<T, category_pointer>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_lvalue_reference_v = detail::has_category_v<T, category_lvalue_reference>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_rvalue_reference_v = detail::has_category_v<T, category_rvalue_reference>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_reference_v = detail::has_category_v<T, category_reference>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_member_function_pointer_v = detail::has_category_v<T, category_member_function_pointer>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_member_pointer_v = detail::has_category_v<T, category_member_pointer>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_member_object_pointer_v = detail::has_category_v<T, category_member_object_pointer>;
+
+#if defined(META_BUILTIN_IS_ENUM)
+template <class T>
+META_INLINE_VAR constexpr bool is_enum_v = META_BUILTIN_IS_ENUM(T);
+#else
+template <class T>
+META_INLINE_VAR constexpr bool is_enum_v = detail::has_category_v<T, category_enum>;
+#endif
+
+template <class T>
+META_INLINE_VAR constexpr bool is_arithmetic_v = detail::has_category_v<T, category_arithmetic>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_fundamental_v = detail::has_category_v<T, category_fundamental>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_scalar_v = detail::has_category_v<T, category_scalar>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_object_v =
+    !detail::has_category_v<T, category_function | category_reference | category_void>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_compound_v = !detail::has_category_v<T, category_fundamental>;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_trivially_copyable_v = is_trivially_copyable<T>::value;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_trivially_destructible_v = is_trivially_destructible<T>::value;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+template <class T>
+META_INLINE_VAR constexpr bool is_abstract_v = is_abstract<T>::value;
+
+template <class T>
+META_INLINE_VAR constexpr bool has_unique_object_representations_v = has_unique_object_representations<T>::value;
+
+#if defined(META_BUILTIN_IS_AGGREGATE) || defined(__cpp_lib_is_aggregate)
+template <class T>
+META_INLINE_VAR constexpr bool is_aggregate_v = is_aggregate<T>::value;
+#endif
 
 NS_META_END
 
-#endif // type_traits_type_h
+#endif // type_traits_type_h
\ No newline at end of file
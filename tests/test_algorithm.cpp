@@ -0,0 +1,160 @@
+#include "catch2/catch.hpp"
+#include "algorithm.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+USE_META
+
+namespace {
+	struct TestPod {
+		int i;
+		double d;
+	};
+
+	enum TestEnum { TestEnumA = 1 };
+
+	// counts the live objects, throws on the throw_at-th construction
+	struct TestCounted {
+		static int live;
+		static int throw_at;
+
+		int value;
+
+		TestCounted() : value(7) { construct(); }
+		TestCounted(const TestCounted& other) : value(other.value) { construct(); }
+		~TestCounted() { --live; }
+
+		static void construct() {
+			if (throw_at > 0 && --throw_at == 0) {
+				throw 1;
+			}
+			++live;
+		}
+	};
+
+	int TestCounted::live = 0;
+	int TestCounted::throw_at = 0;
+}
+
+TEST_CASE("bulk memory dispatch", "[algorithm]" ) {
+	REQUIRE(detail::is_bitwise_copy<int*, int*>());
+	REQUIRE(detail::is_bitwise_copy<const int*, int*>());
+	REQUIRE(detail::is_bitwise_copy<TestPod*, TestPod*>());
+	REQUIRE_FALSE(detail::is_bitwise_copy<int*, const int*>());
+	REQUIRE_FALSE(detail::is_bitwise_copy<volatile int*, volatile int*>());
+	REQUIRE_FALSE(detail::is_bitwise_copy<int*, long*>());
+	REQUIRE_FALSE(detail::is_bitwise_copy<std::string*, std::string*>());
+	REQUIRE_FALSE(detail::is_bitwise_copy<std::vector<int>::iterator, int*>());
+
+	REQUIRE(detail::is_bitwise_fill<double*>());
+	REQUIRE_FALSE(detail::is_bitwise_fill<TestCounted*>());
+
+	REQUIRE(detail::is_zero_construct<int*>());
+	REQUIRE(detail::is_zero_construct<TestEnum*>());
+	REQUIRE(detail::is_zero_construct<void**>());
+	REQUIRE_FALSE(detail::is_zero_construct<int TestPod::**>());
+	REQUIRE_FALSE(detail::is_zero_construct<TestPod*>());
+}
+
+TEST_CASE("bulk memory algorithms", "[algorithm]" ) {
+	SECTION("copy_n / move_n") {
+		const int src[] = {1, 2, 3, 4, 5};
+		int dst[5] = {};
+		REQUIRE(metaprogram::copy_n(src, 5, dst) == dst + 5);
+		REQUIRE(std::vector<int>(dst, dst + 5) == std::vector<int>(src, src + 5));
+		REQUIRE(metaprogram::copy_n(src, 0, dst) == dst);
+		REQUIRE(metaprogram::copy_n(src, -1, dst) == dst);
+
+		// overlapping ranges are fine when the output starts before the input
+		int overlap[] = {1, 2, 3, 4, 5};
+		metaprogram::copy_n(overlap + 1, 4, overlap);
+		REQUIRE(std::vector<int>(overlap, overlap + 5) == std::vector<int>({2, 3, 4, 5, 5}));
+
+		std::list<int> in = {6, 7, 8};
+		std::vector<int> out(3);
+		REQUIRE(metaprogram::copy_n(in.begin(), 3, out.begin()) == out.end());
+		REQUIRE(out == std::vector<int>({6, 7, 8}));
+
+		std::string strings[] = {"a", "b"};
+		std::string moved[2];
+		REQUIRE(metaprogram::move_n(strings, 2, moved) == moved + 2);
+		REQUIRE(moved[0] == "a");
+		REQUIRE(moved[1] == "b");
+
+		TestPod pods[] = {{1, 1.5}, {2, 2.5}};
+		TestPod pod_out[2] = {};
+		metaprogram::move_n(pods, 2, pod_out);
+		REQUIRE(pod_out[1].i == 2);
+		REQUIRE(pod_out[1].d == 2.5);
+	}
+
+	SECTION("fill_n") {
+		char chars[4];
+		REQUIRE(metaprogram::fill_n(chars, 4, 'x') == chars + 4);
+		REQUIRE(std::string(chars, 4) == "xxxx");
+
+		int ints[4];
+		metaprogram::fill_n(ints, 4, 0);
+		REQUIRE(std::vector<int>(ints, ints + 4) == std::vector<int>(4, 0));
+		metaprogram::fill_n(ints, 4, -1);
+		REQUIRE(std::vector<int>(ints, ints + 4) == std::vector<int>(4, -1));
+		metaprogram::fill_n(ints, 4, 258);
+		REQUIRE(std::vector<int>(ints, ints + 4) == std::vector<int>(4, 258));
+
+		double doubles[3];
+		metaprogram::fill_n(doubles, 3, 1);
+		REQUIRE(doubles[2] == 1.0);
+
+		std::vector<std::string> strings(2);
+		metaprogram::fill_n(strings.begin(), 2, "s");
+		REQUIRE(strings == std::vector<std::string>(2, "s"));
+	}
+
+	SECTION("uninitialized_copy / destroy") {
+		const double src[] = {1.5, 2.5};
+		alignas(double) unsigned char raw[sizeof(src)];
+		double* dst = reinterpret_cast<double*>(raw);
+		REQUIRE(metaprogram::uninitialized_copy(src, src + 2, dst) == dst + 2);
+		REQUIRE(dst[1] == 2.5);
+		metaprogram::destroy(dst, dst + 2);
+
+		TestCounted counted[3];
+		alignas(TestCounted) unsigned char storage[sizeof(counted)];
+		TestCounted* out = reinterpret_cast<TestCounted*>(storage);
+		REQUIRE(metaprogram::uninitialized_copy(counted, counted + 3, out) == out + 3);
+		REQUIRE(TestCounted::live == 6);
+		metaprogram::destroy(out, out + 3);
+		REQUIRE(TestCounted::live == 3);
+
+		// the objects constructed before the exception are destroyed
+		TestCounted::throw_at = 2;
+		REQUIRE_THROWS(metaprogram::uninitialized_copy(counted, counted + 3, out));
+		REQUIRE(TestCounted::live == 3);
+	}
+
+	SECTION("uninitialized_value_construct") {
+		int ints[3] = {1, 2, 3};
+		metaprogram::uninitialized_value_construct(ints, ints + 3);
+		REQUIRE(std::vector<int>(ints, ints + 3) == std::vector<int>(3, 0));
+
+		const void* pointers[2] = {ints, ints};
+		metaprogram::uninitialized_value_construct(pointers, pointers + 2);
+		REQUIRE(pointers[1] == nullptr);
+
+		TestPod pods[2] = {{1, 1.5}, {2, 2.5}};
+		metaprogram::uninitialized_value_construct(pods, pods + 2);
+		REQUIRE(pods[1].i == 0);
+		REQUIRE(pods[1].d == 0.0);
+
+		alignas(TestCounted) unsigned char storage[2 * sizeof(TestCounted)];
+		TestCounted* counted = reinterpret_cast<TestCounted*>(storage);
+		int live = TestCounted::live;
+		metaprogram::uninitialized_value_construct(counted, counted + 2);
+		REQUIRE(counted[1].value == 7);
+		REQUIRE(TestCounted::live == live + 2);
+		metaprogram::destroy(counted, counted + 2);
+		REQUIRE(TestCounted::live == live);
+	}
+}
@@ -0,0 +1,206 @@
+#include "catch2/catch.hpp"
+#include "arena.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+USE_META
+
+namespace {
+	struct TestTrivial {
+		int a;
+		double b;
+	};
+
+	// counts the live instances
+	struct TestCounted {
+		static int live;
+		static std::vector<int> destroyed;
+
+		int id;
+
+		explicit TestCounted(int i = 0) : id(i) { ++live; }
+		~TestCounted() { --live; destroyed.push_back(id); }
+	};
+
+	int TestCounted::live = 0;
+	std::vector<int> TestCounted::destroyed;
+
+	struct TestThrowing {
+		TestThrowing() { throw 1; }
+	};
+
+	struct alignas(64) TestOveraligned {
+		char bytes[64];
+	};
+
+	bool is_aligned(const void* p, size_t alignment) {
+		return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+	}
+}
+
+TEST_CASE("arena", "[arena]" ) {
+	SECTION("bump allocation") {
+		arena a(256);
+		TestTrivial* t = a.make<TestTrivial>(TestTrivial{1, 2.5});
+		REQUIRE(t->a == 1);
+		REQUIRE(t->b == 2.5);
+		REQUIRE(is_aligned(t, alignof(TestTrivial)));
+
+		char* c = a.make<char>('x');
+		int64_t* i = a.make<int64_t>(7);
+		REQUIRE(*c == 'x');
+		REQUIRE(is_aligned(i, alignof(int64_t)));
+		REQUIRE(reinterpret_cast<char*>(i) - c < 16);
+
+		TestOveraligned* o = a.make<TestOveraligned>();
+		REQUIRE(is_aligned(o, 64));
+
+		// larger than a block
+		int* big = a.make_array<int>(1000);
+		REQUIRE(big[999] == 0);
+		big[999] = 1;
+	}
+
+	SECTION("destructors") {
+		TestCounted::live = 0;
+		TestCounted::destroyed.clear();
+		{
+			arena a;
+			a.make<TestCounted>(1);
+			a.make<TestTrivial>();
+			a.make<TestCounted>(2);
+			TestCounted* array = a.make_array<TestCounted>(3);
+			REQUIRE(array[2].id == 0);
+			array[2].id = 5;
+			REQUIRE(TestCounted::live == 5);
+
+			a.reset();
+			REQUIRE(TestCounted::live == 0);
+			REQUIRE(TestCounted::destroyed == std::vector<int>({0, 0, 5, 2, 1}));
+
+			a.make<TestCounted>(3);
+			REQUIRE(TestCounted::live == 1);
+		}
+		REQUIRE(TestCounted::live == 0);
+
+		// a standard type, whose destroy isn't found by adl
+		arena strings;
+		std::string* s = strings.make<std::string>(100, 's');
+		strings.make_array<std::string>(2)[1] = *s;
+		strings.reset();
+
+		// a throwing constructor leaves nothing registered
+		arena a;
+		REQUIRE_THROWS(a.make<TestThrowing>());
+		REQUIRE_THROWS(a.make_array<TestThrowing>(2));
+		a.reset();
+	}
+
+	SECTION("reset keeps a block") {
+		arena a(64);
+		for (int i = 0; i < 100; ++i) {
+			a.make<TestTrivial>();
+		}
+		a.reset();
+		const size_t available = a.available();
+		REQUIRE(available >= 64);
+		void* first = a.allocate(8);
+		a.reset();
+		REQUIRE(a.allocate(8) == first);
+		a.release();
+		REQUIRE(a.available() == 0);
+	}
+
+	SECTION("initial buffer") {
+		alignas(16) char buffer[128];
+		arena a(buffer, sizeof(buffer));
+		void* p = a.allocate(100, 1);
+		REQUIRE(p == buffer);
+		void* q = a.allocate(100, 1);
+		REQUIRE((q < buffer || q >= buffer + sizeof(buffer)));
+		a.reset();
+		REQUIRE(a.allocate(100, 1) != p);
+		a.release();
+		REQUIRE(a.allocate(100, 1) == buffer);
+	}
+
+	SECTION("rewind") {
+		TestCounted::live = 0;
+		arena a(64);
+		a.make<TestCounted>(1);
+		const arena::marker m = a.mark();
+		void* next = a.allocate(8);
+		a.rewind(m);
+		for (int i = 0; i < 50; ++i) {
+			a.make<TestCounted>(i);
+		}
+		REQUIRE(TestCounted::live == 51);
+		a.rewind(m);
+		REQUIRE(TestCounted::live == 1);
+		REQUIRE(a.allocate(8) == next);
+	}
+
+	SECTION("scopes reuse the freed block") {
+		arena a(64);
+		void* first = nullptr;
+		for (int i = 0; i < 1000; ++i) {
+			arena_scope scope(a);
+			void* p = a.allocate(48);
+			a.allocate(200);
+			// the spare block grows to fit a whole scope, then it stays
+			if (i == 10) {
+				first = p;
+			}
+			REQUIRE((i < 10 || p == first));
+		}
+	}
+
+	SECTION("thread arena") {
+		TestCounted::live = 0;
+		thread_arena().make<TestCounted>(0);
+		{
+			arena_scope scope;
+			thread_arena().make<TestCounted>(1);
+			thread_arena().make_array<TestCounted>(100);
+			REQUIRE(TestCounted::live == 102);
+		}
+		REQUIRE(TestCounted::live == 1);
+		thread_arena().reset();
+		REQUIRE(TestCounted::live == 0);
+	}
+
+	SECTION("oversized") {
+		arena a;
+		const size_t max_size = size_t(-1);
+		// the block size would overflow while it doubles, or right away
+		REQUIRE_THROWS_AS(a.allocate(max_size / 2 + 100), std::bad_alloc);
+		REQUIRE_THROWS_AS(a.allocate(max_size - 8), std::bad_alloc);
+		// the size of the elements doesn't fit in size_t
+		REQUIRE_THROWS_AS(a.make_array<TestOveraligned>(max_size / sizeof(TestOveraligned) + 2),
+			std::bad_array_new_length);
+		REQUIRE_THROWS_AS(arena_allocator<TestTrivial>(a).allocate(max_size / sizeof(TestTrivial) + 1),
+			std::bad_array_new_length);
+		REQUIRE(*a.make<int>(3) == 3);
+	}
+
+	SECTION("allocator") {
+		arena a;
+		std::vector<int, arena_allocator<int>> v{arena_allocator<int>(a)};
+		for (int i = 0; i < 1000; ++i) {
+			v.push_back(i);
+		}
+		REQUIRE(v[999] == 999);
+
+		using string_allocator = arena_allocator<std::pair<const int, std::string>>;
+		std::map<int, std::string, std::less<int>, string_allocator> m{std::less<int>(), string_allocator(a)};
+		m[1] = "one";
+		m[2] = std::string(100, 'x');
+		REQUIRE(m.size() == 2);
+		REQUIRE(arena_allocator<int>(a) == arena_allocator<char>(a));
+		arena b;
+		REQUIRE(arena_allocator<int>(a) != arena_allocator<int>(b));
+	}
+}
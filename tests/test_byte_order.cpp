@@ -0,0 +1,134 @@
+#include "catch2/catch.hpp"
+#include "byte_order.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+USE_META
+
+namespace {
+	// the bytes of value, reversed
+	template <class T>
+	T reversed(T value) {
+		unsigned char bytes[sizeof(T)];
+		std::memcpy(bytes, &value, sizeof(T));
+		for (size_t i = 0; i < sizeof(T) / 2; ++i) {
+			const unsigned char byte = bytes[i];
+			bytes[i] = bytes[sizeof(T) - 1 - i];
+			bytes[sizeof(T) - 1 - i] = byte;
+		}
+		std::memcpy(&value, bytes, sizeof(T));
+		return value;
+	}
+
+	template <class T>
+	bool same_bytes(T a, T b) {
+		return std::memcmp(&a, &b, sizeof(T)) == 0;
+	}
+
+	template <class T>
+	void check_byteswap_n() {
+		for (size_t n : {0, 1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 255, 1000}) {
+			std::vector<T> in(n);
+			for (size_t i = 0; i < n; ++i) {
+				in[i] = static_cast<T>(i * 2654435761u + 12345);
+			}
+			std::vector<T> out(n);
+			byteswap_n(in.data(), n, out.data());
+			std::vector<T> big(n);
+			to_big_n(in.data(), n, big.data());
+			std::vector<T> little(n);
+			to_little_n(in.data(), n, little.data());
+			for (size_t i = 0; i < n; ++i) {
+				REQUIRE(same_bytes(out[i], reversed(in[i])));
+				REQUIRE(same_bytes(big[i], to_big(in[i])));
+				REQUIRE(same_bytes(little[i], to_little(in[i])));
+			}
+
+			// in place, and back
+			byteswap_n(out.data(), n, out.data());
+			from_big_n(big.data(), n, big.data());
+			from_little_n(little.data(), n, little.data());
+			for (size_t i = 0; i < n; ++i) {
+				REQUIRE(same_bytes(out[i], in[i]));
+				REQUIRE(same_bytes(big[i], in[i]));
+				REQUIRE(same_bytes(little[i], in[i]));
+			}
+		}
+	}
+}
+
+TEST_CASE("byte order", "[byte_order]" ) {
+	SECTION("native") {
+		const uint16_t one = 1;
+		unsigned char first;
+		std::memcpy(&first, &one, 1);
+		REQUIRE((endian::native == endian::little) == (first == 1));
+		REQUIRE((endian::native == endian::big) == (first == 0));
+	}
+
+	SECTION("byteswap") {
+		static_assert(byteswap(uint16_t(0x1234)) == 0x3412, "");
+		static_assert(byteswap(uint32_t(0x12345678)) == 0x78563412u, "");
+		static_assert(byteswap(uint64_t(0x0102030405060708)) == 0x0807060504030201u, "");
+		static_assert(byteswap(int8_t(-5)) == -5, "");
+		static_assert(byteswap(byteswap(int32_t(-123456))) == -123456, "");
+		REQUIRE(byteswap(int16_t(0x0180)) == int16_t(-0x7fff));
+		REQUIRE(byteswap(char16_t(0x00ff)) == char16_t(0xff00));
+		REQUIRE(same_bytes(byteswap(1.5f), reversed(1.5f)));
+		REQUIRE(same_bytes(byteswap(-2.25), reversed(-2.25)));
+		REQUIRE(byteswap(byteswap(3.75)) == 3.75);
+	}
+
+	SECTION("to and from") {
+		const uint32_t value = 0x11223344;
+		unsigned char bytes[4];
+		const uint32_t big = to_big(value);
+		std::memcpy(bytes, &big, 4);
+		REQUIRE(bytes[0] == 0x11);
+		REQUIRE(bytes[3] == 0x44);
+		const uint32_t little = to_little(value);
+		std::memcpy(bytes, &little, 4);
+		REQUIRE(bytes[0] == 0x44);
+		REQUIRE(from_big(big) == value);
+		REQUIRE(from_little(little) == value);
+		REQUIRE(from_big(to_big(-0.5)) == -0.5);
+	}
+
+	SECTION("arrays") {
+		check_byteswap_n<uint8_t>();
+		check_byteswap_n<int16_t>();
+		check_byteswap_n<uint16_t>();
+		check_byteswap_n<int32_t>();
+		check_byteswap_n<uint32_t>();
+		check_byteswap_n<int64_t>();
+		check_byteswap_n<uint64_t>();
+		check_byteswap_n<float>();
+		check_byteswap_n<double>();
+	}
+
+	SECTION("every instruction set") {
+		std::vector<uint32_t> in(100);
+		for (size_t i = 0; i < in.size(); ++i) {
+			in[i] = static_cast<uint32_t>(i * 0x01010101u);
+		}
+		std::vector<uint32_t> out(in.size());
+		detail::run_kernel<detail::byteswap_kernel, 1, 1>(in.data(), in.size(), out.data());
+		REQUIRE(out[99] == reversed(in[99]));
+#if defined(META_TARGET)
+		if (active_simd_isa() >= simd_isa::ssse3) {
+			detail::run_kernel_ssse3<detail::byteswap_kernel, 4, 2>(in.data(), in.size(), out.data());
+			REQUIRE(out[98] == reversed(in[98]));
+		}
+		if (active_simd_isa() >= simd_isa::avx2) {
+			detail::run_kernel_avx2<detail::byteswap_kernel, 8, 2>(in.data(), in.size(), out.data());
+			REQUIRE(out[97] == reversed(in[97]));
+		}
+		if (active_simd_isa() >= simd_isa::avx512) {
+			detail::run_kernel_avx512<detail::byteswap_kernel, 16, 2>(in.data(), in.size(), out.data());
+			REQUIRE(out[96] == reversed(in[96]));
+		}
+#endif
+	}
+}
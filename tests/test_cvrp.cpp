@@ -180,5 +180,35 @@ TEST_CASE("traits cvrp", "[trais][cvrp]" ) {
 
 	SECTION("cvref") {
 		REQUIRE(is_same<int, remove_cvref<const volatile int&>::type>());
+		REQUIRE(is_same<int, remove_cvref<const int&&>::type>());
+		REQUIRE(is_same<int*, remove_cvref<int* const&>::type>());
+	}
+
+	SECTION("alias") {
+		REQUIRE(is_same<int, type_identity_t<int>>());
+
+		REQUIRE(is_same<int, remove_const_t<const int>>());
+		REQUIRE(is_same<int, remove_volatile_t<volatile int>>());
+		REQUIRE(is_same<int, remove_cv_t<const volatile int>>());
+		REQUIRE(is_same<int[3], remove_cv_t<const int[3]>>());
+
+		REQUIRE(is_same<const int, add_const_t<int>>());
+		REQUIRE(is_same<volatile int, add_volatile_t<int>>());
+		REQUIRE(is_same<const volatile int, add_cv_t<int>>());
+		REQUIRE(is_same<int&, add_cv_t<int&>>());
+		REQUIRE(is_same<BasicFunc, add_cv_t<BasicFunc>>());
+
+		REQUIRE(is_same<int, remove_reference_t<int&>>());
+		REQUIRE(is_same<int, remove_reference_t<int&&>>());
+		REQUIRE(is_same<int&, add_lvalue_reference_t<int>>());
+		REQUIRE(is_same<int&&, add_rvalue_reference_t<int>>());
+		REQUIRE(is_same<void, add_lvalue_reference_t<void>>());
+		REQUIRE(is_same<ConstFunc, add_rvalue_reference_t<ConstFunc>>());
+
+		REQUIRE(is_same<int, remove_pointer_t<int* const>>());
+		REQUIRE(is_same<int*, add_pointer_t<int&>>());
+		REQUIRE(is_same<LRefFunc, add_pointer_t<LRefFunc>>());
+
+		REQUIRE(is_same<int, remove_cvref_t<const volatile int&>>());
 	}
 }
\ No newline at end of file
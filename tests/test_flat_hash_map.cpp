@@ -0,0 +1,343 @@
+#include "catch2/catch.hpp"
+#include "flat_hash_map.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#if defined(__cpp_lib_string_view) || __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+USE_META
+
+namespace {
+	// a trivially relocatable class which is not trivially copyable
+	struct TestHandle {
+		std::unique_ptr<int> p;
+
+		explicit TestHandle(int v) : p(new int(v)) {}
+	};
+
+	// larger than a slot may be, counts its live instances
+	struct TestLarge {
+		static int live;
+
+		char bytes[100];
+		int value;
+
+		TestLarge() : value(0) { ++live; }
+		TestLarge(const TestLarge& other) : value(other.value) { ++live; }
+		~TestLarge() { --live; }
+	};
+
+	int TestLarge::live = 0;
+
+	// a key looked up by its id alone
+	struct TestId {
+		int id;
+		std::string name;
+	};
+
+	struct TestIdHash {
+		using is_transparent = void;
+
+		size_t operator()(const TestId& key) const { return hash<int>()(key.id); }
+		size_t operator()(int id) const { return hash<int>()(id); }
+	};
+
+	struct TestIdEqual {
+		using is_transparent = void;
+
+		bool operator()(const TestId& lhs, const TestId& rhs) const { return lhs.id == rhs.id; }
+		bool operator()(const TestId& lhs, int rhs) const { return lhs.id == rhs; }
+	};
+
+	// counts the bytes it holds in a counter shared with its copies
+	template <class T>
+	struct TestCounting {
+		using value_type = T;
+
+		size_t* bytes;
+
+		explicit TestCounting(size_t* counter) : bytes(counter) {}
+
+		template <class U>
+		TestCounting(const TestCounting<U>& other) : bytes(other.bytes) {}
+
+		T* allocate(size_t n) {
+			*bytes += n * sizeof(T);
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* p, size_t n) {
+			*bytes -= n * sizeof(T);
+			std::allocator<T>().deallocate(p, n);
+		}
+
+		template <class U>
+		bool operator==(const TestCounting<U>& other) const { return bytes == other.bytes; }
+
+		template <class U>
+		bool operator!=(const TestCounting<U>& other) const { return bytes != other.bytes; }
+	};
+
+	// every key has the same hash, so every probe goes through the groups
+	struct TestCollide {
+		size_t operator()(int) const { return 0x1234; }
+	};
+
+	template <class M>
+	bool same_entries(const M& map, const std::unordered_map<int, int>& expected) {
+		if (map.size() != expected.size()) {
+			return false;
+		}
+		size_t visited = 0;
+		for (const auto& entry : map) {
+			auto it = expected.find(entry.first);
+			if (it == expected.end() || it->second != entry.second) {
+				return false;
+			}
+			++visited;
+		}
+		return visited == expected.size();
+	}
+}
+
+NS_META_BEG
+template <>
+struct is_trivially_relocatable<TestHandle> : public true_type {};
+NS_META_END
+
+TEST_CASE("flat hash map", "[flat_hash_map]" ) {
+	SECTION("traits") {
+		REQUIRE(!flat_hash_map_uses_nodes<std::pair<const int, int>>::value);
+		REQUIRE(!flat_hash_map_uses_nodes<std::pair<const int, std::string>>::value);
+		// the const key string is copied by a move, which may throw
+		REQUIRE(flat_hash_map_uses_nodes<std::pair<const std::string, std::string>>::value);
+		REQUIRE(!flat_hash_map_uses_nodes<std::pair<const int, TestHandle>>::value);
+		REQUIRE(flat_hash_map_uses_nodes<std::pair<const int, TestLarge>>::value);
+		REQUIRE(is_trivially_relocatable<std::pair<const int, TestHandle>>::value);
+		REQUIRE(!is_trivially_relocatable<std::pair<const int, std::string>>::value);
+	}
+
+	SECTION("empty") {
+		flat_hash_map<int, int> map;
+		REQUIRE(map.empty());
+		REQUIRE(map.capacity() == 0);
+		REQUIRE(map.begin() == map.end());
+		REQUIRE(map.find(1) == map.end());
+		REQUIRE(map.erase(1) == 0);
+		REQUIRE_THROWS_AS(map.at(1), std::out_of_range);
+		map.clear();
+		map.rehash(0);
+		REQUIRE(map.empty());
+	}
+
+	SECTION("insert, find and erase") {
+		flat_hash_map<int, int> map;
+		std::unordered_map<int, int> expected;
+		std::mt19937 rng(7);
+		for (int i = 0; i < 20000; ++i) {
+			const int key = static_cast<int>(rng() % 4096);
+			switch (rng() % 4) {
+			case 0:
+				REQUIRE(map.erase(key) == expected.erase(key));
+				break;
+			case 1:
+				REQUIRE(map.insert(std::make_pair(key, i)).second == expected.insert(std::make_pair(key, i)).second);
+				break;
+			case 2:
+				map[key] = i;
+				expected[key] = i;
+				break;
+			default:
+				REQUIRE(map.contains(key) == (expected.count(key) == 1));
+				break;
+			}
+		}
+		REQUIRE(same_entries(map, expected));
+		REQUIRE(map.load_factor() <= map.max_load_factor());
+
+		for (auto it = map.begin(); it != map.end();) {
+			it = it->first % 2 ? map.erase(it) : std::next(it);
+		}
+		for (auto it = expected.begin(); it != expected.end();) {
+			it = it->first % 2 ? expected.erase(it) : std::next(it);
+		}
+		REQUIRE(same_entries(map, expected));
+	}
+
+	SECTION("emplace") {
+		flat_hash_map<std::string, std::string> map;
+		REQUIRE(map.emplace("a", "1").second);
+		REQUIRE(!map.emplace("a", "2").second);
+		REQUIRE(map.try_emplace("b", 3, 'x').second);
+		REQUIRE(map.at("b") == "xxx");
+		REQUIRE(!map.insert_or_assign("b", "4").second);
+		REQUIRE(map["b"] == "4");
+		REQUIRE(map["c"].empty());
+		REQUIRE(map.size() == 3);
+
+		// the argument is an entry of the map while it grows
+		flat_hash_map<int, int> ints;
+		ints[0] = 42;
+		for (int i = 1; i < 1000; ++i) {
+			ints.insert(*ints.find(0));
+			ints.emplace(i, ints.at(i - 1));
+		}
+		REQUIRE(ints.size() == 1000);
+		REQUIRE(ints.at(999) == 42);
+	}
+
+	SECTION("collisions") {
+		flat_hash_map<int, int, TestCollide> map;
+		for (int i = 0; i < 200; ++i) {
+			map[i] = i;
+		}
+		for (int i = 0; i < 200; i += 2) {
+			REQUIRE(map.erase(i) == 1);
+		}
+		for (int i = 0; i < 200; ++i) {
+			REQUIRE(map.contains(i) == (i % 2 == 1));
+		}
+	}
+
+	SECTION("deleted slots are reused") {
+		flat_hash_map<int, int> map;
+		map.reserve(100);
+		const size_t capacity = map.capacity();
+		for (int i = 0; i < 100000; ++i) {
+			map[i] = i;
+			if (i >= 50) {
+				REQUIRE(map.erase(i - 50) == 1);
+			}
+		}
+		REQUIRE(map.size() == 50);
+		REQUIRE(map.capacity() == capacity);
+		map.rehash(0);
+		REQUIRE(map.capacity() == 63);
+		REQUIRE(map.at(99999) == 99999);
+	}
+
+	SECTION("relocated entries") {
+		flat_hash_map<int, TestHandle> map;
+		for (int i = 0; i < 1000; ++i) {
+			map.emplace(std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(i * 2));
+		}
+		for (int i = 0; i < 1000; ++i) {
+			REQUIRE(*map.at(i).p == i * 2);
+		}
+
+		flat_hash_map<int, std::string> strings;
+		for (int i = 0; i < 1000; ++i) {
+			strings[i] = std::string(40, static_cast<char>('a' + i % 26));
+		}
+		REQUIRE(strings.at(27) == std::string(40, 'b'));
+	}
+
+	SECTION("node entries stay in place") {
+		{
+			flat_hash_map<int, TestLarge> map;
+			TestLarge& first = map[0];
+			first.value = 7;
+			for (int i = 1; i < 1000; ++i) {
+				map[i].value = i;
+			}
+			REQUIRE(&map.at(0) == &first);
+			REQUIRE(first.value == 7);
+			REQUIRE(map.erase(0) == 1);
+			REQUIRE(map.at(999).value == 999);
+			REQUIRE(TestLarge::live == 999);
+
+			// clear, assignment and destruction destroy the nodes
+			map.clear();
+			REQUIRE(TestLarge::live == 0);
+			for (int i = 0; i < 10; ++i) {
+				map[i].value = i;
+			}
+			flat_hash_map<int, TestLarge> copy(map);
+			REQUIRE(TestLarge::live == 20);
+			copy = flat_hash_map<int, TestLarge>();
+			REQUIRE(TestLarge::live == 10);
+		}
+		REQUIRE(TestLarge::live == 0);
+	}
+
+	SECTION("allocator") {
+		using large_map = flat_hash_map<int, TestLarge, hash<int>, std::equal_to<int>,
+			TestCounting<std::pair<const int, TestLarge>>>;
+		size_t bytes = 0;
+		{
+			large_map map{large_map::allocator_type(&bytes)};
+			for (int i = 0; i < 100; ++i) {
+				map[i].value = i;
+			}
+			const size_t slots = bytes - 100 * sizeof(large_map::value_type);
+			REQUIRE(slots >= map.capacity() * sizeof(void*));
+			REQUIRE(map.erase(0) == 1);
+			REQUIRE(bytes == slots + 99 * sizeof(large_map::value_type));
+
+			large_map copy(map);
+			REQUIRE(copy.get_allocator().bytes == &bytes);
+			REQUIRE(copy.at(99).value == 99);
+			map.clear();
+			map.rehash(0);
+			REQUIRE(bytes > 0);
+		}
+		REQUIRE(bytes == 0);
+
+		flat_hash_map<int, int, hash<int>, std::equal_to<int>, TestCounting<std::pair<const int, int>>> ints(
+			0, hash<int>(), std::equal_to<int>(), TestCounting<std::pair<const int, int>>(&bytes));
+		for (int i = 0; i < 1000; ++i) {
+			ints[i] = i;
+		}
+		REQUIRE(bytes >= ints.capacity() * sizeof(std::pair<const int, int>));
+		ints.clear();
+		ints.rehash(0);
+		REQUIRE(bytes == 0);
+	}
+
+	SECTION("heterogeneous lookup") {
+		flat_hash_map<TestId, int, TestIdHash, TestIdEqual> map;
+		map[TestId{1, "one"}] = 10;
+		map[TestId{2, "two"}] = 20;
+		REQUIRE(map.find(1)->first.name == "one");
+		REQUIRE(map.at(2) == 20);
+		REQUIRE(map.count(3) == 0);
+		REQUIRE(map.erase(1) == 1);
+		REQUIRE(!map.contains(1));
+
+		flat_hash_map<std::string, int, hash<std::string>, std::equal_to<>> names;
+		names["alpha"] = 1;
+		const std::vector<char> alpha = {'a', 'l', 'p', 'h', 'a'};
+		REQUIRE(hash<std::string>()(alpha) == hash<std::string>()(std::string("alpha")));
+#if defined(__cpp_lib_string_view)
+		REQUIRE(names.at(std::string_view("alpha")) == 1);
+		REQUIRE(names.erase(std::string_view("alpha")) == 1);
+#endif
+	}
+
+	SECTION("copy and move") {
+		flat_hash_map<int, std::string> map = {{1, "a"}, {2, "b"}, {3, "c"}};
+		flat_hash_map<int, std::string> copy(map);
+		REQUIRE(copy == map);
+		copy[4] = "d";
+		REQUIRE(copy != map);
+		copy = map;
+		REQUIRE(copy == map);
+
+		flat_hash_map<int, std::string> moved(std::move(copy));
+		REQUIRE(moved == map);
+		REQUIRE(copy.empty());
+		copy = std::move(moved);
+		REQUIRE(copy.at(3) == "c");
+		copy.swap(moved);
+		REQUIRE(moved.size() == 3);
+		REQUIRE(copy.empty());
+		copy[5] = "e";
+		REQUIRE(copy.size() == 1);
+	}
+}
@@ -0,0 +1,124 @@
+#include "catch2/catch.hpp"
+#include "function_traits.h"
+
+USE_META
+
+namespace {
+	struct TestClass {
+		int method(float, char) const;
+		void rref_method() &&;
+		long variadic_method(int, ...) volatile &;
+	};
+
+	struct TestFunctor {
+		double operator()(int) const;
+	};
+
+	struct TestDerivedFunctor : TestFunctor {};
+
+	struct TestOverloaded {
+		void operator()(int);
+		void operator()(float);
+	};
+
+	using TestFree = void(int, const TestClass&);
+
+	template <class F, class = void>
+	struct has_traits : false_type {};
+
+	template <class F>
+	struct has_traits<F, decltype((void)function_traits<F>::arity)> : true_type {};
+}
+
+TEST_CASE("function traits", "[function_traits]" ) {
+	SECTION("free function") {
+		using F = function_traits<TestFree>;
+		REQUIRE(is_same<void, F::result_type>());
+		REQUIRE(is_same<type_list<int, const TestClass&>, F::args>());
+		REQUIRE(is_same<const TestClass&, F::arg<1>>());
+		REQUIRE(is_same<void(int, const TestClass&), F::signature>());
+		REQUIRE(is_same<void, F::class_type>());
+		REQUIRE(F::arity == 2);
+		REQUIRE(F::qualifiers == qualifier_none);
+		REQUIRE_FALSE(F::is_variadic);
+
+		// pointers and references to it
+		REQUIRE(is_same<F::args, function_traits<TestFree*>::args>());
+		REQUIRE(is_same<F::args, function_traits<TestFree&>::args>());
+		REQUIRE(is_same<F::args, function_traits<void (* const)(int, const TestClass&)>::args>());
+
+		using V = function_traits<int(const char*, ...)>;
+		REQUIRE(V::is_variadic);
+		REQUIRE(V::arity == 1);
+		REQUIRE(is_same<int(const char*, ...), V::signature>());
+	}
+
+	SECTION("member function pointer") {
+		using M = function_traits<decltype(&TestClass::method)>;
+		REQUIRE(is_same<int, M::result_type>());
+		REQUIRE(is_same<type_list<float, char>, M::args>());
+		REQUIRE(is_same<TestClass, M::class_type>());
+		REQUIRE(M::is_const);
+		REQUIRE_FALSE(M::is_volatile);
+		REQUIRE_FALSE(M::is_lvalue_ref);
+
+		using R = function_traits<decltype(&TestClass::rref_method)>;
+		REQUIRE(R::is_rvalue_ref);
+		REQUIRE(R::arity == 0);
+
+		using V = function_traits<decltype(&TestClass::variadic_method)>;
+		REQUIRE(V::qualifiers == (qualifier_volatile | qualifier_lvalue_ref));
+		REQUIRE(V::is_variadic);
+		REQUIRE(is_same<long(int, ...), V::signature>());
+	}
+
+	SECTION("qualified function types") {
+		REQUIRE(function_traits<void() const volatile &&>::qualifiers
+			== (qualifier_const | qualifier_volatile | qualifier_rvalue_ref));
+		REQUIRE(function_traits<void(int, ...) const &>::qualifiers == (qualifier_const | qualifier_lvalue_ref));
+#if defined(__cpp_noexcept_function_type)
+		REQUIRE(function_traits<void() noexcept>::is_noexcept);
+		REQUIRE(function_traits<void (*)(int) noexcept>::is_noexcept);
+		REQUIRE(function_traits<void (TestClass::*)() const & noexcept>::qualifiers
+			== (qualifier_const | qualifier_lvalue_ref | qualifier_noexcept));
+#endif
+		REQUIRE_FALSE(function_traits<void()>::is_noexcept);
+	}
+
+	SECTION("functor") {
+		auto lambda = [](int, float) { return 'c'; };
+		using L = function_traits<decltype(lambda)>;
+		REQUIRE(is_same<char, L::result_type>());
+		REQUIRE(is_same<type_list<int, float>, L::args>());
+		REQUIRE(is_same<decltype(lambda), L::class_type>());
+		REQUIRE(L::is_const);
+
+		auto mutable_lambda = [](int) mutable {};
+		REQUIRE_FALSE(function_traits<decltype(mutable_lambda)>::is_const);
+
+		using F = function_traits<const TestFunctor&>;
+		REQUIRE(is_same<double, F::result_type>());
+		REQUIRE(is_same<double(int), F::signature>());
+
+		using D = function_traits<TestDerivedFunctor>;
+		REQUIRE(is_same<TestDerivedFunctor, D::class_type>());
+		REQUIRE(is_same<type_list<int>, D::args>());
+	}
+
+	SECTION("not callable") {
+		auto generic_lambda = [](auto) {};
+		REQUIRE_FALSE(has_traits<int>());
+		REQUIRE_FALSE(has_traits<int*>());
+		REQUIRE_FALSE(has_traits<int TestClass::*>());
+		REQUIRE_FALSE(has_traits<TestClass>());
+		REQUIRE_FALSE(has_traits<TestOverloaded>());
+		REQUIRE_FALSE(has_traits<decltype(generic_lambda)>());
+		REQUIRE(has_traits<void()>());
+	}
+
+	SECTION("agrees with the type categories") {
+		REQUIRE(is_function<void(int, ...) const &>());
+		REQUIRE(is_member_function_pointer<decltype(&TestClass::variadic_method)>());
+		REQUIRE_FALSE(is_member_function_pointer<int TestClass::*>());
+	}
+}
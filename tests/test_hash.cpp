@@ -0,0 +1,197 @@
+#include "catch2/catch.hpp"
+#include "hash.h"
+#include "array_view.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+USE_META
+
+namespace {
+	enum class TestColor : uint8_t { red, green, blue };
+
+	struct TestKey {
+		uint32_t id;
+		uint16_t shard;
+		uint16_t kind;
+
+		friend bool operator==(const TestKey& lhs, const TestKey& rhs) {
+			return lhs.id == rhs.id && lhs.shard == rhs.shard && lhs.kind == rhs.kind;
+		}
+	};
+
+	// padding after tag, so it can't be hashed by its bytes
+	struct TestPadded {
+		char tag;
+		int value;
+	};
+
+	struct TestName {
+		std::string first;
+		std::string last;
+	};
+
+	// a class with a constructor, hashed through a specialization
+	class TestPoint {
+	public:
+		TestPoint(int x = 0, int y = 0) : x_(x), y_(y) {}
+		virtual ~TestPoint() {}
+
+		int x_;
+		int y_;
+	};
+
+	std::vector<unsigned char> bytes(size_t n) {
+		std::vector<unsigned char> v(n);
+		for (size_t i = 0; i < n; ++i) {
+			v[i] = static_cast<unsigned char>(i * 131 + 7);
+		}
+		return v;
+	}
+}
+
+NS_META_BEG
+template <>
+struct hash<TestPoint> {
+	size_t operator()(const TestPoint& value) const noexcept {
+		return static_cast<size_t>(hash_combine(hash_mix(value.x_), hash_mix(value.y_)));
+	}
+};
+NS_META_END
+
+TEST_CASE("hash category", "[hash]" ) {
+	REQUIRE(hash_category_of<int>::value == hash_scalar);
+	REQUIRE(hash_category_of<bool>::value == hash_scalar);
+	REQUIRE(hash_category_of<TestColor>::value == hash_scalar);
+	REQUIRE(hash_category_of<const char*>::value == hash_scalar);
+	REQUIRE(hash_category_of<decltype(nullptr)>::value == hash_scalar);
+	REQUIRE(hash_category_of<double>::value == hash_floating_point);
+	REQUIRE(hash_category_of<std::string>::value == hash_range);
+	REQUIRE(hash_category_of<std::vector<std::string>>::value == hash_range);
+	REQUIRE(hash_category_of<array_view<const char>>::value == hash_range);
+	REQUIRE(hash_category_of<float[3]>::value == hash_range);
+	REQUIRE(hash_category_of<TestPoint>::value == hash_none);
+#if defined(META_BUILTIN_HAS_UNIQUE_OBJECT_REPRESENTATIONS) || defined(__cpp_lib_has_unique_object_representations)
+	REQUIRE(hash_category_of<TestKey>::value == hash_bitwise);
+	REQUIRE(hash_category_of<int[4]>::value == hash_bitwise);
+	REQUIRE(!has_unique_object_representations<TestPadded>::value);
+	REQUIRE(!has_unique_object_representations<float>::value);
+#endif
+#if defined(__cpp_structured_bindings)
+	REQUIRE(hash_category_of<TestPadded>::value == hash_fields);
+	REQUIRE(hash_category_of<TestName>::value == hash_fields);
+#endif
+}
+
+TEST_CASE("hash", "[hash]" ) {
+	SECTION("scalars spread over the low bits") {
+		std::set<size_t> buckets;
+		for (uint64_t i = 0; i < 1024; ++i) {
+			buckets.insert(hash<uint64_t>()(i << 10) & 1023);
+		}
+		// 1024 random hashes fill about 647 of 1024 buckets, std::hash fills 1
+		REQUIRE(buckets.size() > 550);
+		REQUIRE(hash<int>()(-1) == hash<long long>()(-1));
+		REQUIRE(hash<TestColor>()(TestColor::green) == hash<int>()(1));
+	}
+
+	SECTION("floating point") {
+		REQUIRE(hash<double>()(0.0) == hash<double>()(-0.0));
+		REQUIRE(hash<double>()(1.0) != hash<double>()(-1.0));
+		REQUIRE(hash<float>()(0.5f) == hash<float>()(0.5f));
+	}
+
+	SECTION("every byte counts") {
+		for (size_t n : {1, 3, 4, 8, 15, 16, 17, 48, 49, 100, 256, 257, 1000, 1024, 1025, 5000}) {
+			std::vector<unsigned char> v = bytes(n);
+			const uint64_t h = hash_bytes(v.data(), n);
+			REQUIRE(hash_bytes(v.data(), n) == h);
+			REQUIRE(hash_bytes(v.data(), n, 1) != h);
+			for (size_t i = 0; i < n; i += 1 + n / 64) {
+				v[i] ^= 0x10;
+				REQUIRE(hash_bytes(v.data(), n) != h);
+				v[i] ^= 0x10;
+			}
+		}
+		REQUIRE(hash_bytes("", 0) != hash_bytes("\0", 1));
+	}
+
+	SECTION("swapped stripes") {
+		std::vector<unsigned char> v = bytes(1024);
+		const uint64_t h = hash_bytes(v.data(), v.size());
+		std::swap_ranges(v.begin(), v.begin() + 64, v.begin() + 64);
+		REQUIRE(hash_bytes(v.data(), v.size()) != h);
+	}
+
+	SECTION("ranges") {
+		const std::string s = "the quick brown fox";
+		const std::vector<char> v(s.begin(), s.end());
+		REQUIRE(hash<std::string>()(s) == hash_bytes(s.data(), s.size()));
+		REQUIRE(hash<std::vector<char>>()(v) == hash<std::string>()(s));
+		REQUIRE(hash<array_view<const char>>()(array_view<const char>(s.data(), s.size())) == hash<std::string>()(s));
+		const std::vector<std::string> words = {"a", "b"};
+		const std::vector<std::string> swapped = {"b", "a"};
+		REQUIRE(hash<std::vector<std::string>>()(words) != hash<std::vector<std::string>>()(swapped));
+		const float a[3] = {0.0f, 1.0f, 2.0f};
+		const float b[3] = {-0.0f, 1.0f, 2.0f};
+		REQUIRE(hash<float[3]>()(a) == hash<float[3]>()(b));
+	}
+
+	SECTION("specialization") {
+		REQUIRE(hash<TestPoint>()(TestPoint(1, 2)) == hash<TestPoint>()(TestPoint(1, 2)));
+		REQUIRE(hash<TestPoint>()(TestPoint(1, 2)) != hash<TestPoint>()(TestPoint(2, 1)));
+	}
+
+#if defined(META_BUILTIN_HAS_UNIQUE_OBJECT_REPRESENTATIONS) || defined(__cpp_lib_has_unique_object_representations)
+	SECTION("bytes") {
+		const TestKey key = {7, 1, 2};
+		REQUIRE(hash<TestKey>()(key) == hash_bytes(&key, sizeof(key)));
+		// equal keys hash equal, the map relies on it
+		const TestKey same = {7, 1, 2};
+		REQUIRE(same == key);
+		REQUIRE(hash<TestKey>()(same) == hash<TestKey>()(key));
+		std::unordered_map<TestKey, int, hash<TestKey>> ids;
+		ids[key] = 1;
+		ids[TestKey{7, 2, 1}] = 2;
+		REQUIRE(ids.size() == 2);
+		REQUIRE(ids[key] == 1);
+	}
+#endif
+
+#if defined(__cpp_structured_bindings)
+	SECTION("fields") {
+		const TestPadded padded = {'a', 1};
+		REQUIRE(hash<TestPadded>()(padded) == hash<TestPadded>()(TestPadded{'a', 1}));
+		REQUIRE(hash<TestPadded>()(padded) != hash<TestPadded>()(TestPadded{'a', 2}));
+		REQUIRE(hash<TestName>()(TestName{"ada", "lovelace"}) != hash<TestName>()(TestName{"lovelace", "ada"}));
+	}
+#endif
+
+	SECTION("every instruction set") {
+		const std::vector<unsigned char> v = bytes(3000);
+		uint64_t expected[8] = {};
+		detail::run_kernel<detail::hash_stripes_kernel, 1, 1>(v.data(), v.size(), static_cast<uint64_t*>(expected));
+		uint64_t acc[8] = {};
+#if defined(META_TARGET)
+		if (active_simd_isa() >= simd_isa::ssse3) {
+			detail::run_kernel_ssse3<detail::hash_stripes_kernel, 2, 2>(v.data(), v.size(), static_cast<uint64_t*>(acc));
+			REQUIRE(std::equal(acc, acc + 8, expected));
+		}
+		if (active_simd_isa() >= simd_isa::avx2) {
+			std::fill(acc, acc + 8, 0);
+			detail::run_kernel_avx2<detail::hash_stripes_kernel, 4, 2>(v.data(), v.size(), static_cast<uint64_t*>(acc));
+			REQUIRE(std::equal(acc, acc + 8, expected));
+		}
+		if (active_simd_isa() >= simd_isa::avx512) {
+			std::fill(acc, acc + 8, 0);
+			detail::run_kernel_avx512<detail::hash_stripes_kernel, 8, 2>(v.data(), v.size(), static_cast<uint64_t*>(acc));
+			REQUIRE(std::equal(acc, acc + 8, expected));
+		}
+#endif
+		(void)acc;
+	}
+}
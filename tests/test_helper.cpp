@@ -0,0 +1,75 @@
+#include "catch2/catch.hpp"
+#include "type_traits_type.h"
+
+USE_META
+
+namespace {
+	// an operand which doesn't compile when it is read, so the tests below
+	// fail to build if a logical operation reads past the deciding operand
+	template <class T>
+	struct Poison {
+		static_assert(sizeof(T) == 0, "Poison must not be instantiated");
+		static constexpr bool value = false;
+	};
+
+	struct TestTrue : public true_type {};
+	struct TestFalse : public false_type {};
+
+	template <class T, class = enable_if_t<is_integral<T>::value>>
+	constexpr bool integral_overload(T) { return true; }
+
+	template <class T, class = enable_if_t<!is_integral<T>::value>, class = void>
+	constexpr bool integral_overload(T) { return false; }
+}
+
+TEST_CASE("traits helper", "[trais][helper]" ) {
+	SECTION("conditional") {
+		REQUIRE(is_same<int, conditional_t<true, int, float>>());
+		REQUIRE(is_same<float, conditional_t<false, int, float>>());
+		REQUIRE(is_same<void, conditional<true, void, int>::type>());
+		REQUIRE(is_same<int&, conditional<false, void, int&>::type>());
+	}
+
+	SECTION("enable if") {
+		REQUIRE(is_same<void, enable_if<true>::type>());
+		REQUIRE(is_same<int, enable_if_t<true, int>>());
+		REQUIRE(integral_overload(1));
+		REQUIRE_FALSE(integral_overload(1.0));
+	}
+
+	SECTION("conjunction") {
+		REQUIRE(conjunction<>());
+		REQUIRE(conjunction<true_type, true_type>());
+		REQUIRE_FALSE(conjunction<true_type, false_type, true_type>());
+		REQUIRE(conjunction_v<is_integral<int>, is_scalar<int*>>);
+
+		// the result is the deciding operand
+		REQUIRE(std::is_base_of<TestFalse, conjunction<TestTrue, TestFalse, TestTrue>>());
+		REQUIRE(std::is_base_of<TestTrue, conjunction<true_type, TestTrue>>());
+
+		// the operands after the first false are not read, ::value as an
+		// operator on the object would instantiate them for the ADL
+		REQUIRE_FALSE(conjunction<false_type, Poison<int>>::value);
+		REQUIRE_FALSE(conjunction_v<is_class<int>, Poison<int>, Poison<float>>);
+	}
+
+	SECTION("disjunction") {
+		REQUIRE_FALSE(disjunction<>());
+		REQUIRE(disjunction<false_type, true_type>());
+		REQUIRE_FALSE(disjunction<false_type, false_type>());
+		REQUIRE(disjunction_v<is_class<int>, is_integral<int>>);
+
+		REQUIRE(std::is_base_of<TestTrue, disjunction<TestFalse, TestTrue, TestFalse>>());
+		REQUIRE(std::is_base_of<TestFalse, disjunction<false_type, TestFalse>>());
+
+		REQUIRE(disjunction<true_type, Poison<int>>::value);
+		REQUIRE(disjunction_v<is_scalar<int>, Poison<int>>);
+	}
+
+	SECTION("negation") {
+		REQUIRE(negation<false_type>());
+		REQUIRE_FALSE(negation<is_integral<int>>());
+		REQUIRE(negation_v<is_class<int>>);
+		REQUIRE(conjunction<is_class<TestTrue>, negation<is_union<TestTrue>>>());
+	}
+}
@@ -0,0 +1,84 @@
+#include "catch2/catch.hpp"
+#include "integer_sequence.h"
+#include "type_traits_type.h"
+
+#include <cstdint>
+#include <vector>
+
+USE_META
+
+namespace {
+	template <class T, T... Is>
+	std::vector<long long> values(integer_sequence<T, Is...>) {
+		return {static_cast<long long>(Is)...};
+	}
+
+	// the sum of 0..N-1 by expanding the sequence, checks every element of a long one
+	template <size_t... Is>
+	constexpr size_t sum(index_sequence<Is...>) {
+		size_t total = 0;
+		for (size_t i : {size_t(0), Is...}) {
+			total += i;
+		}
+		return total;
+	}
+}
+
+TEST_CASE("integer sequence", "[integer_sequence]" ) {
+	SECTION("make") {
+		REQUIRE(is_same<index_sequence<>, make_index_sequence<0>>());
+		REQUIRE(is_same<index_sequence<0>, make_index_sequence<1>>());
+		REQUIRE(is_same<index_sequence<0, 1, 2, 3, 4>, make_index_sequence<5>>());
+		REQUIRE(is_same<integer_sequence<int, 0, 1, 2>, make_integer_sequence<int, 3>>());
+		REQUIRE(is_same<integer_sequence<char>, make_integer_sequence<char, 0>>());
+		REQUIRE(is_same<index_sequence<0, 1, 2>, index_sequence_for<int, float, void>>());
+		REQUIRE(is_same<index_sequence<>, index_sequence_for<>>());
+
+		REQUIRE(make_index_sequence<7>::size() == 7);
+		REQUIRE(is_same<make_integer_sequence<short, 2>::value_type, short>());
+		REQUIRE(values(make_index_sequence<9>()) == std::vector<long long>{0, 1, 2, 3, 4, 5, 6, 7, 8});
+		REQUIRE(values(make_index_sequence<16>()).back() == 15);
+
+		// long ones, which a recursion over the elements couldn't make
+		REQUIRE(make_index_sequence<10000>::size() == 10000);
+		REQUIRE(sum(make_index_sequence<10000>()) == 10000 * 9999 / 2);
+		REQUIRE(sum(make_index_sequence<10001>()) == 10001 * 10000 / 2);
+	}
+
+	SECTION("portable") {
+		// the doubling the header falls back to without the compiler builtins
+		using detail::make_integer_sequence_impl;
+		REQUIRE(is_same<index_sequence<>, make_integer_sequence_impl<size_t, 0>::type>());
+		REQUIRE(is_same<index_sequence<0>, make_integer_sequence_impl<size_t, 1>::type>());
+		REQUIRE(is_same<index_sequence<0, 1, 2, 3, 4, 5, 6>, make_integer_sequence_impl<size_t, 7>::type>());
+		REQUIRE(is_same<integer_sequence<int, 0, 1, 2, 3>, make_integer_sequence_impl<int, 4>::type>());
+		REQUIRE(is_same<make_index_sequence<4097>, make_integer_sequence_impl<size_t, 4097>::type>());
+	}
+
+	SECTION("offset/range/iota") {
+		REQUIRE(is_same<index_sequence<3, 4, 5>, offset_sequence_t<make_index_sequence<3>, 3>>());
+		REQUIRE(is_same<integer_sequence<int, -2, -1>, offset_sequence_t<make_integer_sequence<int, 2>, -2>>());
+		REQUIRE(is_same<index_sequence<5, 6>, make_index_range<5, 7>>());
+		REQUIRE(is_same<index_sequence<>, make_index_range<4, 4>>());
+
+		REQUIRE(is_same<integer_sequence<int, 1, 2, 3>, make_iota_sequence<int, 1, 3>>());
+		REQUIRE(is_same<integer_sequence<int, 10, 7, 4, 1>, make_iota_sequence<int, 10, 4, -3>>());
+		REQUIRE(is_same<integer_sequence<uint8_t>, make_iota_sequence<uint8_t, 5, 0>>());
+		REQUIRE(is_same<integer_sequence<long, 0, 2, 4>, make_iota_sequence<long, 0, 3, 2>>());
+	}
+
+	SECTION("reverse") {
+		REQUIRE(is_same<index_sequence<>, make_reverse_index_sequence<0>>());
+		REQUIRE(is_same<index_sequence<2, 1, 0>, make_reverse_index_sequence<3>>());
+		REQUIRE(is_same<integer_sequence<int, 9, -1, 4>, reverse_sequence_t<integer_sequence<int, 4, -1, 9>>>());
+		REQUIRE(is_same<make_index_sequence<1000>, reverse_sequence_t<make_reverse_index_sequence<1000>>>());
+	}
+
+	SECTION("slice") {
+		using S = integer_sequence<int, 7, 3, 5, 1>;
+		REQUIRE(is_same<integer_sequence<int, 3, 5>, slice_sequence_t<S, 1, 3>>());
+		REQUIRE(is_same<S, slice_sequence_t<S, 0, 4>>());
+		REQUIRE(is_same<integer_sequence<int>, slice_sequence_t<S, 4, 4>>());
+		REQUIRE(is_same<make_index_range<250, 750>, slice_sequence_t<make_index_sequence<1000>, 250, 750>>());
+	}
+}
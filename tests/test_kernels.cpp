@@ -0,0 +1,127 @@
+#include "catch2/catch.hpp"
+#include "kernels.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+USE_META
+
+namespace {
+	// small integral values, so the sums are exact in every type and order
+	template <class T>
+	std::vector<T> values(size_t n, int seed) {
+		std::vector<T> v(n);
+		for (size_t i = 0; i < n; ++i) {
+			v[i] = static_cast<T>(static_cast<int>((i * 7 + seed) % 9) - 4);
+		}
+		return v;
+	}
+
+	template <class T>
+	void check_kernels() {
+		for (size_t n : {0, 1, 3, 15, 16, 17, 63, 64, 65, 255, 256, 257, 1000}) {
+			const std::vector<T> a = values<T>(n, 1);
+			const std::vector<T> b = values<T>(n, 5);
+
+			T sum_ref = T();
+			T dot_ref = T();
+			T min_ref = n ? a[0] : T();
+			T max_ref = n ? a[0] : T();
+			for (size_t i = 0; i < n; ++i) {
+				sum_ref += a[i];
+				dot_ref += a[i] * b[i];
+				min_ref = a[i] < min_ref ? a[i] : min_ref;
+				max_ref = max_ref < a[i] ? a[i] : max_ref;
+			}
+			REQUIRE(sum(a.data(), n) == sum_ref);
+			REQUIRE(dot(a.data(), b.data(), n) == dot_ref);
+			REQUIRE(min_value(a.data(), n) == min_ref);
+			REQUIRE(max_value(a.data(), n) == max_ref);
+
+			std::vector<T> y = b;
+			axpy(T(2), a.data(), y.data(), n);
+			std::vector<T> clamped(n);
+			clamp(a.data(), n, T(1), T(3), clamped.data());
+			std::vector<T> scanned(n);
+			prefix_sum(a.data(), n, scanned.data());
+			T running = T();
+			for (size_t i = 0; i < n; ++i) {
+				running += a[i];
+				REQUIRE(y[i] == static_cast<T>(T(2) * a[i] + b[i]));
+				REQUIRE(clamped[i] == (a[i] < T(1) ? T(1) : T(3) < a[i] ? T(3) : a[i]));
+				REQUIRE(scanned[i] == running);
+			}
+
+			// in place
+			prefix_sum(y.data(), n, y.data());
+			clamp(y.data(), n, T(0), T(3), y.data());
+			REQUIRE((n == 0 || (min_value(y.data(), n) >= T(0) && max_value(y.data(), n) <= T(3))));
+		}
+	}
+}
+
+TEST_CASE("kernel traits", "[kernels]" ) {
+	REQUIRE(kernel_traits<int>::family == kernel_integral);
+	REQUIRE(kernel_traits<const unsigned char>::family == kernel_integral);
+	REQUIRE(kernel_traits<double>::family == kernel_floating_point);
+	REQUIRE(kernel_traits<bool>::family == kernel_scalar);
+	REQUIRE(kernel_traits<long double>::family == kernel_scalar);
+	REQUIRE(kernel_traits<std::string>::family == kernel_scalar);
+
+	REQUIRE(kernel_traits<float>::lanes<simd_isa::sse2>::value == 4);
+	REQUIRE(kernel_traits<int16_t>::lanes<simd_isa::ssse3>::value == 8);
+	REQUIRE(kernel_traits<int8_t>::lanes<simd_isa::avx2>::value == 32);
+	REQUIRE(kernel_traits<double>::lanes<simd_isa::avx512>::value == 8);
+	REQUIRE(kernel_traits<double>::lanes<simd_isa::scalar>::value == 1);
+	REQUIRE(kernel_traits<std::string>::lanes<simd_isa::avx512>::value == 1);
+
+	REQUIRE(active_simd_isa() >= build_simd_isa);
+}
+
+TEST_CASE("kernels", "[kernels]" ) {
+	SECTION("integral") {
+		check_kernels<int8_t>();
+		check_kernels<uint8_t>();
+		check_kernels<int16_t>();
+		check_kernels<uint16_t>();
+		check_kernels<int32_t>();
+		check_kernels<uint32_t>();
+		check_kernels<int64_t>();
+		check_kernels<uint64_t>();
+	}
+
+	SECTION("floating point") {
+		check_kernels<float>();
+		check_kernels<double>();
+		check_kernels<long double>();
+	}
+
+	SECTION("scalar path keeps the order") {
+		const std::string words[] = {"a", "b", "c"};
+		REQUIRE(sum(words, 3) == "abc");
+		REQUIRE(min_value(words, 3) == "a");
+		REQUIRE(max_value(words, 3) == "c");
+		std::string scanned[3];
+		prefix_sum(words, 3, scanned);
+		REQUIRE(scanned[2] == "abc");
+	}
+
+	SECTION("every instruction set") {
+		const std::vector<float> a = values<float>(100, 1);
+		const float expected = sum(a.data(), a.size());
+		REQUIRE(detail::run_kernel<detail::sum_kernel, 1, 1>(a.data(), a.size()) == expected);
+		REQUIRE(detail::run_kernel<detail::sum_kernel, 4, 4>(a.data(), a.size()) == expected);
+#if defined(META_TARGET)
+		if (active_simd_isa() >= simd_isa::ssse3) {
+			REQUIRE(detail::run_kernel_ssse3<detail::sum_kernel, 4, 4>(a.data(), a.size()) == expected);
+		}
+		if (active_simd_isa() >= simd_isa::avx2) {
+			REQUIRE(detail::run_kernel_avx2<detail::sum_kernel, 8, 4>(a.data(), a.size()) == expected);
+		}
+		if (active_simd_isa() >= simd_isa::avx512) {
+			REQUIRE(detail::run_kernel_avx512<detail::sum_kernel, 16, 4>(a.data(), a.size()) == expected);
+		}
+#endif
+	}
+}
@@ -0,0 +1,166 @@
+#include "catch2/catch.hpp"
+#include "object_pool.h"
+
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+USE_META
+
+namespace {
+	struct TestOrder {
+		uint64_t id;
+		double price;
+	};
+
+	struct TestQuote {
+		double bid;
+		double ask;
+	};
+
+	struct TestSession {
+		static int live;
+
+		explicit TestSession(std::string n) : name(std::move(n)) { ++live; }
+		~TestSession() { --live; }
+
+		std::string name;
+	};
+
+	int TestSession::live = 0;
+
+	struct TestThrowing {
+		explicit TestThrowing(bool fail) {
+			if (fail) {
+				throw std::runtime_error("constructor");
+			}
+		}
+		char c;
+	};
+
+	struct alignas(64) TestAligned {
+		char c;
+	};
+}
+
+TEST_CASE("object pool", "[object_pool]" ) {
+	SECTION("size classes") {
+		REQUIRE(is_same<object_pool<TestOrder>::size_class, object_pool<TestQuote>::size_class>());
+		REQUIRE(is_same<object_pool<TestOrder>::size_class, object_pool<const TestQuote>::size_class>());
+		REQUIRE_FALSE(is_same<object_pool<TestOrder>::size_class, object_pool<TestSession>::size_class>());
+		// a block holds the free-list link
+		REQUIRE(object_pool<char>::size_class::block_size == sizeof(void*));
+		REQUIRE(object_pool<TestAligned>::size_class::block_size == 64);
+		REQUIRE(object_pool<TestAligned>::size_class::alignment == 64);
+	}
+
+	SECTION("create and destroy") {
+		std::vector<TestOrder*> orders;
+		std::set<TestOrder*> distinct;
+		for (uint64_t i = 0; i < 1000; ++i) {
+			orders.push_back(object_pool<TestOrder>::create(TestOrder{i, 0.5 * i}));
+			distinct.insert(orders.back());
+			REQUIRE(reinterpret_cast<uintptr_t>(orders.back()) % alignof(TestOrder) == 0);
+		}
+		REQUIRE(distinct.size() == 1000);
+		for (uint64_t i = 0; i < 1000; ++i) {
+			REQUIRE(orders[i]->id == i);
+			REQUIRE(orders[i]->price == 0.5 * i);
+		}
+		for (TestOrder* order : orders) {
+			object_pool<TestOrder>::destroy(order);
+		}
+
+		// the last block given back is the next one taken, for either type
+		TestOrder* order = object_pool<TestOrder>::create();
+		object_pool<TestOrder>::destroy(order);
+		TestQuote* quote = object_pool<TestQuote>::create(TestQuote{1.0, 2.0});
+		REQUIRE(static_cast<void*>(quote) == static_cast<void*>(order));
+		object_pool<TestQuote>::destroy(quote);
+		object_pool<TestQuote>::destroy(nullptr);
+
+		for (int i = 0; i < 100; ++i) {
+			TestAligned* aligned = object_pool<TestAligned>::create();
+			REQUIRE(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+			object_pool<TestAligned>::destroy(aligned);
+		}
+	}
+
+	SECTION("destructors") {
+		TestSession::live = 0;
+		TestSession* a = object_pool<TestSession>::create("a");
+		TestSession* b = object_pool<TestSession>::create(std::string(100, 'b'));
+		REQUIRE(TestSession::live == 2);
+		REQUIRE(b->name.size() == 100);
+		object_pool<TestSession>::destroy(a);
+		object_pool<TestSession>::destroy(b);
+		REQUIRE(TestSession::live == 0);
+
+		void* p = object_pool<TestThrowing>::allocate();
+		object_pool<TestThrowing>::deallocate(p);
+		REQUIRE_THROWS_AS(object_pool<TestThrowing>::create(true), std::runtime_error);
+		// the block of the failed object was given back
+		TestThrowing* t = object_pool<TestThrowing>::create(false);
+		REQUIRE(static_cast<void*>(t) == p);
+		object_pool<TestThrowing>::destroy(t);
+	}
+
+	SECTION("threads") {
+		using depot_of = object_pool<TestOrder>::size_class;
+		std::vector<std::thread> threads;
+		std::vector<std::vector<TestOrder*>> made(4);
+		for (size_t t = 0; t < made.size(); ++t) {
+			threads.emplace_back([&made, t] {
+				for (uint64_t i = 0; i < 5000; ++i) {
+					made[t].push_back(object_pool<TestOrder>::create(TestOrder{t * 5000 + i, 0.0}));
+					if (i % 3 == 0) {
+						object_pool<TestOrder>::destroy(made[t].back());
+						made[t].pop_back();
+					}
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		std::set<TestOrder*> distinct;
+		for (size_t t = 0; t < made.size(); ++t) {
+			for (TestOrder* order : made[t]) {
+				REQUIRE(order->id / 5000 == t);
+				distinct.insert(order);
+			}
+		}
+		size_t total = 0;
+		for (const std::vector<TestOrder*>& orders : made) {
+			total += orders.size();
+		}
+		REQUIRE(distinct.size() == total);
+
+		// destroyed on another thread than the one which made them, the
+		// blocks come back through the depot when that thread exits
+		const size_t slabs = depot_of::depot().slab_count();
+		std::thread([&made] {
+			for (std::vector<TestOrder*>& orders : made) {
+				for (TestOrder* order : orders) {
+					object_pool<TestOrder>::destroy(order);
+				}
+				orders.clear();
+			}
+		}).join();
+		for (int round = 0; round < 3; ++round) {
+			std::thread([&made] {
+				for (int i = 0; i < 10000; ++i) {
+					made[0].push_back(object_pool<TestOrder>::create());
+				}
+				for (TestOrder* order : made[0]) {
+					object_pool<TestOrder>::destroy(order);
+				}
+				made[0].clear();
+			}).join();
+		}
+		REQUIRE(depot_of::depot().slab_count() == slabs);
+	}
+}
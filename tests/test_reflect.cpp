@@ -0,0 +1,141 @@
+#include "catch2/catch.hpp"
+#include "reflect.h"
+
+#include <string>
+#include <vector>
+
+USE_META
+
+namespace {
+	struct TestEmpty {};
+
+	struct TestPoint {
+		int x;
+		float y;
+	};
+
+	struct TestMessage {
+		TestPoint origin;
+		std::string name;
+		const long id;
+		std::vector<int> payload;
+		double weight = 1.0;
+	};
+
+	struct TestWide {
+		int f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15;
+		int f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30, f31;
+		int f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43, f44, f45, f46, f47;
+		int f48, f49, f50, f51, f52, f53, f54, f55, f56, f57, f58, f59, f60, f61, f62, f63;
+	};
+
+	struct TestNotAggregate {
+		TestNotAggregate(int, int);
+	};
+
+	struct TestRequired {
+		int a;
+		TestNotAggregate b;
+		std::string c;
+	};
+
+	struct TestRefs {
+		int& r;
+		double d;
+		const std::string& name;
+		int&& moved;
+	};
+
+	template <class T, class = void>
+	struct has_field_count : false_type {};
+
+	template <class T>
+	struct has_field_count<T, decltype((void)detail::count_fields<T>::value)> : true_type {};
+}
+
+TEST_CASE("aggregate reflection", "[reflect]" ) {
+	SECTION("field count") {
+		REQUIRE(field_count<TestEmpty>::value == 0);
+		REQUIRE(field_count<TestPoint>::value == 2);
+		REQUIRE(field_count<const TestPoint>::value == 2);
+		REQUIRE(field_count<TestMessage>::value == 5);
+		REQUIRE(field_count_v<TestWide> == 64);
+		// b has no default constructor, TestRequired{x} doesn't compile
+		REQUIRE(field_count<TestRequired>::value == 3);
+		// reference members bind to the placeholder too
+		REQUIRE(field_count<TestRefs>::value == 4);
+		REQUIRE(detail::count_fields<int>::value == 0);
+#if defined(META_BUILTIN_IS_AGGREGATE) || defined(__cpp_lib_is_aggregate)
+		REQUIRE(detail::count_fields<TestNotAggregate>::value == 0);
+		REQUIRE(detail::count_fields<std::vector<int>>::value == 0);
+#endif
+	}
+
+#if defined(__cpp_structured_bindings)
+	SECTION("field types") {
+		REQUIRE(is_same<type_list<>, fields_t<TestEmpty>>());
+		REQUIRE(is_same<type_list<int, float>, fields_t<TestPoint>>());
+		REQUIRE(is_same<type_list<const int, const float>, fields_t<const TestPoint>>());
+		REQUIRE(is_same<type_list<TestPoint, std::string, const long, std::vector<int>, double>,
+			fields_t<TestMessage>>());
+		REQUIRE(is_same<const long, field_t<TestMessage, 2>>());
+		REQUIRE(fields_t<TestWide>::size == 64);
+		REQUIRE(is_same<type_list<int, double, const std::string, int>, fields_t<TestRefs>>());
+	}
+
+	SECTION("get") {
+		TestMessage m{{1, 2.f}, "name", 7, {1, 2, 3}};
+		REQUIRE(&get<0>(m) == &m.origin);
+		REQUIRE(get<1>(m) == "name");
+		REQUIRE(get<2>(m) == 7);
+		REQUIRE(get<4>(m) == 1.0);
+		get<1>(get<0>(m)) = 5.f;
+		REQUIRE(m.origin.y == 5.f);
+
+		const TestMessage& c = m;
+		REQUIRE(is_same<const std::string&, decltype(get<1>(c))>());
+
+		TestWide w{};
+		get<63>(w) = 9;
+		REQUIRE(w.f63 == 9);
+
+		int i = 1;
+		const std::string name = "refs";
+		TestRefs refs{i, 2.0, name, 3};
+		get<0>(refs) = 4;
+		REQUIRE(i == 4);
+		REQUIRE(&get<2>(refs) == &name);
+		REQUIRE(get<3>(refs) == 3);
+	}
+
+	SECTION("for each field") {
+		TestPoint p{3, 4.5f};
+		double total = 0;
+		int calls = 0;
+		for_each_field(p, [&](auto& field) { total += field; ++calls; });
+		REQUIRE(total == 7.5);
+		REQUIRE(calls == 2);
+
+		for_each_field(p, [](auto& field) { field *= 2; });
+		REQUIRE(p.x == 6);
+		REQUIRE(p.y == 9.f);
+
+		TestEmpty e;
+		for_each_field(e, [&](auto&) { ++calls; });
+		REQUIRE(calls == 2);
+
+		TestWide w{};
+		int i = 0;
+		for_each_field(w, [&](int& field) { field = i++; });
+		REQUIRE(w.f0 == 0);
+		REQUIRE(w.f40 == 40);
+		REQUIRE(w.f63 == 63);
+	}
+
+	SECTION("apply fields") {
+		const TestPoint p{3, 4.5f};
+		REQUIRE(apply_fields(p, [](const int& x, const float& y) { return x + y; }) == 7.5f);
+		REQUIRE(apply_fields(p, [](const auto&... fields) { return sizeof...(fields); }) == 2);
+	}
+#endif
+}
@@ -0,0 +1,193 @@
+#include "catch2/catch.hpp"
+#include "serialize.h"
+#include "small_vector.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+USE_META
+
+namespace {
+	enum class TestLevel : uint8_t { debug, info, error };
+
+	struct TestHeader {
+		uint32_t id;
+		TestLevel level;
+		double timestamp;
+	};
+
+	struct TestRecord {
+		TestHeader header;
+		std::string message;
+		std::vector<float> samples;
+		std::vector<std::string> tags;
+		std::array<int, 3> codes;
+	};
+
+	bool operator==(const TestHeader& lhs, const TestHeader& rhs) {
+		return lhs.id == rhs.id && lhs.level == rhs.level && lhs.timestamp == rhs.timestamp;
+	}
+
+	// a class with a constructor, serialized through a specialization
+	class TestPoint {
+	public:
+		TestPoint(int x = 0, int y = 0) : x_(x), y_(y) {}
+		virtual ~TestPoint() {}
+
+		int x_;
+		int y_;
+	};
+}
+
+NS_META_BEG
+template <>
+struct serializer<TestPoint> {
+	template <class Writer>
+	static void write(Writer& writer, const TestPoint& value) {
+		writer.write(value.x_);
+		writer.write(value.y_);
+	}
+
+	template <class Reader>
+	static void read(Reader& reader, TestPoint& value) {
+		reader.read(value.x_);
+		reader.read(value.y_);
+	}
+};
+NS_META_END
+
+TEST_CASE("serialize", "[serialize]" ) {
+	SECTION("categories") {
+		REQUIRE(serial_category_of<int>::value == serial_scalar);
+		REQUIRE(serial_category_of<TestLevel>::value == serial_scalar);
+		REQUIRE(serial_category_of<TestHeader>::value == serial_bitwise);
+		REQUIRE(serial_category_of<TestHeader[4]>::value == serial_bitwise);
+		REQUIRE(serial_category_of<std::string[2]>::value == serial_array);
+		REQUIRE(serial_category_of<std::vector<int>>::value == serial_range);
+		REQUIRE(serial_category_of<std::string>::value == serial_range);
+		REQUIRE(serial_category_of<small_vector<double, 4>>::value == serial_range);
+		REQUIRE(serial_category_of<int*>::value == serial_none);
+		REQUIRE(serial_category_of<TestPoint>::value == serial_none);
+		REQUIRE_FALSE(is_bitwise_serializable<int*[2]>());
+#if defined(__cpp_structured_bindings)
+		REQUIRE(serial_category_of<TestRecord>::value == serial_fields);
+#endif
+	}
+
+	SECTION("scalars and bitwise classes") {
+		unsigned char buffer[64];
+		const TestHeader header = {7, TestLevel::error, 1.5};
+		REQUIRE(serialize(header, buffer, sizeof(buffer)) == sizeof(TestHeader));
+		REQUIRE(serialized_size(header) == sizeof(TestHeader));
+
+		TestHeader copy = {};
+		REQUIRE(deserialize(buffer, sizeof(TestHeader), copy));
+		REQUIRE(copy == header);
+
+		// the enum is its underlying type
+		REQUIRE(serialize(TestLevel::info, buffer, sizeof(buffer)) == 1);
+		REQUIRE(buffer[0] == 1);
+	}
+
+	SECTION("containers") {
+		std::vector<unsigned char> buffer(1024);
+		const std::vector<std::string> words = {"alpha", "", "gamma"};
+		const size_t size = serialize(words, buffer.data(), buffer.size());
+		REQUIRE(size == serialized_size(words));
+		REQUIRE(size == 8 + 3 * 8 + 10);
+
+		std::vector<std::string> copy;
+		REQUIRE(deserialize(buffer.data(), size, copy));
+		REQUIRE(copy == words);
+
+		small_vector<int16_t, 4> numbers = {1, 2, 3, 4, 5};
+		small_vector<int16_t, 4> numbers_copy;
+		REQUIRE(deserialize(buffer.data(), serialize(numbers, buffer.data(), buffer.size()), numbers_copy));
+		REQUIRE(numbers_copy == numbers);
+
+		const std::string strings[2] = {"x", "yz"};
+		std::string strings_copy[2];
+		REQUIRE(deserialize(buffer.data(), serialize(strings, buffer.data(), buffer.size()), strings_copy));
+		REQUIRE(strings_copy[1] == "yz");
+	}
+
+	SECTION("specialization") {
+		unsigned char buffer[16];
+		REQUIRE(serialize(TestPoint(3, 4), buffer, sizeof(buffer)) == 8);
+		TestPoint copy;
+		REQUIRE(deserialize(buffer, 8, copy));
+		REQUIRE(copy.y_ == 4);
+	}
+
+	SECTION("views and alignment") {
+		alignas(8) unsigned char buffer[256];
+		buffer_writer writer(buffer, sizeof(buffer));
+		const std::vector<double> values = {0.5, 1.5, 2.5};
+		REQUIRE(writer.write(uint8_t(9)));
+		REQUIRE(writer.write(std::string("text")));
+		REQUIRE(writer.write(values));
+		// 1 + 8 + 4, padded to 16 for the doubles
+		REQUIRE(writer.size() == 16 + 8 + 24);
+
+		buffer_reader reader(buffer, writer.size());
+		uint8_t first = 0;
+		REQUIRE(reader.read(first));
+		REQUIRE(first == 9);
+		const array_view<const char> text = reader.read_view<char>();
+		REQUIRE(std::string(text.begin(), text.end()) == "text");
+		const array_view<const double> doubles = reader.read_view<double>();
+		REQUIRE(reader.ok());
+		REQUIRE(doubles.size() == 3);
+		REQUIRE(doubles[2] == 2.5);
+		REQUIRE(doubles.data() == reinterpret_cast<const double*>(buffer + 24));
+		REQUIRE(reader.remaining() == 0);
+	}
+
+	SECTION("failures are sticky") {
+		unsigned char buffer[12];
+		buffer_writer writer(buffer, sizeof(buffer));
+		REQUIRE(writer.write(uint64_t(1)));
+		REQUIRE_FALSE(writer.write(uint64_t(2)));
+		REQUIRE_FALSE(writer.write(uint8_t(3)));
+		REQUIRE_FALSE(writer.ok());
+		REQUIRE(writer.size() == 8);
+		REQUIRE(serialize(std::vector<int>(10), buffer, sizeof(buffer)) == 0);
+
+		writer.reset();
+		REQUIRE(writer.write(uint32_t(5)));
+
+		// a count larger than the input
+		const uint64_t count = 1000;
+		std::vector<int> numbers;
+		REQUIRE_FALSE(deserialize(&count, sizeof(count), numbers));
+		REQUIRE(numbers.empty());
+		std::vector<std::string> words;
+		REQUIRE_FALSE(deserialize(&count, sizeof(count), words));
+
+		buffer_reader reader(buffer, 4);
+		uint64_t wide = 0;
+		REQUIRE_FALSE(reader.read(wide));
+		uint8_t narrow = 0;
+		REQUIRE_FALSE(reader.read(narrow));
+	}
+
+#if defined(__cpp_structured_bindings)
+	SECTION("aggregates") {
+		const TestRecord record = {{1, TestLevel::info, 2.0}, "started", {1.f, 2.f}, {"a", "bc"}, {4, 5, 6}};
+		std::vector<unsigned char> buffer(serialized_size(record));
+		REQUIRE(serialize(record, buffer.data(), buffer.size()) == buffer.size());
+
+		TestRecord copy = {};
+		REQUIRE(deserialize(buffer.data(), buffer.size(), copy));
+		REQUIRE(copy.header == record.header);
+		REQUIRE(copy.message == record.message);
+		REQUIRE(copy.samples == record.samples);
+		REQUIRE(copy.tags == record.tags);
+		REQUIRE(copy.codes[2] == 6);
+
+		REQUIRE_FALSE(deserialize(buffer.data(), buffer.size() - 1, copy));
+	}
+#endif
+}
@@ -0,0 +1,160 @@
+#include "catch2/catch.hpp"
+#include "small_vector.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+USE_META
+
+namespace {
+	// a trivially relocatable class which is not trivially copyable
+	struct TestHandle {
+		std::unique_ptr<int> p;
+
+		explicit TestHandle(int v) : p(new int(v)) {}
+	};
+
+	template <class V>
+	std::vector<std::string> strings_of(const V& v) {
+		return std::vector<std::string>(v.begin(), v.end());
+	}
+
+	template <class V>
+	std::vector<int> values_of(const V& v) {
+		std::vector<int> values;
+		for (const auto& h : v) {
+			values.push_back(*h.p);
+		}
+		return values;
+	}
+}
+
+NS_META_BEG
+template <>
+struct is_trivially_relocatable<TestHandle> : public true_type {};
+NS_META_END
+
+TEST_CASE("small vector", "[small_vector]" ) {
+	SECTION("traits") {
+		REQUIRE(is_trivially_relocatable<std::unique_ptr<int>>());
+		REQUIRE(is_trivially_relocatable<TestHandle>());
+		REQUIRE_FALSE(is_trivially_relocatable<std::unique_ptr<int, void (*)(int*)>>());
+		REQUIRE(std::is_nothrow_move_constructible<small_vector<TestHandle, 2>>());
+	}
+
+	SECTION("inline and heap storage") {
+		small_vector<int, 4> v;
+		REQUIRE(v.empty());
+		REQUIRE(v.capacity() == 4);
+		for (int i = 0; i < 4; ++i) {
+			v.push_back(i);
+		}
+		REQUIRE(v.is_inline());
+		v.push_back(4);
+		REQUIRE_FALSE(v.is_inline());
+		REQUIRE(v.size() == 5);
+		REQUIRE(v.capacity() >= 5);
+		REQUIRE(std::vector<int>(v.begin(), v.end()) == std::vector<int>({0, 1, 2, 3, 4}));
+		REQUIRE(v.front() == 0);
+		REQUIRE(v.back() == 4);
+		REQUIRE(v.at(2) == 2);
+		REQUIRE_THROWS(v.at(5));
+
+		small_vector<int, 0> heap_only = {1, 2, 3};
+		REQUIRE(heap_only.size() == 3);
+		REQUIRE(heap_only[2] == 3);
+		REQUIRE(small_vector<int, 0>() == small_vector<int, 0>());
+	}
+
+	SECTION("constructors") {
+		small_vector<int, 4> counted(3, 7);
+		REQUIRE(std::vector<int>(counted.begin(), counted.end()) == std::vector<int>(3, 7));
+
+		small_vector<int, 4> zeros(6);
+		REQUIRE(std::vector<int>(zeros.begin(), zeros.end()) == std::vector<int>(6, 0));
+
+		std::list<std::string> list = {"a", "b", "c"};
+		small_vector<std::string, 2> from_list(list.begin(), list.end());
+		REQUIRE(strings_of(from_list) == std::vector<std::string>({"a", "b", "c"}));
+
+		small_vector<std::string, 2> copy = from_list;
+		REQUIRE(copy == from_list);
+		copy = {"d"};
+		REQUIRE(strings_of(copy) == std::vector<std::string>({"d"}));
+		copy = from_list;
+		REQUIRE(copy == from_list);
+	}
+
+	SECTION("move") {
+		small_vector<TestHandle, 2> small;
+		small.emplace_back(1);
+		small_vector<TestHandle, 2> moved_small = std::move(small);
+		REQUIRE(small.empty());
+		REQUIRE(values_of(moved_small) == std::vector<int>({1}));
+
+		small_vector<TestHandle, 2> big;
+		for (int i = 0; i < 3; ++i) {
+			big.emplace_back(i);
+		}
+		const TestHandle* data = big.data();
+		small_vector<TestHandle, 2> moved_big = std::move(big);
+		REQUIRE(moved_big.data() == data);
+		REQUIRE(big.empty());
+		REQUIRE(big.is_inline());
+
+		moved_small = std::move(moved_big);
+		REQUIRE(values_of(moved_small) == std::vector<int>({0, 1, 2}));
+		moved_big.emplace_back(5);
+		moved_small = std::move(moved_big);
+		REQUIRE(values_of(moved_small) == std::vector<int>({5}));
+	}
+
+	SECTION("growth keeps the elements") {
+		small_vector<TestHandle, 1> handles;
+		small_vector<std::string, 1> strings;
+		for (int i = 0; i < 100; ++i) {
+			handles.emplace_back(i);
+			strings.push_back(std::to_string(i));
+		}
+		REQUIRE(values_of(handles).size() == 100);
+		REQUIRE(*handles[99].p == 99);
+		REQUIRE(strings[99] == "99");
+
+		// the argument is an element which the growth relocates
+		small_vector<std::string, 1> alias = {"x"};
+		alias.push_back(alias[0]);
+		alias.push_back(alias[1]);
+		REQUIRE(strings_of(alias) == std::vector<std::string>({"x", "x", "x"}));
+	}
+
+	SECTION("insert / erase") {
+		small_vector<TestHandle, 2> handles;
+		for (int i = 0; i < 5; ++i) {
+			handles.emplace_back(i);
+		}
+		REQUIRE(*handles.emplace(handles.begin() + 1, 10)->p == 10);
+		REQUIRE(values_of(handles) == std::vector<int>({0, 10, 1, 2, 3, 4}));
+		REQUIRE(*handles.erase(handles.begin() + 2)->p == 2);
+		REQUIRE(values_of(handles) == std::vector<int>({0, 10, 2, 3, 4}));
+		auto last = handles.erase(handles.begin() + 3, handles.end());
+		REQUIRE(last == handles.end());
+		REQUIRE(values_of(handles) == std::vector<int>({0, 10, 2}));
+
+		small_vector<std::string, 2> strings = {"a", "b", "c"};
+		strings.insert(strings.begin(), "z");
+		strings.insert(strings.begin() + 2, strings[0]);
+		REQUIRE(strings_of(strings) == std::vector<std::string>({"z", "a", "z", "b", "c"}));
+		strings.erase(strings.begin() + 1, strings.begin() + 3);
+		REQUIRE(strings_of(strings) == std::vector<std::string>({"z", "b", "c"}));
+		strings.insert(strings.end(), "d");
+		strings.pop_back();
+		strings.resize(1);
+		REQUIRE(strings_of(strings) == std::vector<std::string>({"z"}));
+		strings.resize(3, strings[0]);
+		REQUIRE(strings_of(strings) == std::vector<std::string>({"z", "z", "z"}));
+		strings.clear();
+		REQUIRE(strings.empty());
+	}
+}
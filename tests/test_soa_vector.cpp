@@ -0,0 +1,178 @@
+#include "catch2/catch.hpp"
+#include "soa_vector.h"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+USE_META
+
+#if defined(__cpp_structured_bindings)
+namespace {
+	struct TestTrade {
+		uint64_t id;
+		double price;
+		float quantity;
+		char side;
+	};
+
+	struct TestNamed {
+		std::string name;
+		const int rank;
+		std::unique_ptr<int> value;
+	};
+
+	struct TestThrowing {
+		static int live;
+
+		explicit TestThrowing(int v) : value(v) {
+			if (v < 0) {
+				throw std::runtime_error("constructor");
+			}
+			++live;
+		}
+		TestThrowing(const TestThrowing& other) noexcept : value(other.value) { ++live; }
+		~TestThrowing() { --live; }
+
+		int value;
+	};
+
+	int TestThrowing::live = 0;
+
+	struct TestRecord {
+		std::string name;
+		TestThrowing first;
+		TestThrowing second;
+	};
+}
+
+TEST_CASE("soa vector", "[soa_vector]" ) {
+	SECTION("columns") {
+		REQUIRE(is_same<soa_vector<TestTrade>::column_types, type_list<uint64_t, double, float, char>>());
+		REQUIRE(is_same<soa_vector<TestNamed>::column_type<1>, int>());
+		REQUIRE(soa_vector<TestTrade>::column_count == 4);
+
+		soa_vector<TestTrade> trades;
+		REQUIRE(trades.empty());
+		REQUIRE(trades.column<1>().empty());
+		for (uint64_t i = 0; i < 1000; ++i) {
+			trades.push_back(TestTrade{i, 0.5 * i, 2.f, 'b'});
+		}
+		REQUIRE(trades.size() == 1000);
+		REQUIRE(trades.capacity() >= 1000);
+
+		array_view<double> prices = trades.column<1>();
+		REQUIRE(prices.size() == 1000);
+		double total = 0;
+		for (double price : prices) {
+			total += price;
+		}
+		REQUIRE(total == 0.5 * 999 * 1000 / 2);
+		REQUIRE(reinterpret_cast<uintptr_t>(trades.column<0>().data()) % soa_vector<TestTrade>::column_alignment == 0);
+		REQUIRE(reinterpret_cast<uintptr_t>(trades.column<1>().data()) % soa_vector<TestTrade>::column_alignment == 0);
+		REQUIRE(reinterpret_cast<uintptr_t>(trades.column<3>().data()) % soa_vector<TestTrade>::column_alignment == 0);
+
+		const soa_vector<TestTrade>& view = trades;
+		array_view<const char> sides = view.column<3>();
+		REQUIRE(sides[999] == 'b');
+	}
+
+	SECTION("rows") {
+		soa_vector<TestTrade> trades;
+		trades.emplace_back(1, 10.5, 100.f, 'b');
+		trades.emplace_back(2, 11.0, 50.f, 's');
+		REQUIRE(trades[1].get<1>() == 11.0);
+
+		trades[0].get<2>() = 200.f;
+		const TestTrade first = trades[0];
+		REQUIRE(first.id == 1);
+		REQUIRE(first.quantity == 200.f);
+
+		trades[1] = TestTrade{3, 12.0, 10.f, 'b'};
+		REQUIRE(trades.column<0>()[1] == 3);
+		trades[0] = trades[1];
+		REQUIRE(trades.column<1>()[0] == 12.0);
+
+		for (auto [id, price, quantity, side] : trades) {
+			quantity *= 2;
+			REQUIRE(id == 3);
+			REQUIRE(price == 12.0);
+			REQUIRE(side == 'b');
+		}
+		REQUIRE(trades.column<2>()[0] == 20.f);
+
+		const soa_vector<TestTrade>& view = trades;
+		auto [id, price, quantity, side] = view[1];
+		REQUIRE(is_same<decltype(price), const double>());
+		REQUIRE(id == 3);
+		REQUIRE(quantity == 20.f);
+		REQUIRE(side == 'b');
+		REQUIRE(view.end() - view.begin() == 2);
+		REQUIRE((*(view.begin() + 1)).index() == 1);
+
+		trades.pop_back();
+		REQUIRE(trades.size() == 1);
+		trades.clear();
+		REQUIRE(trades.empty());
+	}
+
+	SECTION("non-trivial fields") {
+		soa_vector<TestNamed> named;
+		for (int i = 0; i < 100; ++i) {
+			named.emplace_back(std::string(20, static_cast<char>('a' + i % 26)), i, std::make_unique<int>(i));
+		}
+		named.push_back(TestNamed{"last", 100, nullptr});
+		REQUIRE(named.size() == 101);
+		REQUIRE(named.column<0>()[25] == std::string(20, 'z'));
+		REQUIRE(*named.column<2>()[99] == 99);
+		REQUIRE(named.column<1>()[100] == 100);
+
+		soa_vector<TestNamed> moved(std::move(named));
+		REQUIRE(named.empty());
+		REQUIRE(moved.size() == 101);
+		named = std::move(moved);
+		REQUIRE(*named[42].get<2>() == 42);
+
+		// the argument refers to a row, the columns grow while it is read
+		soa_vector<TestRecord> records;
+		records.emplace_back("first", 1, 2);
+		while (records.size() < records.capacity()) {
+			records.emplace_back("x", 0, 0);
+		}
+		records.emplace_back(records[0].get<0>(), 3, 4);
+		REQUIRE(records.column<0>()[records.size() - 1] == "first");
+	}
+
+	SECTION("copies") {
+		TestThrowing::live = 0;
+		{
+			soa_vector<TestRecord> records;
+			for (int i = 0; i < 40; ++i) {
+				records.emplace_back(std::to_string(i), i, i + 1);
+			}
+			REQUIRE(TestThrowing::live == 80);
+			soa_vector<TestRecord> copy(records);
+			REQUIRE(TestThrowing::live == 160);
+			REQUIRE(copy.column<0>()[39] == "39");
+			REQUIRE(copy.column<2>()[39].value == 40);
+			copy = records;
+			REQUIRE(TestThrowing::live == 160);
+
+			// a field which throws, the fields before it are destroyed
+			REQUIRE_THROWS_AS(records.emplace_back("bad", 1, -1), std::runtime_error);
+			REQUIRE(records.size() == 40);
+			REQUIRE(TestThrowing::live == 160);
+			soa_vector<TestRecord> full;
+			while (full.size() < 16) {
+				full.emplace_back("x", 0, 0);
+			}
+			REQUIRE_THROWS_AS(full.emplace_back("bad", -1, 0), std::runtime_error);
+			REQUIRE(full.size() == 16);
+			REQUIRE(full.capacity() == 16);
+		}
+		REQUIRE(TestThrowing::live == 0);
+	}
+}
+#endif
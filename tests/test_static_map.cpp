@@ -0,0 +1,100 @@
+#include "catch2/catch.hpp"
+#include "static_map.h"
+#include "array_view.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#if defined(__cpp_lib_string_view)
+#include <string_view>
+#endif
+
+USE_META
+
+namespace {
+	enum class TestVerb : uint8_t { get, put, post, del, head };
+
+	using TestText = array_view<const char>;
+
+	template <size_t N>
+	constexpr TestText text(const char (&s)[N]) {
+		return TestText(s, N - 1);
+	}
+
+	template <size_t... Is>
+	constexpr static_map<uint32_t, uint32_t, sizeof...(Is)> make_ids(index_sequence<Is...>) {
+		return make_static_map<uint32_t, uint32_t>({{static_cast<uint32_t>(Is * 2654435761u), static_cast<uint32_t>(Is)}...});
+	}
+
+	constexpr auto test_verbs = make_static_map<TestVerb, int>({
+		{TestVerb::get, 1}, {TestVerb::put, 2}, {TestVerb::post, 3}, {TestVerb::del, 4},
+	});
+
+	constexpr auto test_fields = make_static_map<TestText, int>({
+		{text("host"), 1}, {text("content-length"), 2}, {text("content-type"), 3},
+		{text("x-a-header-name-longer-than-sixteen-bytes"), 4}, {text(""), 5},
+	});
+
+	constexpr auto test_ids = make_ids(make_index_sequence<300>());
+}
+
+TEST_CASE("static map", "[static_map]" ) {
+	SECTION("traits") {
+		REQUIRE(static_key_category_of<int>::value == static_key_integral);
+		REQUIRE(static_key_category_of<TestVerb>::value == static_key_integral);
+		REQUIRE(static_key_category_of<TestText>::value == static_key_string);
+		REQUIRE(static_key_category_of<std::string>::value == static_key_string);
+		REQUIRE(static_key_category_of<double>::value == static_key_none);
+		REQUIRE(static_key_category_of<array_view<const int>>::value == static_key_none);
+	}
+
+	SECTION("compile time") {
+		static_assert(test_verbs.at(TestVerb::post) == 3, "");
+		static_assert(!test_verbs.contains(TestVerb::head), "");
+		static_assert(test_fields.at(text("content-type")) == 3, "");
+		static_assert(test_fields.count(text("content")) == 0, "");
+		static_assert(test_ids.at(299u * 2654435761u) == 299, "");
+		// the entries, 512 slots of uint16_t and 128 pilots
+		REQUIRE(sizeof(test_ids) == 300 * 8 + 512 * 2 + 128 * 2);
+	}
+
+	SECTION("integers") {
+		REQUIRE(test_ids.size() == 300);
+		for (uint32_t i = 0; i < 300; ++i) {
+			const uint32_t key = i * 2654435761u;
+			REQUIRE(test_ids.find(key) != test_ids.end());
+			REQUIRE(test_ids.at(key) == i);
+			REQUIRE(!test_ids.contains(key + 1));
+		}
+		REQUIRE_THROWS_AS(test_ids.at(1u), std::out_of_range);
+		REQUIRE(test_verbs.find(TestVerb::head) == test_verbs.end());
+		int sum = 0;
+		for (const auto& entry : test_verbs) {
+			sum += entry.second;
+		}
+		REQUIRE(sum == 10);
+	}
+
+	SECTION("strings") {
+		REQUIRE(test_fields.at(text("host")) == 1);
+		REQUIRE(test_fields.at(text("x-a-header-name-longer-than-sixteen-bytes")) == 4);
+		REQUIRE(test_fields.at(text("")) == 5);
+		REQUIRE(!test_fields.contains(text("x-a-header-name-longer-than-sixteen-byteZ")));
+		REQUIRE(!test_fields.contains(text("hos")));
+		// another string type than the key
+		REQUIRE(test_fields.at(std::string("content-length")) == 2);
+		REQUIRE(!test_fields.contains(std::string("Host")));
+#if defined(__cpp_lib_string_view)
+		constexpr auto names = make_static_map<std::string_view, int>({{"GET", 1}, {"PUT", 2}, {"POST", 3}});
+		static_assert(names.at("PUT") == 2, "");
+		REQUIRE(names.at(std::string("POST")) == 3);
+		REQUIRE(names.find("PATCH") == names.end());
+#endif
+	}
+
+	SECTION("duplicate keys") {
+		const std::pair<int, int> entries[] = {{1, 1}, {2, 2}, {1, 3}};
+		using map_type = static_map<int, int, 3>;
+		REQUIRE_THROWS_AS(map_type(entries), std::invalid_argument);
+	}
+}
@@ -27,6 +27,25 @@ enum TestEnum{
 enum class TestEnumClass {
 };
 
+struct TestNonTrivial {
+	TestNonTrivial(const TestNonTrivial&);
+	~TestNonTrivial();
+};
+
+struct TestAbstract {
+	virtual void f() = 0;
+};
+
+struct TestRelocatable {
+	TestRelocatable(const TestRelocatable&);
+	~TestRelocatable();
+};
+
+NS_META_BEG
+template <>
+struct is_trivially_relocatable<TestRelocatable> : public true_type {};
+NS_META_END
+
 TEST_CASE("traits type", "[trais][type]" ) {
 	typedef void (*FuncPointer)();
 	typedef void BasicFunc();
@@ -77,13 +96,22 @@ TEST_CASE("traits type", "[trais][type]" ) {
 		REQUIRE(is_integral<signed char>());
 		REQUIRE(is_integral<unsigned char>());
 		REQUIRE(is_integral<std::uint32_t>());
+		REQUIRE(is_integral<std::int_fast16_t>());
+		REQUIRE(is_integral<std::intptr_t>());
+		REQUIRE(is_integral<bool>());
+		REQUIRE(is_integral<wchar_t>());
+		REQUIRE(is_integral<const volatile unsigned long long>());
 		REQUIRE_FALSE(is_integral<float>());
+		REQUIRE_FALSE(is_integral<int&>());
+		REQUIRE_FALSE(is_integral<TestEnum>());
 
 		// float
 		REQUIRE(is_floating_point<float>());
 		REQUIRE(is_floating_point<double>());
 		REQUIRE(is_floating_point<long double>());
+		REQUIRE(is_floating_point<const volatile double>());
 		REQUIRE_FALSE(is_floating_point<int>());
+		REQUIRE_FALSE(is_floating_point<float&>());
 
 		// array
 		REQUIRE(is_bounded_array<int[6]>());
@@ -144,6 +172,7 @@ TEST_CASE("traits type", "[trais][type]" ) {
     	REQUIRE(is_pointer<int*>());
     	REQUIRE(is_pointer<FuncPointer>());
     	REQUIRE(is_pointer<decltype(&TestClass::sf)>());
+    	REQUIRE(is_pointer<int* const volatile>());
 
     	REQUIRE_FALSE(is_pointer<int>());
     	REQUIRE_FALSE(is_pointer<std::nullptr_t>());
@@ -213,6 +242,69 @@ TEST_CASE("traits type", "[trais][type]" ) {
     	REQUIRE_FALSE(is_enum<int[6]>()); // array
     }
 
+    SECTION("category") {
+    	REQUIRE(type_category<void>() == category_void);
+    	REQUIRE(type_category<std::nullptr_t>() == category_null_pointer);
+    	REQUIRE(type_category<const int>() == category_integral);
+    	REQUIRE(type_category<volatile double>() == category_floating_point);
+    	REQUIRE(type_category<int[6]>() == category_array);
+    	REQUIRE(type_category<const int[]>() == category_array);
+    	REQUIRE(type_category<TestEnum>() == category_enum);
+    	REQUIRE(type_category<TestEnumClass>() == category_enum);
+    	REQUIRE(type_category<TestUnion>() == category_union);
+    	REQUIRE(type_category<const TestClass>() == category_class);
+    	REQUIRE(type_category<BasicFunc>() == category_function);
+    	REQUIRE(type_category<ConstFunc>() == category_function);
+    	REQUIRE(type_category<RRefFunc>() == category_function);
+    	REQUIRE(type_category<int* const>() == category_pointer);
+    	REQUIRE(type_category<FuncPointer>() == category_pointer);
+    	REQUIRE(type_category<const int&>() == category_lvalue_reference);
+    	REQUIRE(type_category<int&&>() == category_rvalue_reference);
+    	REQUIRE(type_category<decltype(&TestClass::mo)>() == category_member_object_pointer);
+    	REQUIRE(type_category<decltype(&TestClass::mf)>() == category_member_function_pointer);
+
+    	// composite masks
+    	REQUIRE((type_category<long>() & category_scalar) != 0);
+    	REQUIRE((type_category<TestEnum>() & category_scalar) != 0);
+    	REQUIRE((type_category<TestClass>() & category_scalar) == 0);
+    	REQUIRE((type_category<std::nullptr_t>() & category_fundamental) != 0);
+    }
+
+    SECTION("variable templates") {
+    	REQUIRE(is_same_v<int, int>);
+    	REQUIRE_FALSE(is_same_v<int, const int>);
+    	REQUIRE(type_category_v<int> == category_integral);
+
+    	REQUIRE(is_void_v<const void>);
+    	REQUIRE(is_null_pointer_v<std::nullptr_t>);
+    	REQUIRE(is_integral_v<const long>);
+    	REQUIRE(is_floating_point_v<double>);
+    	REQUIRE(is_bounded_array_v<int[6]>);
+    	REQUIRE(is_unbounded_array_v<int[]>);
+    	REQUIRE(is_array_v<int[]>);
+    	REQUIRE(is_union_v<TestUnion>);
+    	REQUIRE(is_class_v<TestClass>);
+    	REQUIRE(is_function_v<ConstFunc>);
+    	REQUIRE(is_pointer_v<FuncPointer>);
+    	REQUIRE(is_lvalue_reference_v<int&>);
+    	REQUIRE(is_rvalue_reference_v<int&&>);
+    	REQUIRE(is_reference_v<int&>);
+    	REQUIRE(is_member_function_pointer_v<decltype(&TestClass::mf)>);
+    	REQUIRE(is_member_object_pointer_v<decltype(&TestClass::mo)>);
+    	REQUIRE(is_member_pointer_v<decltype(&TestClass::mo)>);
+    	REQUIRE(is_enum_v<TestEnumClass>);
+    	REQUIRE(is_arithmetic_v<float>);
+    	REQUIRE(is_fundamental_v<void>);
+    	REQUIRE(is_scalar_v<TestEnum>);
+    	REQUIRE(is_object_v<TestUnion>);
+    	REQUIRE(is_compound_v<int*>);
+
+    	REQUIRE_FALSE(is_integral_v<TestEnum>);
+    	REQUIRE_FALSE(is_class_v<TestUnion>);
+    	REQUIRE_FALSE(is_function_v<FuncPointer>);
+    	REQUIRE_FALSE(is_object_v<int&>);
+    }
+
     SECTION("arithmetic") {
     	// basic
     	REQUIRE(is_arithmetic<int>()); // int 
@@ -305,4 +397,49 @@ TEST_CASE("traits type", "[trais][type]" ) {
     	REQUIRE(is_compound<int[]>()); // array
     	REQUIRE(is_compound<int[6]>()); // array
     }
+
+    SECTION("trivially copyable/destructible") {
+    	REQUIRE(is_trivially_copyable<int>());
+    	REQUIRE(is_trivially_copyable<const double>());
+    	REQUIRE(is_trivially_copyable<int*>());
+    	REQUIRE(is_trivially_copyable<TestEnum>());
+    	REQUIRE(is_trivially_copyable<TestClass>());
+    	REQUIRE(is_trivially_copyable<TestClass[4]>());
+    	REQUIRE_FALSE(is_trivially_copyable<TestNonTrivial>());
+    	REQUIRE_FALSE(is_trivially_copyable_v<TestNonTrivial[4]>);
+
+    	REQUIRE(is_trivially_destructible<int>());
+    	REQUIRE(is_trivially_destructible<int&>());
+    	REQUIRE(is_trivially_destructible<TestUnion>());
+    	REQUIRE(is_trivially_destructible_v<TestClass[4]>);
+    	REQUIRE_FALSE(is_trivially_destructible<TestNonTrivial>());
+    	REQUIRE_FALSE(is_trivially_destructible<void>());
+    }
+
+    SECTION("trivially relocatable") {
+    	REQUIRE(is_trivially_relocatable<int>());
+    	REQUIRE(is_trivially_relocatable<TestClass>());
+    	REQUIRE(is_trivially_relocatable_v<TestEnum*>);
+    	REQUIRE_FALSE(is_trivially_relocatable<TestNonTrivial>());
+    	REQUIRE(is_trivially_relocatable<TestRelocatable>());
+    	REQUIRE(is_trivially_relocatable_v<TestRelocatable>);
+    }
+
+    SECTION("abstract") {
+    	REQUIRE(is_abstract<TestAbstract>());
+    	REQUIRE(is_abstract_v<const TestAbstract>);
+    	REQUIRE_FALSE(is_abstract<TestClass>());
+    	REQUIRE_FALSE(is_abstract<int>());
+    	REQUIRE_FALSE(is_abstract_v<TestUnion>);
+    }
+
+#if defined(META_BUILTIN_IS_AGGREGATE) || defined(__cpp_lib_is_aggregate)
+    SECTION("aggregate") {
+    	REQUIRE(is_aggregate<TestClass>());
+    	REQUIRE(is_aggregate<int[4]>());
+    	REQUIRE(is_aggregate_v<TestUnion>);
+    	REQUIRE_FALSE(is_aggregate<int>());
+    	REQUIRE_FALSE(is_aggregate<TestNonTrivial>());
+    }
+#endif
 }
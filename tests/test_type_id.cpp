@@ -0,0 +1,49 @@
+#include "catch2/catch.hpp"
+#include "type_id.h"
+
+#include <cstring>
+#include <string>
+
+USE_META
+
+namespace {
+	struct TestClass {};
+
+	template <class T>
+	struct TestTemplate {};
+
+	bool name_is(type_index id, const char* name) {
+		return id.name_size == std::strlen(name) && std::strncmp(id.name, name, id.name_size) == 0;
+	}
+}
+
+TEST_CASE("type id", "[type_id]" ) {
+	SECTION("compile time") {
+		static_assert(type_id<int>() == type_id<int>(), "");
+		static_assert(type_id<int>() != type_id<const int>(), "");
+		static_assert(type_id<int>() != type_id<int&>(), "");
+		static_assert(unqualified_type_id<const int&>() == type_id<int>(), "");
+		static_assert(unqualified_type_id<volatile int&&>() == unqualified_type_id<int>(), "");
+		REQUIRE(true);
+	}
+
+	SECTION("name") {
+		REQUIRE(name_is(type_id<int>(), "int"));
+		REQUIRE(name_is(type_id<void>(), "void"));
+		REQUIRE(std::strstr(std::string(type_id<TestClass>().name, type_id<TestClass>().name_size).c_str(), "TestClass"));
+		REQUIRE(type_id<TestTemplate<int>>() != type_id<TestTemplate<long>>());
+	}
+
+	SECTION("table") {
+		using table = type_id_table<int, float, TestClass, int*, TestTemplate<int>>;
+		static_assert(table::find(type_id<int>()) == 0, "");
+		static_assert(table::find(type_id<TestClass>()) == 2, "");
+		static_assert(table::find(type_id<double>()) == table::size, "");
+
+		REQUIRE(table::find(type_id<float>()) == 1);
+		REQUIRE(table::find(type_id<int*>()) == 3);
+		REQUIRE(table::find(unqualified_type_id<const TestTemplate<int>&>()) == 4);
+		REQUIRE(table::find(type_id<const int>()) == table::size);
+		REQUIRE(type_id_table<>::find(type_id<int>()) == 0);
+	}
+}
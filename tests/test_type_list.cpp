@@ -0,0 +1,107 @@
+#include "catch2/catch.hpp"
+#include "type_list.h"
+
+USE_META
+
+namespace {
+	struct TestClass {};
+
+	enum TestEnum {
+	};
+
+	// a list of N distinct types
+	template <size_t I>
+	struct Tag {};
+
+	template <class Is>
+	struct make_tags;
+
+	template <size_t... Is>
+	struct make_tags<index_sequence<Is...>> : type_identity<type_list<Tag<Is>...>> {};
+
+	template <size_t N>
+	using tags = typename make_tags<make_index_sequence<N>>::type;
+}
+
+TEST_CASE("type list", "[type_list]" ) {
+	using L = type_list<int, float, TestClass, int, TestEnum, float*>;
+
+	SECTION("size") {
+		REQUIRE(type_list<>::size == 0);
+		REQUIRE(L::size == 6);
+	}
+
+	SECTION("at") {
+		REQUIRE(is_same<int, at_t<L, 0>>());
+		REQUIRE(is_same<TestClass, at_t<L, 2>>());
+		REQUIRE(is_same<int, at_t<L, 3>>());
+		REQUIRE(is_same<float*, at_t<L, 5>>());
+
+		// long list
+		REQUIRE(is_same<Tag<0>, at_t<tags<1000>, 0>>());
+		REQUIRE(is_same<Tag<777>, at_t<tags<1000>, 777>>());
+		REQUIRE(is_same<Tag<999>, at_t<tags<1000>, 999>>());
+	}
+
+	SECTION("index of/contains") {
+		REQUIRE(index_of<L, int>() == 0);
+		REQUIRE(index_of<L, TestEnum>() == 4);
+		REQUIRE(index_of<L, double>() == L::size);
+		REQUIRE(index_of<type_list<>, int>() == 0);
+		REQUIRE(index_of_v<tags<1000>, Tag<500>> == 500);
+
+		REQUIRE(contains<L, float*>());
+		REQUIRE(contains_v<L, TestClass>);
+		REQUIRE(contains<L, float>());
+		REQUIRE_FALSE(contains<L, const int>());
+		REQUIRE_FALSE(contains<type_list<>, int>());
+	}
+
+	SECTION("concat") {
+		REQUIRE(is_same<type_list<>, concat_t<>>());
+		REQUIRE(is_same<L, concat_t<L>>());
+		REQUIRE(is_same<type_list<int, float>, concat_t<type_list<int>, type_list<>, type_list<float>>>());
+		REQUIRE(is_same<type_list<int, char, float, long, bool, short, void>,
+			concat_t<type_list<int>, type_list<char>, type_list<float>, type_list<>,
+				type_list<long, bool>, type_list<short>, type_list<void>>>());
+	}
+
+	SECTION("slice/take/drop") {
+		REQUIRE(is_same<type_list<float, TestClass>, slice_t<L, 1, 3>>());
+		REQUIRE(is_same<type_list<>, slice_t<L, 2, 2>>());
+		REQUIRE(is_same<L, slice_t<L, 0, L::size>>());
+		REQUIRE(is_same<type_list<int, float>, take_t<L, 2>>());
+		REQUIRE(is_same<type_list<>, take_t<type_list<>, 0>>());
+		REQUIRE(is_same<type_list<TestEnum, float*>, drop_t<L, 4>>());
+		REQUIRE(is_same<type_list<>, drop_t<L, L::size>>());
+
+		REQUIRE(is_same<tags<300>, take_t<tags<1000>, 300>>());
+		REQUIRE(is_same<Tag<300>, at_t<drop_t<tags<1000>, 300>, 0>>());
+		REQUIRE(drop_t<tags<1000>, 300>::size == 700);
+		REQUIRE(is_same<Tag<999>, at_t<slice_t<tags<1000>, 500, 1000>, 499>>());
+	}
+
+	SECTION("filter/partition") {
+		REQUIRE(is_same<type_list<int, int>, filter_t<L, is_integral>>());
+		REQUIRE(is_same<type_list<TestClass>, filter_t<L, is_class>>());
+		REQUIRE(is_same<type_list<>, filter_t<L, is_void>>());
+		REQUIRE(is_same<type_list<>, filter_t<type_list<>, is_void>>());
+		REQUIRE(filter_t<tags<1000>, is_class>::size == 1000);
+
+		using P = partition<L, is_scalar>;
+		REQUIRE(is_same<type_list<int, float, int, TestEnum, float*>, P::first>());
+		REQUIRE(is_same<type_list<TestClass>, P::second>());
+	}
+
+	SECTION("transform") {
+		REQUIRE(is_same<type_list<int*, float*, TestClass*, int*, TestEnum*, float**>, transform_t<L, add_pointer>>());
+		REQUIRE(is_same<type_list<int, int>, transform_t<type_list<const int, volatile int>, remove_cv>>());
+	}
+
+	SECTION("unique") {
+		REQUIRE(is_same<type_list<>, unique_t<type_list<>>>());
+		REQUIRE(is_same<type_list<int>, unique_t<type_list<int, int, int>>>());
+		REQUIRE(is_same<type_list<int, float, TestClass, TestEnum, float*>, unique_t<L>>());
+		REQUIRE(is_same<tags<1000>, unique_t<concat_t<tags<1000>, tags<1000>>>>());
+	}
+}